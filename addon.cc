@@ -11,6 +11,12 @@ Napi::Object InitAll(Napi::Env env, Napi::Object exports)
 	//export for 'demo' script:
 	exports.Set(Napi::String::New(env, "calculateSync"),
 				Napi::Function::New(env, CalculateSync));
+	exports.Set(Napi::String::New(env, "benchmarkRotateSync"),
+				Napi::Function::New(env, BenchmarkRotateSync));
+	exports.Set(Napi::String::New(env, "seededKeysSync"),
+				Napi::Function::New(env, SeededKeysSync));
+	exports.Set(Napi::String::New(env, "ciphertextAliasSync"),
+				Napi::Function::New(env, CiphertextAliasSync));
 
 	//the light API version
 	exports.Set(Napi::String::New(env, "generateHomomorficContext"),
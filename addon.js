@@ -59,6 +59,10 @@ const logOK = (strPrefix, valRet, valExpected) => log(strPrefix + valRet + " " +
  *                      var cipherResult = hc.multiply(cipher1, cipher2);
  *   - square()       - homomorphically square a Ciphertext (serialized as String)
  *                      var cipherResult = hc.square(cipher);
+ *   - addPlain()     - homomorphically add a constant Number to a Ciphertext (serialized as String)
+ *                      var cipherResult = hc.addPlain(cipher, 3);
+ *   - multiplyPlain()- homomorphically multiply a Ciphertext (serialized as String) by a constant Number
+ *                      var cipherResult = hc.multiplyPlain(cipher, -4);
  * 
  *******************************************************************************/
 
@@ -261,6 +265,34 @@ try {
   }
 
 
+  ////////////////////////////////////////////////////////////////////////////////
+  //
+  //TEST addPlain(), multiplyPlain()
+  //
+
+  //Test 7.1: SHOULD PASS
+  {
+    let cipherRes = hc.addPlain(cipher1, -3); //5 + (-3)
+    let vRet = hc.decrypt(cipherRes);
+    let valExpected = val1 - 3;
+    logOK("addPlain      - SAME CONTEXT:  ", vRet, valExpected);
+  }
+  //Test 7.2: SHOULD PASS
+  {
+    let cipherRes = hc.multiplyPlain(cipher2, -4); //(-7) * (-4); power of two
+    let vRet = hc.decrypt(cipherRes);
+    let valExpected = val2 * -4;
+    logOK("multiplyPlain - SAME CONTEXT:  ", vRet, valExpected);
+  }
+  //Test 7.3: SHOULD PASS
+  {
+    let cipherRes = hc.multiplyPlain(cipher1, 3); //5 * 3
+    let vRet = hc.decrypt(cipherRes);
+    let valExpected = val1 * 3;
+    logOK("multiplyPlain - SAME CONTEXT:  ", vRet, valExpected);
+  }
+
+
   ////////////////////////////////////////////////////////////////////////////////
   //
   //TEST getEncryptionParameters()
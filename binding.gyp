@@ -19,20 +19,29 @@
         "./seal/keygenerator.cpp",
         "./seal/memorymanager.cpp",
         "./seal/plaintext.cpp",
+        "./seal/preparedplaintext.cpp",
+        "./seal/publickey.cpp",
         "./seal/randomgen.cpp",
         "./seal/relinkeys.cpp",
+        "./seal/secretkey.cpp",
         "./seal/smallmodulus.cpp",
+        "./seal/threadpool.cpp",
 
         "./seal/util/aes.cpp",
         "./seal/util/baseconverter.cpp",
+        "./seal/util/bitpack.cpp",
+        "./seal/util/ckksfft.cpp",
         "./seal/util/clipnormal.cpp",
+        "./seal/util/galois.cpp",
         "./seal/util/globals.cpp",
         "./seal/util/hash.cpp",
+        "./seal/util/mappedfile.cpp",
         "./seal/util/mempool.cpp",
         "./seal/util/numth.cpp",
         "./seal/util/polyarith.cpp",
         "./seal/util/polyarithmod.cpp",
         "./seal/util/polyarithsmallmod.cpp",
+        "./seal/util/seededkeys.cpp",
         "./seal/util/smallntt.cpp",
         "./seal/util/uintarith.cpp",
         "./seal/util/uintarithmod.cpp",
@@ -66,4 +66,37 @@ catch (err) {
             if (res !== expectedResult)
                 throw "Error: the 2 results differ!";
         });
-}
\ No newline at end of file
+}
+////////////////////////////////////////////////////////////////////////////////
+// hoisted rotations benchmark
+try {
+    var rotationCount = 32;
+    var speedup = addon.benchmarkRotateSync(rotationCount); //<==HERE!!!
+    console.log('rotate_many speedup for ' + rotationCount + ' rotations: ' + speedup.toFixed(2) + 'x');
+}
+catch (err) {
+    console.log(err);
+}
+////////////////////////////////////////////////////////////////////////////////
+// seeded key switching keys; with dbc 60 every prime is a single decomposition factor
+[30, 60].forEach(function (dbc) {
+    try {
+        var size = addon.seededKeysSync(dbc); //<==HERE!!!
+        console.log('Seeded RelinKeys with dbc ' + dbc + ': ' + size + ' bytes');
+    }
+    catch (err) {
+        console.log(err);
+    }
+});
+////////////////////////////////////////////////////////////////////////////////
+// in-place evaluation on a ciphertext aliasing a read-only buffer
+try {
+    var a = 12, b = -5;
+    var sum = addon.ciphertextAliasSync(a, b); //<==HERE!!!
+    console.log('Alias result = ' + sum + ', expected = ' + (a + b));
+    if (sum !== a + b)
+        throw "Error: the 2 results differ!";
+}
+catch (err) {
+    console.log(err);
+}
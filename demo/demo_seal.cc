@@ -11,6 +11,9 @@
 #include <mutex>
 #include <memory>
 #include <limits>
+#include <cmath>
+#include <algorithm>
+#include <sstream>
 
 #include "seal/seal.h"
 
@@ -20,6 +23,8 @@ using namespace seal;
 //forward function declarations:
 void print_example_banner(string title);
 void print_parameters(shared_ptr<SEALContext> context);
+bool same_kswitch_keys(const vector<vector<Ciphertext>> &keys1,
+                       const vector<vector<Ciphertext>> &keys2);
 
 
 int example_bfv_basics_i(int value1, int value2)
@@ -97,6 +102,249 @@ int example_bfv_basics_i(int value1, int value2)
 }
 
 
+double benchmark_rotate_many(int rotation_count)
+{
+  print_example_banner("Benchmark: CKKS rotate_many vs. rotate_vector");
+
+  if (rotation_count < 1)
+  {
+    throw invalid_argument("rotation_count must be positive");
+  }
+
+  EncryptionParameters parms(scheme_type::CKKS);
+  parms.set_poly_modulus_degree(8192);
+  parms.set_coeff_modulus(coeff_modulus_128(8192));
+
+  auto context = SEALContext::Create(parms);
+
+  print_parameters(context);
+
+  vector<int> steps;
+  for (int i = 1; i <= rotation_count; i++)
+  {
+    steps.push_back(i);
+  }
+
+  KeyGenerator keygen(context);
+  GaloisKeys galois_keys = keygen.galois_keys(20, steps);
+
+  CKKSEncoder encoder(context);
+  Encryptor encryptor(context, keygen.public_key());
+  Evaluator evaluator(context);
+  Decryptor decryptor(context, keygen.secret_key());
+
+  vector<double> input(encoder.slot_count());
+  for (size_t i = 0; i < input.size(); i++)
+  {
+    input[i] = static_cast<double>(i);
+  }
+
+  /*
+  With a decomposition bit count of 20 the key switching noise is close to
+  2^40, so a scale of 2^50 keeps the decoded error far below the tolerance
+  while a wrong rotation is off by at least 1 in every slot.
+  */
+  const double tolerance = 0.01;
+  Plaintext plain;
+  encoder.encode(input, pow(2.0, 50), plain);
+  Ciphertext encrypted;
+  encryptor.encrypt(plain, encrypted);
+
+  auto time_start = chrono::high_resolution_clock::now();
+  vector<Ciphertext> repeated(steps.size());
+  for (size_t i = 0; i < steps.size(); i++)
+  {
+    evaluator.rotate_vector(encrypted, steps[i], galois_keys, repeated[i]);
+  }
+  auto time_repeated = chrono::duration_cast<chrono::microseconds>(
+      chrono::high_resolution_clock::now() - time_start);
+
+  time_start = chrono::high_resolution_clock::now();
+  vector<Ciphertext> hoisted;
+  evaluator.rotate_many(encrypted, steps, galois_keys, hoisted);
+  auto time_hoisted = chrono::duration_cast<chrono::microseconds>(
+      chrono::high_resolution_clock::now() - time_start);
+
+  // Both ways must give the expected rotations before the timings mean anything
+  if (hoisted.size() != steps.size())
+  {
+    throw logic_error("rotate_many returned the wrong number of ciphertexts");
+  }
+  double max_error = 0;
+  for (size_t i = 0; i < steps.size(); i++)
+  {
+    for (auto *rotated : {&repeated[i], &hoisted[i]})
+    {
+      Plaintext plain_rotated;
+      decryptor.decrypt(*rotated, plain_rotated);
+      vector<double> output;
+      encoder.decode(plain_rotated, output);
+      for (size_t j = 0; j < output.size(); j++)
+      {
+        double expected = input[(j + static_cast<size_t>(steps[i])) % input.size()];
+        max_error = max(max_error, fabs(output[j] - expected));
+      }
+    }
+    if (max_error > tolerance)
+    {
+      throw logic_error("rotation by " + to_string(steps[i]) +
+                        " is off by " + to_string(max_error));
+    }
+  }
+  cout << "Maximum error of the rotations: " << max_error << endl;
+
+  cout << rotation_count << " x rotate_vector: " << time_repeated.count()
+       << " microseconds" << endl;
+  cout << "rotate_many (" << rotation_count << " steps): " << time_hoisted.count()
+       << " microseconds" << endl;
+
+  double speedup = static_cast<double>(time_repeated.count()) /
+                   static_cast<double>(max<long long>(time_hoisted.count(), 1));
+  cout << "Speedup: " << speedup << "x" << endl;
+
+  return speedup;
+}
+
+
+size_t example_seeded_keys(int decomposition_bit_count)
+{
+  print_example_banner("Example: Seeded RelinKeys and GaloisKeys");
+
+  EncryptionParameters parms(scheme_type::BFV);
+  parms.set_poly_modulus_degree(4096);
+  parms.set_coeff_modulus(coeff_modulus_128(4096));
+  parms.set_plain_modulus(40961);
+
+  auto context = SEALContext::Create(parms);
+
+  print_parameters(context);
+
+  KeyGenerator keygen(context);
+  RelinKeys relin_keys = keygen.relin_keys(decomposition_bit_count);
+  GaloisKeys galois_keys = keygen.galois_keys(decomposition_bit_count,
+                                              vector<int>{1, -1});
+
+  size_t relin_keys_size = 0;
+  for (auto compr_mode : {compr_mode_type::none, compr_mode_type::bit_packed})
+  {
+    stringstream relin_stream;
+    relin_keys.save_seeded(relin_stream, compr_mode);
+    RelinKeys loaded_relin_keys;
+    loaded_relin_keys.load(context, relin_stream);
+    if (!same_kswitch_keys(relin_keys.data(), loaded_relin_keys.data()))
+    {
+      throw logic_error("loaded seeded RelinKeys differ from the generated ones");
+    }
+
+    stringstream galois_stream;
+    galois_keys.save_seeded(galois_stream, compr_mode);
+    GaloisKeys loaded_galois_keys;
+    loaded_galois_keys.load(context, galois_stream);
+    if (!same_kswitch_keys(galois_keys.data(), loaded_galois_keys.data()))
+    {
+      throw logic_error("loaded seeded GaloisKeys differ from the generated ones");
+    }
+
+    cout << "Seeded RelinKeys (" << (compr_mode == compr_mode_type::none ?
+                                     "none" : "bit_packed") << "): "
+         << relin_stream.str().size() << " bytes" << endl;
+    cout << "Seeded GaloisKeys (" << (compr_mode == compr_mode_type::none ?
+                                      "none" : "bit_packed") << "): "
+         << galois_stream.str().size() << " bytes" << endl;
+    if (compr_mode == compr_mode_type::none)
+    {
+      relin_keys_size = relin_stream.str().size();
+    }
+  }
+
+  return relin_keys_size;
+}
+
+
+int example_ciphertext_alias(int value1, int value2)
+{
+  print_example_banner("Example: Ciphertext aliasing read-only memory");
+
+  EncryptionParameters parms(scheme_type::BFV);
+  parms.set_poly_modulus_degree(2048);
+  parms.set_coeff_modulus(coeff_modulus_128(2048));
+  parms.set_plain_modulus(1 << 8);
+
+  auto context = SEALContext::Create(parms);
+
+  print_parameters(context);
+
+  IntegerEncoder encoder(parms.plain_modulus());
+  KeyGenerator keygen(context);
+  Encryptor encryptor(context, keygen.public_key());
+  Evaluator evaluator(context);
+  Decryptor decryptor(context, keygen.secret_key());
+
+  Ciphertext encrypted1, encrypted2;
+  encryptor.encrypt(encoder.encode(value1), encrypted1);
+  encryptor.encrypt(encoder.encode(value2), encrypted2);
+
+  // The record must be 8-byte aligned, so store it in 64-bit words
+  vector<uint64_t> record((encrypted1.save_mappable_size() + 7) / 8);
+  stringstream stream;
+  encrypted1.save_mappable(stream);
+  stream.read(reinterpret_cast<char *>(record.data()),
+              static_cast<streamsize>(encrypted1.save_mappable_size()));
+  const vector<uint64_t> source(record);
+
+  Ciphertext alias = Ciphertext::Aliasing(
+      context, source.data(), source.size() * sizeof(uint64_t));
+  cout << "Aliasing the buffer: " << (alias.is_alias() ? "yes" : "no") << endl;
+
+  evaluator.add_inplace(alias, encrypted2);
+  cout << "Aliasing the buffer after add_inplace: "
+       << (alias.is_alias() ? "yes" : "no") << endl;
+  if (alias.is_alias() || source != record)
+  {
+    throw logic_error("add_inplace wrote into the aliased buffer");
+  }
+
+  Plaintext plain_result;
+  decryptor.decrypt(alias, plain_result);
+  int valRet = encoder.decode_int32(plain_result);
+  cout << "Decoded integer: " << valRet << endl;
+
+  return valRet;
+}
+
+
+/*
+Helper function: Checks that two sets of key switching keys are identical.
+*/
+bool same_kswitch_keys(const vector<vector<Ciphertext>> &keys1,
+                       const vector<vector<Ciphertext>> &keys2)
+{
+  if (keys1.size() != keys2.size())
+  {
+    return false;
+  }
+  for (size_t i = 0; i < keys1.size(); i++)
+  {
+    if (keys1[i].size() != keys2[i].size())
+    {
+      return false;
+    }
+    for (size_t j = 0; j < keys1[i].size(); j++)
+    {
+      auto &key1 = keys1[i][j];
+      auto &key2 = keys2[i][j];
+      if (key1.parms_id() != key2.parms_id() ||
+          key1.uint64_count() != key2.uint64_count() ||
+          !equal(key1.data(), key1.data() + key1.uint64_count(), key2.data()))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+
 /*
 Helper function: Prints the name of the example in a fancy banner.
 */
@@ -7,4 +7,26 @@
  */
 int example_bfv_basics_i(int val1, int val2);
 
+/**
+ * Times 'rotation_count' CKKS rotations done with repeated rotate_vector()
+ * calls against a single hoisted rotate_many() call, after checking that
+ * both give the expected rotations (throws std::logic_error otherwise).
+ * Return:  the speedup of rotate_many() over repeated rotate_vector()
+ */
+double benchmark_rotate_many(int rotation_count);
+
+/**
+ * Saves RelinKeys and GaloisKeys with save_seeded() in both compression modes,
+ * loads them back and checks that they match the generated keys.
+ * Return:  the size in bytes of the seeded RelinKeys saved without compression
+ */
+size_t example_seeded_keys(int decomposition_bit_count);
+
+/**
+ * Encrypts val1 into a read-only buffer, adds val2 in place to a ciphertext
+ * aliasing that buffer, and checks that the buffer was left unchanged.
+ * Return:  val1 + val2
+ */
+int example_ciphertext_alias(int val1, int val2);
+
 #endif // DEMO_SEAL_H_
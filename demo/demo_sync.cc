@@ -29,3 +29,85 @@ Napi::Value CalculateSync(const Napi::CallbackInfo &info)
   // return the result:
   return Napi::Number::New(info.Env(), est);
 }
+
+Napi::Value BenchmarkRotateSync(const Napi::CallbackInfo &info)
+{
+
+  Napi::Env env = info.Env();
+
+  // check the input params:
+  if (info.Length() < 1)
+  {
+    Napi::TypeError::New(env, "Wrong number of arguments!").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (!info[0].IsNumber())
+  {
+    Napi::TypeError::New(env, "Wrong argument types!").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // expect the number of rotations as argument:
+  int rotation_count = info[0].As<Napi::Number>().Int32Value();
+
+  // call the C/C++ function:
+  double speedup = benchmark_rotate_many(rotation_count);
+
+  // return the result:
+  return Napi::Number::New(info.Env(), speedup);
+}
+
+Napi::Value SeededKeysSync(const Napi::CallbackInfo &info)
+{
+
+  Napi::Env env = info.Env();
+
+  // check the input params:
+  if (info.Length() < 1)
+  {
+    Napi::TypeError::New(env, "Wrong number of arguments!").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (!info[0].IsNumber())
+  {
+    Napi::TypeError::New(env, "Wrong argument types!").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // expect the decomposition bit count as argument:
+  int decomposition_bit_count = info[0].As<Napi::Number>().Int32Value();
+
+  // call the C/C++ function:
+  size_t size = example_seeded_keys(decomposition_bit_count);
+
+  // return the result:
+  return Napi::Number::New(info.Env(), static_cast<double>(size));
+}
+
+Napi::Value CiphertextAliasSync(const Napi::CallbackInfo &info)
+{
+
+  Napi::Env env = info.Env();
+
+  // check the input params:
+  if (info.Length() < 2)
+  {
+    Napi::TypeError::New(env, "Wrong number of arguments!").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  if (!info[0].IsNumber() || !info[1].IsNumber())
+  {
+    Napi::TypeError::New(env, "Wrong argument types!").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // expect numbers as arguments:
+  int val1 = info[0].As<Napi::Number>().Int32Value();
+  int val2 = info[1].As<Napi::Number>().Int32Value();
+
+  // call the C/C++ function:
+  int sum = example_ciphertext_alias(val1, val2);
+
+  // return the result:
+  return Napi::Number::New(info.Env(), sum);
+}
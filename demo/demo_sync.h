@@ -6,4 +6,13 @@
 // N-API Adapter: simple synchronous access to the `example_bfv_basics_i()` function
 Napi::Value CalculateSync(const Napi::CallbackInfo &info);
 
+// N-API Adapter: simple synchronous access to the `benchmark_rotate_many()` function
+Napi::Value BenchmarkRotateSync(const Napi::CallbackInfo &info);
+
+// N-API Adapter: simple synchronous access to the `example_seeded_keys()` function
+Napi::Value SeededKeysSync(const Napi::CallbackInfo &info);
+
+// N-API Adapter: simple synchronous access to the `example_ciphertext_alias()` function
+Napi::Value CiphertextAliasSync(const Napi::CallbackInfo &info);
+
 #endif // DEMO_SYNC_H_
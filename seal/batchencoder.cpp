@@ -5,6 +5,7 @@
 #include <cstdlib>
 #include <random>
 #include <limits>
+#include <algorithm>
 #include "seal/batchencoder.h"
 #include "seal/util/polycore.h"
 
@@ -13,6 +14,43 @@ using namespace seal::util;
 
 namespace seal
 {
+    namespace
+    {
+        inline bool is_valid_slot_value(uint64_t value, uint64_t modulus)
+        {
+            return value < modulus;
+        }
+
+        inline bool is_valid_slot_value(int64_t value, uint64_t modulus)
+        {
+            return !unsigned_gt(llabs(value), modulus >> 1);
+        }
+
+        inline uint64_t to_slot_value(uint64_t value, uint64_t)
+        {
+            return value;
+        }
+
+        inline uint64_t to_slot_value(int64_t value, uint64_t modulus)
+        {
+            return (value < 0) ? (modulus + static_cast<uint64_t>(value)) :
+                static_cast<uint64_t>(value);
+        }
+
+        inline void from_slot_value(uint64_t value, uint64_t, uint64_t &destination)
+        {
+            destination = value;
+        }
+
+        inline void from_slot_value(uint64_t value, uint64_t modulus,
+            int64_t &destination)
+        {
+            destination = (value > (modulus >> 1)) ?
+                (static_cast<int64_t>(value) - static_cast<int64_t>(modulus)) :
+                static_cast<int64_t>(value);
+        }
+    }
+
     BatchEncoder::BatchEncoder(std::shared_ptr<SEALContext> context) : 
         context_(std::move(context))
     {
@@ -179,6 +217,18 @@ namespace seal
         // Note: We already performed bit-reversal when reading in the matrix
         inverse_ntt_negacyclic_harvey(destination.data(), *context_data.plain_ntt_tables());
     }
+    void BatchEncoder::encode(const vector<uint64_t> &values_matrix,
+        parms_id_type parms_id, Plaintext &destination)
+    {
+        encode_ntt_internal(values_matrix, parms_id, destination);
+    }
+
+    void BatchEncoder::encode(const vector<int64_t> &values_matrix,
+        parms_id_type parms_id, Plaintext &destination)
+    {
+        encode_ntt_internal(values_matrix, parms_id, destination);
+    }
+
 #ifdef SEAL_USE_MSGSL_SPAN
     void BatchEncoder::encode(gsl::span<const uint64_t> values_matrix, 
         Plaintext &destination)
@@ -578,4 +628,332 @@ namespace seal
             *(plain.data() + i) = temp[matrix_reps_index_map_[i]];
         }
     }
+
+    void BatchEncoder::encode_batch(const vector<uint64_t> &values_matrix,
+        size_t vector_size, vector<Plaintext> &destinations)
+    {
+        encode_batch_internal(values_matrix, vector_size, destinations, nullptr);
+    }
+
+    void BatchEncoder::encode_batch(const vector<int64_t> &values_matrix,
+        size_t vector_size, vector<Plaintext> &destinations)
+    {
+        encode_batch_internal(values_matrix, vector_size, destinations, nullptr);
+    }
+
+    void BatchEncoder::encode_batch(const vector<uint64_t> &values_matrix,
+        size_t vector_size, vector<Plaintext> &destinations, ThreadPool &thread_pool)
+    {
+        encode_batch_internal(values_matrix, vector_size, destinations, &thread_pool);
+    }
+
+    void BatchEncoder::encode_batch(const vector<int64_t> &values_matrix,
+        size_t vector_size, vector<Plaintext> &destinations, ThreadPool &thread_pool)
+    {
+        encode_batch_internal(values_matrix, vector_size, destinations, &thread_pool);
+    }
+
+    void BatchEncoder::decode_batch(const vector<Plaintext> &plains,
+        vector<uint64_t> &destination, MemoryPoolHandle pool)
+    {
+        decode_batch_internal(plains, destination, nullptr, move(pool));
+    }
+
+    void BatchEncoder::decode_batch(const vector<Plaintext> &plains,
+        vector<int64_t> &destination, MemoryPoolHandle pool)
+    {
+        decode_batch_internal(plains, destination, nullptr, move(pool));
+    }
+
+    void BatchEncoder::decode_batch(const vector<Plaintext> &plains,
+        vector<uint64_t> &destination, ThreadPool &thread_pool,
+        MemoryPoolHandle pool)
+    {
+        decode_batch_internal(plains, destination, &thread_pool, move(pool));
+    }
+
+    void BatchEncoder::decode_batch(const vector<Plaintext> &plains,
+        vector<int64_t> &destination, ThreadPool &thread_pool,
+        MemoryPoolHandle pool)
+    {
+        decode_batch_internal(plains, destination, &thread_pool, move(pool));
+    }
+
+    template<typename T>
+    void BatchEncoder::encode_batch_internal(const vector<T> &values_matrix,
+        size_t vector_size, vector<Plaintext> &destinations, ThreadPool *thread_pool)
+    {
+        auto &context_data = *context_->context_data();
+        uint64_t modulus = context_data.parms().plain_modulus().value();
+
+        // Validate input parameters
+        if (vector_size == 0 || vector_size > slots_)
+        {
+            throw invalid_argument("vector_size is invalid");
+        }
+        if (values_matrix.size() % vector_size)
+        {
+            throw invalid_argument("values_matrix has invalid size");
+        }
+#ifdef SEAL_DEBUG
+        for (auto v : values_matrix)
+        {
+            // Validate the i-th input
+            if (!is_valid_slot_value(v, modulus))
+            {
+                throw invalid_argument("input value is larger than plain_modulus");
+            }
+        }
+#endif
+        size_t vector_count = values_matrix.size() / vector_size;
+        destinations.resize(vector_count);
+
+        size_t block_count = (vector_count + batch_block_size_ - 1) / batch_block_size_;
+        auto encode_block = [&](size_t block_index) {
+            size_t begin = block_index * batch_block_size_;
+            size_t end = min(begin + batch_block_size_, vector_count);
+            for (size_t k = begin; k < end; k++)
+            {
+                const T *values = values_matrix.data() + k * vector_size;
+                Plaintext &destination = destinations[k];
+
+                // Set destination to full size
+                destination.parms_id() = parms_id_zero;
+                destination.resize(slots_);
+
+                // First write the values to destination coefficients.
+                // Read in top row, then bottom row.
+                for (size_t i = 0; i < vector_size; i++)
+                {
+                    *(destination.data() + matrix_reps_index_map_[i]) =
+                        to_slot_value(values[i], modulus);
+                }
+                for (size_t i = vector_size; i < slots_; i++)
+                {
+                    *(destination.data() + matrix_reps_index_map_[i]) = 0;
+                }
+
+                // Transform destination using inverse of negacyclic NTT
+                // Note: We already performed bit-reversal when reading in the matrix
+                inverse_ntt_negacyclic_harvey(destination.data(),
+                    *context_data.plain_ntt_tables());
+            }
+        };
+
+        if (thread_pool)
+        {
+            thread_pool->parallel_for(block_count, encode_block);
+        }
+        else
+        {
+            for (size_t block_index = 0; block_index < block_count; block_index++)
+            {
+                encode_block(block_index);
+            }
+        }
+    }
+
+    template<typename T>
+    void BatchEncoder::decode_batch_internal(const vector<Plaintext> &plains,
+        vector<T> &destination, ThreadPool *thread_pool, MemoryPoolHandle pool)
+    {
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        auto &context_data = *context_->context_data();
+        uint64_t modulus = context_data.parms().plain_modulus().value();
+
+        // Validate input parameters
+        for (auto &plain : plains)
+        {
+            if (plain.is_ntt_form())
+            {
+                throw invalid_argument("plain cannot be in NTT form");
+            }
+            if (plain.coeff_count() > context_data.parms().poly_modulus_degree())
+            {
+                throw invalid_argument("plain is not valid for encryption parameters");
+            }
+#ifdef SEAL_DEBUG
+            if (!are_poly_coefficients_less_than(plain.data(), plain.coeff_count(), modulus))
+            {
+                throw invalid_argument("plain is not valid for encryption parameters");
+            }
+#endif
+        }
+
+        // Set destination size
+        size_t vector_count = plains.size();
+        destination.resize(mul_safe(vector_count, slots_));
+
+        size_t block_count = (vector_count + batch_block_size_ - 1) / batch_block_size_;
+        auto decode_block = [&](size_t block_index) {
+            size_t begin = block_index * batch_block_size_;
+            size_t end = min(begin + batch_block_size_, vector_count);
+
+            auto temp_dest(allocate_uint(slots_, pool));
+            for (size_t k = begin; k < end; k++)
+            {
+                const Plaintext &plain = plains[k];
+
+                // Never include the leading zero coefficient (if present)
+                size_t plain_coeff_count = min(plain.coeff_count(), slots_);
+
+                // Make a copy of poly
+                set_uint_uint(plain.data(), plain_coeff_count, temp_dest.get());
+                set_zero_uint(slots_ - plain_coeff_count,
+                    temp_dest.get() + plain_coeff_count);
+
+                // Transform destination using negacyclic NTT.
+                ntt_negacyclic_harvey(temp_dest.get(), *context_data.plain_ntt_tables());
+
+                // Read top row, then bottom row
+                T *values = destination.data() + k * slots_;
+                for (size_t i = 0; i < slots_; i++)
+                {
+                    from_slot_value(temp_dest[matrix_reps_index_map_[i]], modulus,
+                        values[i]);
+                }
+            }
+        };
+
+        if (thread_pool)
+        {
+            thread_pool->parallel_for(block_count, decode_block);
+        }
+        else
+        {
+            for (size_t block_index = 0; block_index < block_count; block_index++)
+            {
+                decode_block(block_index);
+            }
+        }
+    }
+
+    template<typename T>
+    void BatchEncoder::encode_ntt_internal(const vector<T> &values_matrix,
+        parms_id_type parms_id, Plaintext &destination)
+    {
+        auto context_data_ptr = context_->context_data(parms_id);
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("parms_id is not valid for encryption parameters");
+        }
+
+        auto &context_data = *context_data_ptr;
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+        uint64_t modulus = parms.plain_modulus().value();
+
+        // Validate input parameters
+        size_t values_matrix_size = values_matrix.size();
+        if (values_matrix_size > slots_)
+        {
+            throw logic_error("values_matrix size is too large");
+        }
+#ifdef SEAL_DEBUG
+        for (auto v : values_matrix)
+        {
+            // Validate the i-th input
+            if (!is_valid_slot_value(v, modulus))
+            {
+                throw invalid_argument("input value is larger than plain_modulus");
+            }
+        }
+#endif
+        // Size check
+        if (!product_fits_in(coeff_count, coeff_mod_count))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        // Set destination to full size
+        destination.parms_id() = parms_id_zero;
+        destination.resize(coeff_count * coeff_mod_count);
+
+        // Lifts a coefficient modulo the plaintext modulus to the j-th prime as in
+        // Evaluator::transform_to_ntt_inplace, i.e. values in the upper half are
+        // taken to be negative
+        uint64_t plain_upper_half_threshold = context_data.plain_upper_half_threshold();
+        bool using_fast_plain_lift = context_data.qualifiers().using_fast_plain_lift;
+        auto lift = [&](uint64_t value, size_t j) -> uint64_t {
+            if (using_fast_plain_lift)
+            {
+                return (value >= plain_upper_half_threshold) ?
+                    value + context_data.plain_upper_half_increment()[j] : value;
+            }
+            uint64_t result = value % coeff_modulus[j].value();
+            return (value >= plain_upper_half_threshold) ?
+                sub_uint_uint_mod(result, modulus % coeff_modulus[j].value(),
+                    coeff_modulus[j]) : result;
+        };
+
+        // If every slot holds the same value, the plaintext is that constant, and
+        // so is its NTT form modulo every prime
+        uint64_t first_value = values_matrix_size ?
+            to_slot_value(values_matrix[0], modulus) : 0;
+        bool is_constant = (values_matrix_size == slots_ || first_value == 0) &&
+            all_of(values_matrix.cbegin(), values_matrix.cend(), [&](T v) {
+                return to_slot_value(v, modulus) == first_value; });
+        if (is_constant)
+        {
+            for (size_t j = 0; j < coeff_mod_count; j++)
+            {
+                fill_n(destination.data(j * coeff_count), coeff_count,
+                    lift(first_value, j));
+            }
+            destination.parms_id() = parms_id;
+            return;
+        }
+
+        // First write the values to destination coefficients.
+        // Read in top row, then bottom row.
+        for (size_t i = 0; i < values_matrix_size; i++)
+        {
+            *(destination.data() + matrix_reps_index_map_[i]) =
+                to_slot_value(values_matrix[i], modulus);
+        }
+        for (size_t i = values_matrix_size; i < slots_; i++)
+        {
+            *(destination.data() + matrix_reps_index_map_[i]) = 0;
+        }
+
+        // Transform destination using inverse of negacyclic NTT
+        // Note: We already performed bit-reversal when reading in the matrix
+        inverse_ntt_negacyclic_harvey(destination.data(),
+            *context_->context_data()->plain_ntt_tables());
+
+        // Lift the coefficients to every prime, the first prime last since it
+        // shares its storage with the coefficients, and transform each to the
+        // NTT domain
+        auto &coeff_small_ntt_tables = context_data.small_ntt_tables();
+        const uint64_t *plain_ptr = destination.data();
+        for (size_t j = coeff_mod_count; j--; )
+        {
+            uint64_t *poly = destination.data(j * coeff_count);
+            if (using_fast_plain_lift)
+            {
+                uint64_t increment = context_data.plain_upper_half_increment()[j];
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    poly[i] = plain_ptr[i] +
+                        ((plain_ptr[i] >= plain_upper_half_threshold) ? increment : 0);
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < coeff_count; i++)
+                {
+                    poly[i] = lift(plain_ptr[i], j);
+                }
+            }
+            ntt_negacyclic_harvey(poly, coeff_small_ntt_tables[j]);
+        }
+
+        destination.parms_id() = parms_id;
+    }
 }
@@ -11,6 +11,7 @@
 #include "seal/util/uintarithsmallmod.h"
 #include "seal/plaintext.h"
 #include "seal/context.h"
+#include "seal/threadpool.h"
 
 namespace seal
 {
@@ -98,6 +99,50 @@ namespace seal
         @throws std::invalid_argument if values is too large
         */
         void encode(const std::vector<std::int64_t> &values, Plaintext &destination);
+
+        /**
+        Creates a SEAL plaintext from a given matrix, ready to be multiplied with
+        ciphertexts in NTT form with the given parms_id. The result is the same as
+        that of calling encode and then Evaluator::transform_to_ntt_inplace, but the
+        plaintext is transformed in place and no intermediate plaintext is created.
+        If all slots hold the same value, the plaintext is a constant polynomial,
+        and its NTT form is written directly without computing any transforms.
+
+        If the destination plaintext overlaps the input values in memory, the behavior of
+        this function is undefined.
+
+        @param[in] values The matrix of integers modulo plaintext modulus to batch
+        @param[in] parms_id The parms_id of the ciphertexts the result is to be
+        multiplied with
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @throws std::invalid_argument if values is too large
+        @throws std::invalid_argument if parms_id is not valid for the encryption
+        parameters
+        */
+        void encode(const std::vector<std::uint64_t> &values, parms_id_type parms_id,
+            Plaintext &destination);
+
+        /**
+        Creates a SEAL plaintext from a given matrix, ready to be multiplied with
+        ciphertexts in NTT form with the given parms_id. The result is the same as
+        that of calling encode and then Evaluator::transform_to_ntt_inplace, but the
+        plaintext is transformed in place and no intermediate plaintext is created.
+        If all slots hold the same value, the plaintext is a constant polynomial,
+        and its NTT form is written directly without computing any transforms.
+
+        If the destination plaintext overlaps the input values in memory, the behavior of
+        this function is undefined.
+
+        @param[in] values The matrix of integers modulo plaintext modulus to batch
+        @param[in] parms_id The parms_id of the ciphertexts the result is to be
+        multiplied with
+        @param[out] destination The plaintext polynomial to overwrite with the result
+        @throws std::invalid_argument if values is too large
+        @throws std::invalid_argument if parms_id is not valid for the encryption
+        parameters
+        */
+        void encode(const std::vector<std::int64_t> &values, parms_id_type parms_id,
+            Plaintext &destination);
 #ifdef SEAL_USE_MSGSL_SPAN
         /**
         Creates a SEAL plaintext from a given matrix. This function "batches" a given matrix
@@ -350,6 +395,164 @@ namespace seal
         */
         void decode(Plaintext &plain, MemoryPoolHandle pool = MemoryManager::GetPool());
 
+        /**
+        Creates SEAL plaintexts from several matrices. The matrices are given one after
+        another in values_matrix, each of vector_size elements, and the k-th matrix is
+        batched into the k-th plaintext in destinations, which is resized to the number
+        of matrices. The result is the same as that of calling encode on each matrix,
+        but the parameters are validated only once, and the plaintexts are produced
+        one after another while the NTT tables are in cache.
+
+        @param[in] values_matrix The matrices of integers modulo plaintext modulus to batch
+        @param[in] vector_size The number of elements in each matrix
+        @param[out] destinations The plaintext polynomials to overwrite with the result
+        @throws std::invalid_argument if vector_size is zero or larger than the
+        number of slots
+        @throws std::invalid_argument if the size of values_matrix is not a multiple
+        of vector_size
+        */
+        void encode_batch(const std::vector<std::uint64_t> &values_matrix,
+            std::size_t vector_size, std::vector<Plaintext> &destinations);
+
+        /**
+        Creates SEAL plaintexts from several matrices. The matrices are given one after
+        another in values_matrix, each of vector_size elements, and the k-th matrix is
+        batched into the k-th plaintext in destinations, which is resized to the number
+        of matrices. The result is the same as that of calling encode on each matrix,
+        but the parameters are validated only once, and the plaintexts are produced
+        one after another while the NTT tables are in cache.
+
+        @param[in] values_matrix The matrices of integers modulo plaintext modulus to batch
+        @param[in] vector_size The number of elements in each matrix
+        @param[out] destinations The plaintext polynomials to overwrite with the result
+        @throws std::invalid_argument if vector_size is zero or larger than the
+        number of slots
+        @throws std::invalid_argument if the size of values_matrix is not a multiple
+        of vector_size
+        */
+        void encode_batch(const std::vector<std::int64_t> &values_matrix,
+            std::size_t vector_size, std::vector<Plaintext> &destinations);
+
+        /**
+        Creates SEAL plaintexts from several matrices using the given ThreadPool. The
+        matrices are split into blocks that are batched in parallel on the threads of
+        the ThreadPool; otherwise this function behaves as the single-threaded
+        overload.
+
+        @param[in] values_matrix The matrices of integers modulo plaintext modulus to batch
+        @param[in] vector_size The number of elements in each matrix
+        @param[out] destinations The plaintext polynomials to overwrite with the result
+        @param[in] thread_pool The ThreadPool to batch the matrices on
+        @throws std::invalid_argument if vector_size is zero or larger than the
+        number of slots
+        @throws std::invalid_argument if the size of values_matrix is not a multiple
+        of vector_size
+        */
+        void encode_batch(const std::vector<std::uint64_t> &values_matrix,
+            std::size_t vector_size, std::vector<Plaintext> &destinations, ThreadPool &thread_pool);
+
+        /**
+        Creates SEAL plaintexts from several matrices using the given ThreadPool. The
+        matrices are split into blocks that are batched in parallel on the threads of
+        the ThreadPool; otherwise this function behaves as the single-threaded
+        overload.
+
+        @param[in] values_matrix The matrices of integers modulo plaintext modulus to batch
+        @param[in] vector_size The number of elements in each matrix
+        @param[out] destinations The plaintext polynomials to overwrite with the result
+        @param[in] thread_pool The ThreadPool to batch the matrices on
+        @throws std::invalid_argument if vector_size is zero or larger than the
+        number of slots
+        @throws std::invalid_argument if the size of values_matrix is not a multiple
+        of vector_size
+        */
+        void encode_batch(const std::vector<std::int64_t> &values_matrix,
+            std::size_t vector_size, std::vector<Plaintext> &destinations, ThreadPool &thread_pool);
+
+        /**
+        Inverse of encode_batch. This function "unbatches" several SEAL plaintexts, and
+        stores the k-th matrix in destination, which is resized to hold slot_count()
+        elements for each plaintext, starting from index k * slot_count(). The result
+        is the same as that of calling decode on each plaintext. Dynamic memory
+        allocations in the process are allocated from the memory pool pointed to by
+        the given MemoryPoolHandle.
+
+        @param[in] plains The plaintext polynomials to unbatch
+        @param[out] destination The matrices to be overwritten with the values in the
+        slots
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if any of the plaintexts is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if any of the plaintexts is in NTT form
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void decode_batch(const std::vector<Plaintext> &plains,
+            std::vector<std::uint64_t> &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Inverse of encode_batch. This function "unbatches" several SEAL plaintexts, and
+        stores the k-th matrix in destination, which is resized to hold slot_count()
+        elements for each plaintext, starting from index k * slot_count(). The result
+        is the same as that of calling decode on each plaintext. Dynamic memory
+        allocations in the process are allocated from the memory pool pointed to by
+        the given MemoryPoolHandle.
+
+        @param[in] plains The plaintext polynomials to unbatch
+        @param[out] destination The matrices to be overwritten with the values in the
+        slots
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if any of the plaintexts is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if any of the plaintexts is in NTT form
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void decode_batch(const std::vector<Plaintext> &plains,
+            std::vector<std::int64_t> &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Inverse of encode_batch using the given ThreadPool. The plaintexts are split
+        into blocks that are unbatched in parallel on the threads of the ThreadPool;
+        otherwise this function behaves as the single-threaded overload. Dynamic
+        memory allocations in the process are allocated from the memory pool pointed
+        to by the given MemoryPoolHandle, which should be thread-safe.
+
+        @param[in] plains The plaintext polynomials to unbatch
+        @param[out] destination The matrices to be overwritten with the values in the
+        slots
+        @param[in] thread_pool The ThreadPool to unbatch the plaintexts on
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if any of the plaintexts is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if any of the plaintexts is in NTT form
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void decode_batch(const std::vector<Plaintext> &plains,
+            std::vector<std::uint64_t> &destination, ThreadPool &thread_pool,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Inverse of encode_batch using the given ThreadPool. The plaintexts are split
+        into blocks that are unbatched in parallel on the threads of the ThreadPool;
+        otherwise this function behaves as the single-threaded overload. Dynamic
+        memory allocations in the process are allocated from the memory pool pointed
+        to by the given MemoryPoolHandle, which should be thread-safe.
+
+        @param[in] plains The plaintext polynomials to unbatch
+        @param[out] destination The matrices to be overwritten with the values in the
+        slots
+        @param[in] thread_pool The ThreadPool to unbatch the plaintexts on
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if any of the plaintexts is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if any of the plaintexts is in NTT form
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void decode_batch(const std::vector<Plaintext> &plains,
+            std::vector<std::int64_t> &destination, ThreadPool &thread_pool,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
         /**
         Returns the number of slots.
         */
@@ -372,6 +575,20 @@ namespace seal
 
         void populate_matrix_reps_index_map();
 
+        template<typename T>
+        void encode_ntt_internal(const std::vector<T> &values,
+            parms_id_type parms_id, Plaintext &destination);
+
+        template<typename T>
+        void encode_batch_internal(const std::vector<T> &values_matrix,
+            std::size_t vector_size, std::vector<Plaintext> &destinations,
+            ThreadPool *thread_pool);
+
+        template<typename T>
+        void decode_batch_internal(const std::vector<Plaintext> &plains,
+            std::vector<T> &destination, ThreadPool *thread_pool,
+            MemoryPoolHandle pool);
+
         inline void reverse_bits(std::uint64_t *input)
         {
 #ifdef SEAL_DEBUG
@@ -398,6 +615,9 @@ namespace seal
 
         std::size_t slots_;
 
+        // The number of plaintexts encode_batch and decode_batch process together
+        static constexpr std::size_t batch_block_size_ = 8;
+
         util::Pointer<std::uint64_t> roots_of_unity_;
 
         util::Pointer<std::uint64_t> matrix_reps_index_map_;
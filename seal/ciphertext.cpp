@@ -3,6 +3,9 @@
 
 #include "seal/ciphertext.h"
 #include "seal/util/polycore.h"
+#include "seal/util/bitpack.h"
+#include "seal/util/streambuf.h"
+#include <cstring>
 
 using namespace std;
 using namespace seal::util;
@@ -22,6 +25,12 @@ namespace seal
         is_ntt_form_ = assign.is_ntt_form_;
         scale_ = assign.scale_;
 
+        // Never write into aliased memory; allocate our own instead
+        if (data_.is_alias())
+        {
+            data_.release();
+        }
+
         // Then resize
         resize_internal(assign.size_, assign.poly_modulus_degree_, 
             assign.coeff_mod_count_);
@@ -119,6 +128,9 @@ namespace seal
             throw invalid_argument("invalid size");
         }
 
+        // Never write into aliased memory, e.g. when zeroing new polynomials
+        detach();
+
         // Resize the data
         size_type new_data_size = 
             mul_safe(size, poly_modulus_degree, coeff_mod_count);
@@ -171,7 +183,7 @@ namespace seal
         return true;
     }
 
-    void Ciphertext::save(ostream &stream) const
+    void Ciphertext::save(ostream &stream, compr_mode_type compr_mode) const
     {
         auto old_except_mask = stream.exceptions();
         try
@@ -179,6 +191,19 @@ namespace seal
             // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
             stream.exceptions(ios_base::badbit | ios_base::failbit);
 
+            bool bit_packed = (compr_mode == compr_mode_type::bit_packed);
+            if (bit_packed)
+            {
+                stream.write(reinterpret_cast<const char*>(&bit_packed_magic),
+                    sizeof(uint64_t));
+                stream.write(reinterpret_cast<const char*>(&bit_packed_version),
+                    sizeof(uint64_t));
+            }
+            else if (compr_mode != compr_mode_type::none)
+            {
+                throw invalid_argument("unsupported compression mode");
+            }
+
             stream.write(reinterpret_cast<const char*>(&parms_id_), sizeof(parms_id_type));
             SEAL_BYTE is_ntt_form_byte = static_cast<SEAL_BYTE>(is_ntt_form_);
             stream.write(reinterpret_cast<const char*>(&is_ntt_form_byte), sizeof(SEAL_BYTE));
@@ -190,8 +215,17 @@ namespace seal
             stream.write(reinterpret_cast<const char*>(&coeff_mod_count64), sizeof(uint64_t));
             stream.write(reinterpret_cast<const char*>(&scale_), sizeof(double));
 
-            // Save the data
-            data_.save(stream);
+            // Save the data; with bit packing every RNS component of every
+            // polynomial gets its own bit width
+            if (bit_packed)
+            {
+                save_bit_packed(data_.cbegin(), data_.size(), 
+                    max<size_type>(poly_modulus_degree_, 1), stream);
+            }
+            else
+            {
+                data_.save(stream);
+            }
         }
         catch (const exception &)
         {
@@ -203,6 +237,11 @@ namespace seal
     }
 
     void Ciphertext::unsafe_load(istream &stream)
+    {
+        unsafe_load_internal(stream, nullptr);
+    }
+
+    void Ciphertext::unsafe_load_internal(istream &stream, const uint64_t *first_word)
     {
         auto old_except_mask = stream.exceptions();
         try
@@ -210,8 +249,32 @@ namespace seal
             // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
             stream.exceptions(ios_base::badbit | ios_base::failbit);
 
+            // Data saved without compression starts directly with the parms_id
             parms_id_type parms_id{};
-            stream.read(reinterpret_cast<char*>(&parms_id), sizeof(parms_id_type));
+            if (first_word)
+            {
+                parms_id[0] = *first_word;
+            }
+            else
+            {
+                stream.read(reinterpret_cast<char*>(&parms_id[0]), sizeof(uint64_t));
+            }
+            bool bit_packed = (parms_id[0] == bit_packed_magic);
+            if (bit_packed)
+            {
+                uint64_t version = 0;
+                stream.read(reinterpret_cast<char*>(&version), sizeof(uint64_t));
+                if (version != bit_packed_version)
+                {
+                    throw invalid_argument("unsupported format version");
+                }
+                stream.read(reinterpret_cast<char*>(&parms_id), sizeof(parms_id_type));
+            }
+            else
+            {
+                stream.read(reinterpret_cast<char*>(&parms_id[1]), 
+                    sizeof(parms_id_type) - sizeof(uint64_t));
+            }
             SEAL_BYTE is_ntt_form_byte;
             stream.read(reinterpret_cast<char*>(&is_ntt_form_byte), sizeof(SEAL_BYTE));
             uint64_t size64 = 0;
@@ -225,7 +288,14 @@ namespace seal
 
             // Load the data
             IntArray<ct_coeff_type> new_data(data_.pool());
-            new_data.load(stream);
+            if (bit_packed)
+            {
+                load_bit_packed(stream, new_data);
+            }
+            else
+            {
+                new_data.load(stream);
+            }
             if (unsigned_neq(new_data.size(),
                 mul_safe(size64, poly_modulus_degree64, coeff_mod_count64)))
             {
@@ -251,4 +321,160 @@ namespace seal
 
         stream.exceptions(old_except_mask);
     }
+
+    void Ciphertext::save_mappable(ostream &stream) const
+    {
+        auto old_except_mask = stream.exceptions();
+        try
+        {
+            // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+            stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+            stream.write(reinterpret_cast<const char*>(&parms_id_), sizeof(parms_id_type));
+            uint64_t is_ntt_form64 = static_cast<uint64_t>(is_ntt_form_);
+            stream.write(reinterpret_cast<const char*>(&is_ntt_form64), sizeof(uint64_t));
+            uint64_t size64 = safe_cast<uint64_t>(size_);
+            stream.write(reinterpret_cast<const char*>(&size64), sizeof(uint64_t));
+            uint64_t poly_modulus_degree64 = safe_cast<uint64_t>(poly_modulus_degree_);
+            stream.write(reinterpret_cast<const char*>(&poly_modulus_degree64), sizeof(uint64_t));
+            uint64_t coeff_mod_count64 = safe_cast<uint64_t>(coeff_mod_count_);
+            stream.write(reinterpret_cast<const char*>(&coeff_mod_count64), sizeof(uint64_t));
+            stream.write(reinterpret_cast<const char*>(&scale_), sizeof(double));
+
+            // Save the data without a size prefix; it is implied by the above
+            stream.write(reinterpret_cast<const char*>(data_.cbegin()),
+                safe_cast<streamsize>(mul_safe(data_.size(), 
+                    safe_cast<size_type>(sizeof(ct_coeff_type)))));
+        }
+        catch (const exception &)
+        {
+            stream.exceptions(old_except_mask);
+            throw;
+        }
+
+        stream.exceptions(old_except_mask);
+    }
+
+    void Ciphertext::unsafe_map(SEAL_BYTE *&ptr, const SEAL_BYTE *end)
+    {
+        constexpr size_t header_size = sizeof(parms_id_type) + 
+            4 * sizeof(uint64_t) + sizeof(double);
+        if (!ptr || static_cast<size_t>(end - ptr) < header_size)
+        {
+            throw invalid_argument("ciphertext data is invalid");
+        }
+        if (reinterpret_cast<uintptr_t>(ptr) % alignof(ct_coeff_type))
+        {
+            throw invalid_argument("ciphertext data is not aligned");
+        }
+
+        parms_id_type parms_id{};
+        memcpy(&parms_id, ptr, sizeof(parms_id_type));
+        ptr += sizeof(parms_id_type);
+        uint64_t header[4];
+        memcpy(header, ptr, sizeof(header));
+        ptr += sizeof(header);
+        double scale = 0;
+        memcpy(&scale, ptr, sizeof(double));
+        ptr += sizeof(double);
+
+        if ((header[1] < SEAL_CIPHERTEXT_SIZE_MIN && header[1] != 0) ||
+            header[1] > SEAL_CIPHERTEXT_SIZE_MAX)
+        {
+            throw invalid_argument("ciphertext data is invalid");
+        }
+        size_type data_size = mul_safe(safe_cast<size_type>(header[1]),
+            safe_cast<size_type>(header[2]), safe_cast<size_type>(header[3]));
+        size_t data_byte_count = mul_safe(data_size, sizeof(ct_coeff_type));
+        if (static_cast<size_t>(end - ptr) < data_byte_count)
+        {
+            throw invalid_argument("ciphertext data is invalid");
+        }
+
+        // Set values
+        parms_id_ = parms_id;
+        is_ntt_form_ = (header[0] != 0);
+        size_capacity_ = max<size_type>(safe_cast<size_type>(header[1]), 
+            SEAL_CIPHERTEXT_SIZE_MIN);
+        size_ = safe_cast<size_type>(header[1]);
+        poly_modulus_degree_ = safe_cast<size_type>(header[2]);
+        coeff_mod_count_ = safe_cast<size_type>(header[3]);
+        scale_ = scale;
+
+        // Alias the data; its pages are only faulted in when first read
+        auto new_data = IntArray<ct_coeff_type>::Aliasing(
+            reinterpret_cast<ct_coeff_type*>(ptr), data_size, data_.pool());
+        data_.swap_with(new_data);
+        ptr += data_byte_count;
+    }
+
+    size_t Ciphertext::save_size(compr_mode_type compr_mode) const
+    {
+        size_t header_size = sizeof(parms_id_type) + sizeof(SEAL_BYTE) +
+            3 * sizeof(uint64_t) + sizeof(double);
+        switch (compr_mode)
+        {
+        case compr_mode_type::none:
+            return add_safe(header_size, data_.save_size());
+
+        case compr_mode_type::bit_packed:
+            return add_safe(2 * sizeof(uint64_t), header_size,
+                bit_packed_save_size(data_.cbegin(), data_.size(),
+                    max<size_type>(poly_modulus_degree_, 1)));
+
+        default:
+            throw invalid_argument("unsupported compression mode");
+        }
+    }
+
+    size_t Ciphertext::save(void *destination, size_t size,
+        compr_mode_type compr_mode) const
+    {
+        ArrayPutBuffer apbuf(destination, size);
+        ostream stream(&apbuf);
+        save(stream, compr_mode);
+        return apbuf.size();
+    }
+
+    size_t Ciphertext::unsafe_load(const void *source, size_t size)
+    {
+        ArrayGetBuffer agbuf(source, size);
+        istream stream(&agbuf);
+        unsafe_load(stream);
+        return agbuf.size();
+    }
+
+    Ciphertext Ciphertext::Aliasing(shared_ptr<SEALContext> context,
+        const void *source, size_t size, MemoryPoolHandle pool)
+    {
+        // Verify parameters
+        if (!context)
+        {
+            throw invalid_argument("invalid context");
+        }
+        if (!context->parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+
+        // The data is only ever read through the returned ciphertext, which
+        // detaches before any write
+        Ciphertext result(move(pool));
+        auto ptr = const_cast<SEAL_BYTE*>(static_cast<const SEAL_BYTE*>(source));
+        result.unsafe_map(ptr, ptr + size);
+
+        auto context_data_ptr = context->context_data(result.parms_id_);
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("ciphertext data is invalid");
+        }
+        auto &parms = context_data_ptr->parms();
+        if (parms.coeff_modulus().size() != result.coeff_mod_count_ ||
+            parms.poly_modulus_degree() != result.poly_modulus_degree_)
+        {
+            throw invalid_argument("ciphertext data is invalid");
+        }
+
+        return result;
+    }
 }
@@ -12,6 +12,7 @@
 #include "seal/context.h"
 #include "seal/memorymanager.h"
 #include "seal/intarray.h"
+#include "seal/serialization.h"
 
 namespace seal
 {
@@ -47,6 +48,12 @@ namespace seal
     */
     class Ciphertext
     {
+        friend class GaloisKeys;
+
+        friend class RelinKeys;
+
+        friend class PublicKey;
+
     public:
         using ct_coeff_type = std::uint64_t;
 
@@ -309,10 +316,12 @@ namespace seal
         Ciphertext &operator =(Ciphertext &&assign) = default;
 
         /**
-        Returns a pointer to the beginning of the ciphertext data.
+        Returns a pointer to the beginning of the ciphertext data. A ciphertext
+        aliasing external memory is first detached from it.
         */
-        inline ct_coeff_type *data() noexcept
+        inline ct_coeff_type *data()
         {
+            detach();
             return data_.begin();
         }
 
@@ -333,6 +342,7 @@ namespace seal
             gsl::dynamic_range,
             gsl::dynamic_range> data_span()
         {
+            detach();
             return gsl::as_multi_span<
                 ct_coeff_type,
                 gsl::dynamic_range,
@@ -387,6 +397,7 @@ namespace seal
             {
                 throw std::out_of_range("poly_index must be within [0, size)");
             }
+            detach();
             return data_.begin() + util::safe_cast<std::size_t>(
                 util::mul_safe(poly_index, poly_uint64_count));
         }
@@ -429,6 +440,7 @@ namespace seal
         */
         inline ct_coeff_type &operator [](size_type coeff_index)
         {
+            detach();
             return data_.at(coeff_index);
         }
 
@@ -516,13 +528,17 @@ namespace seal
         and not human-readable. The output stream must have the "binary" flag set.
 
         @param[in] stream The stream to save the ciphertext to
+        @param[in] compr_mode The format to save in
+        @throws std::invalid_argument if compr_mode is not supported
         @throws std::exception if the ciphertext could not be written to stream
         */
-        void save(std::ostream &stream) const;
+        void save(std::ostream &stream, 
+            compr_mode_type compr_mode = compr_mode_type::none) const;
 
         /**
         Loads a ciphertext from an input stream overwriting the current ciphertext.
-        No checking of the validity of the ciphertext data against encryption
+        The format the ciphertext was saved in is detected automatically. No 
+        checking of the validity of the ciphertext data against encryption
         parameters is performed. This function should not be used unless the 
         ciphertext comes from a fully trusted source.
 
@@ -553,6 +569,131 @@ namespace seal
             }
         }
 
+        /**
+        Returns the exact number of bytes save writes for the ciphertext in the
+        given format.
+
+        @param[in] compr_mode The format to save in
+        @throws std::invalid_argument if compr_mode is not supported
+        */
+        std::size_t save_size(
+            compr_mode_type compr_mode = compr_mode_type::none) const;
+
+        /**
+        Saves the ciphertext directly into a caller-owned buffer, which must have
+        room for at least save_size(compr_mode) bytes. Returns the number of bytes
+        written.
+
+        @param[out] destination The buffer to save the ciphertext to
+        @param[in] size The size of the buffer in bytes
+        @param[in] compr_mode The format to save in
+        @throws std::invalid_argument if destination is null and size is non-zero
+        @throws std::invalid_argument if compr_mode is not supported
+        @throws std::exception if the ciphertext does not fit in the buffer
+        */
+        std::size_t save(void *destination, std::size_t size,
+            compr_mode_type compr_mode = compr_mode_type::none) const;
+
+        /**
+        Loads a ciphertext directly from a caller-owned buffer overwriting the
+        current ciphertext. Returns the number of bytes read. No checking of the
+        validity of the ciphertext data against encryption parameters is 
+        performed. This function should not be used unless the ciphertext comes 
+        from a fully trusted source.
+
+        @param[in] source The buffer to load the ciphertext from
+        @param[in] size The size of the buffer in bytes
+        @throws std::invalid_argument if source is null and size is non-zero
+        @throws std::exception if a valid ciphertext could not be read from source
+        */
+        std::size_t unsafe_load(const void *source, std::size_t size);
+
+        /**
+        Loads a ciphertext directly from a caller-owned buffer overwriting the
+        current ciphertext. Returns the number of bytes read. The loaded 
+        ciphertext is verified to be valid for the given SEALContext.
+
+        @param[in] context The SEALContext
+        @param[in] source The buffer to load the ciphertext from
+        @param[in] size The size of the buffer in bytes
+        @throws std::invalid_argument if the context is not set or encryption
+        parameters are not valid
+        @throws std::invalid_argument if source is null and size is non-zero
+        @throws std::exception if a valid ciphertext could not be read from source
+        @throws std::invalid_argument if the loaded ciphertext is invalid for the
+        context
+        */
+        inline std::size_t load(std::shared_ptr<SEALContext> context,
+            const void *source, std::size_t size)
+        {
+            std::size_t in_size = unsafe_load(source, size);
+            if (!is_valid_for(std::move(context)))
+            {
+                throw std::invalid_argument("ciphertext data is invalid");
+            }
+            return in_size;
+        }
+
+        /**
+        Saves the ciphertext in the aligned record format accepted by Aliasing.
+        Every field occupies a multiple of 8 bytes, so the data of a record 
+        stored at an 8-byte aligned address (e.g. the start of a Node Buffer, an 
+        mmap region, or a shared-memory segment) is itself aligned. The output 
+        stream must have the "binary" flag set.
+
+        @param[in] stream The stream to save the ciphertext to
+        @throws std::exception if the ciphertext could not be written to stream
+        */
+        void save_mappable(std::ostream &stream) const;
+
+        /**
+        Returns the exact number of bytes save_mappable writes.
+        */
+        inline std::size_t save_mappable_size() const
+        {
+            return util::add_safe(sizeof(parms_id_type) + 4 * sizeof(std::uint64_t) + 
+                sizeof(double), util::mul_safe(data_.size(), sizeof(ct_coeff_type)));
+        }
+
+        /**
+        Creates a ciphertext that aliases a record written by save_mappable in
+        externally owned memory, without copying or even reading the data. The 
+        memory must be 8-byte aligned and must outlive the returned ciphertext.
+        Only the metadata of the record is verified to be valid for the given 
+        SEALContext; the coefficients are not scanned, so the memory should come
+        from a trusted source.
+
+        The returned ciphertext is intended as a read-only operand, e.g. to the
+        Evaluator functions taking const references. The external memory is
+        never written: assigning to the ciphertext, resizing it, or accessing
+        its data through a non-const function (as in-place Evaluator operations
+        do) first detaches it by copying the data into memory allocated from
+        pool.
+
+        @param[in] context The SEALContext
+        @param[in] source The memory holding the record
+        @param[in] size The number of bytes available at source
+        @param[in] pool The MemoryPoolHandle used when the ciphertext is detached
+        @throws std::invalid_argument if the context is not set or encryption
+        parameters are not valid
+        @throws std::invalid_argument if source is not 8-byte aligned
+        @throws std::invalid_argument if source does not hold a valid record
+        @throws std::invalid_argument if the record is invalid for the context
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        static Ciphertext Aliasing(std::shared_ptr<SEALContext> context,
+            const void *source, std::size_t size,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Returns whether the ciphertext data is externally owned memory aliased
+        through Aliasing or a memory-mapped key file.
+        */
+        inline bool is_alias() const noexcept
+        {
+            return data_.is_alias();
+        }
+
         /**
         Returns whether the ciphertext is in NTT form.
         */
@@ -617,6 +758,34 @@ namespace seal
         }
 
     private:
+        /**
+        Loads the data like unsafe_load, except that the first word of the data
+        has already been read from stream by the caller if first_word is not null.
+        This lets the key classes tell their own formats apart from the plain
+        ones.
+        */
+        void unsafe_load_internal(std::istream &stream,
+            const std::uint64_t *first_word);
+
+        /**
+        Points the ciphertext to a record written by save_mappable without
+        copying the data. On return ptr points past the record. The memory
+        must outlive the ciphertext, or at least its use as an alias.
+        */
+        void unsafe_map(SEAL_BYTE *&ptr, const SEAL_BYTE *end);
+
+        /**
+        Copies aliased data into memory allocated from the pool of the
+        ciphertext, so that the aliased memory is never written.
+        */
+        inline void detach()
+        {
+            if (data_.is_alias())
+            {
+                data_.reserve(data_.capacity());
+            }
+        }
+
         void reserve_internal(size_type size_capacity, 
             size_type poly_modulus_degree, size_type coeff_mod_count);
 
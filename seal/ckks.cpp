@@ -60,14 +60,63 @@ namespace seal
             pos &= (m - 1);
         }
 
-        roots_ = allocate<complex<double>>(coeff_count, pool_);
-        inv_roots_ = allocate<complex<double>>(coeff_count, pool_);
+        // The real parts are followed by the imaginary parts
+        roots_ = allocate<double>(2 * coeff_count, pool_);
+        inv_roots_ = allocate<double>(2 * coeff_count, pool_);
         complex<double> psi{ cos((2 * PI_) / static_cast<double>(m)), 
             sin((2 * PI_) / static_cast<double>(m)) };
         for (size_t i = 0; i < coeff_count; i++)
         {
-            roots_[i] = pow(psi, static_cast<double>(reverse_bits(i, logn)));
-            inv_roots_[i] = 1.0 / roots_[i];
+            complex<double> root = pow(psi, static_cast<double>(reverse_bits(i, logn)));
+            complex<double> inv_root = 1.0 / root;
+            roots_[i] = root.real();
+            roots_[coeff_count + i] = root.imag();
+            inv_roots_[i] = inv_root.real();
+            inv_roots_[coeff_count + i] = inv_root.imag();
+        }
+
+        // Constants for converting between doubles and the RNS representation
+        auto &coeff_modulus = context_data.parms().coeff_modulus();
+        crt_modulus_count_ = coeff_modulus.size();
+        pow2_mod_count_ = static_cast<size_t>(
+            context_data.total_coeff_modulus_bit_count());
+        auto shoup_quotient = [](uint64_t operand, uint64_t modulus_value) {
+            uint64_t wide_operand[2]{ 0, operand };
+            uint64_t wide_quotient[2]{ 0, 0 };
+            divide_uint128_uint64_inplace(wide_operand, modulus_value, wide_quotient);
+            return wide_quotient[0];
+        };
+
+        pow2_mod_ = allocate_uint(
+            mul_safe(size_t(2), crt_modulus_count_, pow2_mod_count_), pool_);
+        for (size_t j = 0; j < crt_modulus_count_; j++)
+        {
+            uint64_t modulus_value = coeff_modulus[j].value();
+            uint64_t pow2 = 1;
+            auto pow2_mod = pow2_mod_.get() + 2 * j * pow2_mod_count_;
+            for (size_t e = 0; e < pow2_mod_count_; e++)
+            {
+                pow2_mod[2 * e] = pow2;
+                pow2_mod[2 * e + 1] = shoup_quotient(pow2, modulus_value);
+                pow2 = add_uint_uint_mod(pow2, pow2, coeff_modulus[j]);
+            }
+        }
+
+        garner_inv_ = allocate_zero_uint(
+            mul_safe(size_t(2), crt_modulus_count_, crt_modulus_count_), pool_);
+        for (size_t j = 0; j < crt_modulus_count_; j++)
+        {
+            uint64_t modulus_value = coeff_modulus[j].value();
+            auto inv = garner_inv_.get() + 2 * j * crt_modulus_count_;
+            for (size_t l = 0; l < j; l++)
+            {
+                if (!try_invert_uint_mod(coeff_modulus[l].value() % modulus_value,
+                    coeff_modulus[j], inv[2 * l]))
+                {
+                    throw invalid_argument("coeff_modulus primes are not coprime");
+                }
+                inv[2 * l + 1] = shoup_quotient(inv[2 * l], modulus_value);
+            }
         }
     }
 
@@ -113,8 +162,6 @@ namespace seal
             throw invalid_argument("encoded value is too large");
         }
 
-        double two_pow_64 = pow(2.0, 64);
-
         // Resize destination to appropriate size
         // Need to first set parms_id to zero, otherwise resize
         // will throw an exception.
@@ -148,47 +195,12 @@ namespace seal
                 }
             }
         }
-        else if (coeff_bit_count <= 128)
-        {
-            uint64_t coeffu[2]{
-                static_cast<uint64_t>(fmod(coeffd, two_pow_64)),
-                static_cast<uint64_t>(coeffd / two_pow_64) };
-
-            if (is_negative)
-            {
-                for (size_t j = 0; j < coeff_mod_count; j++)
-                {
-                    fill_n(destination.data() + (j * coeff_count), coeff_count,
-                        negate_uint_mod(barrett_reduce_128(
-                            coeffu, coeff_modulus[j]), coeff_modulus[j]));
-                }
-            }
-            else
-            {
-                for (size_t j = 0; j < coeff_mod_count; j++)
-                {
-                    fill_n(destination.data() + (j * coeff_count), coeff_count,
-                        barrett_reduce_128(coeffu, coeff_modulus[j]));
-                }
-            }
-        }
         else
         {
-            // Slow case
-            auto coeffu(allocate_uint(coeff_mod_count, pool));
+            // Larger values are reduced through their exponent
             auto decomp_coeffu(allocate_uint(coeff_mod_count, pool));
-
-            // We are at this point guaranteed to fit in the allocated space
-            set_zero_uint(coeff_mod_count, coeffu.get());
-            auto coeffu_ptr = coeffu.get();
-            while (coeffd >= 1)
-            {
-                *coeffu_ptr++ = static_cast<uint64_t>(fmod(coeffd, two_pow_64));
-                coeffd /= two_pow_64;
-            }
-
-            // Next decompose this coefficient
-            decompose_single_coeff(context_data, coeffu.get(), decomp_coeffu.get(), pool);
+            decompose_single_coeff(coeffd, coeff_mod_count, coeff_modulus,
+                decomp_coeffu.get(), 1);
 
             // Finally replace the sign if necessary
             if (is_negative)
@@ -9,11 +9,14 @@
 #include <cmath>
 #include <vector>
 #include <limits>
+#include <algorithm>
 #include "seal/plaintext.h"
 #include "seal/context.h"
 #include "seal/util/common.h"
 #include "seal/util/uintcore.h"
 #include "seal/util/uintarithsmallmod.h"
+#include "seal/util/ckksfft.h"
+#include "seal/threadpool.h"
 
 namespace seal
 {
@@ -273,6 +276,220 @@ namespace seal
             decode_internal(plain, destination, std::move(pool));
         }
 
+        /**
+        Encodes several vectors of double-precision floating-point real or complex
+        numbers into plaintext polynomials. The vectors are given as the rows of a
+        matrix stored contiguously in row-major order, and the k-th row is encoded
+        into the k-th plaintext in destinations, which is resized to the number of
+        rows. The result is the same as that of calling encode on each row, but the
+        parameters are validated and the scratch space is allocated only once for
+        several rows, and the NTTs of several rows are computed together. Dynamic
+        memory allocations in the process are allocated from the memory pool pointed
+        to by the given MemoryPoolHandle.
+
+        @tparam T Vector value type (double or std::complex<double>)
+        @param[in] values_matrix The rows to encode, one after another
+        @param[in] vector_size The length of each row
+        @param[in] parms_id parms_id determining the encryption parameters to be used
+        by the result plaintexts
+        @param[in] scale Scaling parameter defining encoding precision
+        @param[out] destinations The plaintext polynomials to overwrite with the result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if vector_size is zero or larger than the
+        number of slots
+        @throws std::invalid_argument if the size of values_matrix is not a multiple
+        of vector_size
+        @throws std::invalid_argument if parms_id is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if scale is not strictly positive
+        @throws std::invalid_argument if encoding is too large for the encryption
+        parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        template<typename T,
+            typename = std::enable_if_t<std::is_same<T, double>::value ||
+            std::is_same<T, std::complex<double>>::value>>
+        inline void encode_batch(const std::vector<T> &values_matrix,
+            std::size_t vector_size, parms_id_type parms_id, double scale,
+            std::vector<Plaintext> &destinations,
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            encode_batch_internal(values_matrix, vector_size, parms_id, scale,
+                destinations, nullptr, std::move(pool));
+        }
+
+        /**
+        Encodes several vectors of double-precision floating-point real or complex
+        numbers into plaintext polynomials using the given ThreadPool. The rows of
+        values_matrix are split into blocks that are encoded in parallel on the
+        threads of the ThreadPool; otherwise this function behaves as the
+        single-threaded overload. Dynamic memory allocations in the process are
+        allocated from the memory pool pointed to by the given MemoryPoolHandle,
+        which should be thread-safe.
+
+        @tparam T Vector value type (double or std::complex<double>)
+        @param[in] values_matrix The rows to encode, one after another
+        @param[in] vector_size The length of each row
+        @param[in] parms_id parms_id determining the encryption parameters to be used
+        by the result plaintexts
+        @param[in] scale Scaling parameter defining encoding precision
+        @param[out] destinations The plaintext polynomials to overwrite with the result
+        @param[in] thread_pool The ThreadPool to encode the rows on
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if vector_size is zero or larger than the
+        number of slots
+        @throws std::invalid_argument if the size of values_matrix is not a multiple
+        of vector_size
+        @throws std::invalid_argument if parms_id is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if scale is not strictly positive
+        @throws std::invalid_argument if encoding is too large for the encryption
+        parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        template<typename T,
+            typename = std::enable_if_t<std::is_same<T, double>::value ||
+            std::is_same<T, std::complex<double>>::value>>
+        inline void encode_batch(const std::vector<T> &values_matrix,
+            std::size_t vector_size, parms_id_type parms_id, double scale,
+            std::vector<Plaintext> &destinations, ThreadPool &thread_pool,
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            encode_batch_internal(values_matrix, vector_size, parms_id, scale,
+                destinations, &thread_pool, std::move(pool));
+        }
+
+        /**
+        Encodes several vectors of double-precision floating-point real or complex
+        numbers into plaintext polynomials, as the rows of a matrix stored
+        contiguously in row-major order. The encryption parameters used are the top
+        level parameters for the given context. Dynamic memory allocations in the
+        process are allocated from the memory pool pointed to by the given
+        MemoryPoolHandle.
+
+        @tparam T Vector value type (double or std::complex<double>)
+        @param[in] values_matrix The rows to encode, one after another
+        @param[in] vector_size The length of each row
+        @param[in] scale Scaling parameter defining encoding precision
+        @param[out] destinations The plaintext polynomials to overwrite with the result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if vector_size is zero or larger than the
+        number of slots
+        @throws std::invalid_argument if the size of values_matrix is not a multiple
+        of vector_size
+        @throws std::invalid_argument if scale is not strictly positive
+        @throws std::invalid_argument if encoding is too large for the encryption
+        parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        template<typename T,
+            typename = std::enable_if_t<std::is_same<T, double>::value ||
+            std::is_same<T, std::complex<double>>::value>>
+        inline void encode_batch(const std::vector<T> &values_matrix,
+            std::size_t vector_size, double scale,
+            std::vector<Plaintext> &destinations,
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            encode_batch(values_matrix, vector_size, context_->first_parms_id(),
+                scale, destinations, std::move(pool));
+        }
+
+        /**
+        Encodes several vectors of double-precision floating-point real or complex
+        numbers into plaintext polynomials using the given ThreadPool. The
+        encryption parameters used are the top level parameters for the given
+        context. Dynamic memory allocations in the process are allocated from the
+        memory pool pointed to by the given MemoryPoolHandle, which should be
+        thread-safe.
+
+        @tparam T Vector value type (double or std::complex<double>)
+        @param[in] values_matrix The rows to encode, one after another
+        @param[in] vector_size The length of each row
+        @param[in] scale Scaling parameter defining encoding precision
+        @param[out] destinations The plaintext polynomials to overwrite with the result
+        @param[in] thread_pool The ThreadPool to encode the rows on
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if vector_size is zero or larger than the
+        number of slots
+        @throws std::invalid_argument if the size of values_matrix is not a multiple
+        of vector_size
+        @throws std::invalid_argument if scale is not strictly positive
+        @throws std::invalid_argument if encoding is too large for the encryption
+        parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        template<typename T,
+            typename = std::enable_if_t<std::is_same<T, double>::value ||
+            std::is_same<T, std::complex<double>>::value>>
+        inline void encode_batch(const std::vector<T> &values_matrix,
+            std::size_t vector_size, double scale,
+            std::vector<Plaintext> &destinations, ThreadPool &thread_pool,
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            encode_batch(values_matrix, vector_size, context_->first_parms_id(),
+                scale, destinations, thread_pool, std::move(pool));
+        }
+
+        /**
+        Decodes several plaintext polynomials into double-precision floating-point
+        real or complex numbers. The slots of the k-th plaintext are written to the
+        k-th row of a matrix stored contiguously in row-major order in destination,
+        which is resized to hold one row of slot_count() values for each plaintext.
+        The result is the same as that of calling decode on each plaintext. Dynamic
+        memory allocations in the process are allocated from the memory pool pointed
+        to by the given MemoryPoolHandle.
+
+        @tparam T Vector value type (double or std::complex<double>)
+        @param[in] plains The plaintexts to decode
+        @param[out] destination The matrix to be overwritten with the values in the
+        slots
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if the plaintexts do not all have the same
+        parms_id
+        @throws std::invalid_argument if any of the plaintexts is not in NTT form or
+        is invalid for the encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        template<typename T,
+            typename = std::enable_if_t<std::is_same<T, double>::value ||
+            std::is_same<T, std::complex<double>>::value>>
+        inline void decode_batch(const std::vector<Plaintext> &plains,
+            std::vector<T> &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            decode_batch_internal(plains, destination, nullptr, std::move(pool));
+        }
+
+        /**
+        Decodes several plaintext polynomials into double-precision floating-point
+        real or complex numbers using the given ThreadPool. The plaintexts are split
+        into blocks that are decoded in parallel on the threads of the ThreadPool;
+        otherwise this function behaves as the single-threaded overload. Dynamic
+        memory allocations in the process are allocated from the memory pool pointed
+        to by the given MemoryPoolHandle, which should be thread-safe.
+
+        @tparam T Vector value type (double or std::complex<double>)
+        @param[in] plains The plaintexts to decode
+        @param[out] destination The matrix to be overwritten with the values in the
+        slots
+        @param[in] thread_pool The ThreadPool to decode the plaintexts on
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if the plaintexts do not all have the same
+        parms_id
+        @throws std::invalid_argument if any of the plaintexts is not in NTT form or
+        is invalid for the encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        template<typename T,
+            typename = std::enable_if_t<std::is_same<T, double>::value ||
+            std::is_same<T, std::complex<double>>::value>>
+        inline void decode_batch(const std::vector<Plaintext> &plains,
+            std::vector<T> &destination, ThreadPool &thread_pool,
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            decode_batch_internal(plains, destination, &thread_pool, std::move(pool));
+        }
+
         /**
         Returns the number of complex numbers encoded.
         */
@@ -282,51 +499,50 @@ namespace seal
         }
 
     private:
-        // This is the same function as in evaluator.h
-        inline void decompose_single_coeff(
-            const SEALContext::ContextData &context_data, const std::uint64_t *value, 
-            std::uint64_t *destination, util::MemoryPool &pool)
+        // Returns value * operand mod q using the precomputed quotient
+        // floor(operand * 2^64 / q); value can be any 64-bit integer.
+        static inline std::uint64_t multiply_uint_mod_shoup(std::uint64_t value,
+            std::uint64_t operand, std::uint64_t quotient, std::uint64_t modulus_value)
         {
-            auto &parms = context_data.parms();
-            auto &coeff_modulus = parms.coeff_modulus();
-            std::size_t coeff_mod_count = coeff_modulus.size();
+            unsigned long long hw64;
+            util::multiply_uint64_hw64(value, quotient, &hw64);
+            std::uint64_t result = value * operand -
+                static_cast<std::uint64_t>(hw64) * modulus_value;
+            return (result >= modulus_value) ? result - modulus_value : result;
+        }
+
+        // Writes the residues of a non-negative integer-valued double modulo the
+        // first coeff_mod_count primes to destination[0], destination[stride], ...
+        // The double is exactly mantissa * 2^shift with a 53-bit mantissa, so only
+        // the mantissa is reduced and then multiplied by 2^shift mod q_j.
+        inline void decompose_single_coeff(double coeffd, std::size_t coeff_mod_count,
+            const std::vector<SmallModulus> &coeff_modulus, std::uint64_t *destination,
+            std::size_t stride)
+        {
+            int exponent;
+            std::frexp(coeffd, &exponent);
+            int shift = std::max(exponent - std::numeric_limits<double>::digits, 0);
+            std::uint64_t mantissa =
+                static_cast<std::uint64_t>(std::ldexp(coeffd, -shift));
 #ifdef SEAL_DEBUG
-            if (value == nullptr)
-            {
-                throw std::invalid_argument("value cannot be null");
-            }
-            if (destination == nullptr)
+            if (static_cast<std::size_t>(shift) >= pow2_mod_count_ ||
+                coeff_mod_count > crt_modulus_count_)
             {
-                throw std::invalid_argument("destination cannot be null");
-            }
-            if (destination == value)
-            {
-                throw std::invalid_argument("value cannot be the same as destination");
+                throw std::invalid_argument("coeffd is too large");
             }
 #endif
-            if (coeff_mod_count == 1)
-            {
-                util::set_uint_uint(value, coeff_mod_count, destination);
-                return;
-            }
-
-            auto value_copy(util::allocate_uint(coeff_mod_count, pool));
             for (std::size_t j = 0; j < coeff_mod_count; j++)
             {
-                //destination[j] = util::modulo_uint(
-                //    value, coeff_mod_count, coeff_modulus_[j], pool);
-
-                // Manually inlined for efficiency
-                // Make a fresh copy of value
-                util::set_uint_uint(value, coeff_mod_count, value_copy.get());
-
-                // Starting from the top, reduce always 128-bit blocks
-                for (std::size_t k = coeff_mod_count - 1; k--; )
+                std::uint64_t modulus_value = coeff_modulus[j].value();
+                std::uint64_t residue = mantissa % modulus_value;
+                if (shift)
                 {
-                    value_copy[k] = util::barrett_reduce_128(
-                        value_copy.get() + k, coeff_modulus[j]);
+                    auto pow2_mod = pow2_mod_.get() +
+                        2 * (j * pow2_mod_count_ + static_cast<std::size_t>(shift));
+                    residue = multiply_uint_mod_shoup(residue, pow2_mod[0], pow2_mod[1],
+                        modulus_value);
                 }
-                destination[j] = value_copy[0];
+                destination[j * stride] = residue;
             }
         }
 
@@ -353,13 +569,118 @@ namespace seal
             }
 
             auto &context_data = *context_data_ptr;
+            verify_encode_parameters(context_data, scale);
+
             auto &parms = context_data.parms();
-            auto &coeff_modulus = parms.coeff_modulus();
-            std::size_t coeff_mod_count = coeff_modulus.size();
+            std::size_t coeff_mod_count = parms.coeff_modulus().size();
+            std::size_t coeff_count = parms.poly_modulus_degree();
+            auto &small_ntt_tables = context_data.small_ntt_tables();
+
+            // The slots and their conjugates in split form
+            auto conj_values = util::allocate<double>(2 * coeff_count, pool);
+            encode_vector(values.data(), values.size(), context_data, scale,
+                conj_values.get(), destination);
+
+            // Transform to NTT domain
+            for (std::size_t i = 0; i < coeff_mod_count; i++)
+            {
+                util::ntt_negacyclic_harvey(
+                    destination.data(i * coeff_count), small_ntt_tables[i]);
+            }
+
+            destination.parms_id() = parms_id;
+            destination.scale() = scale;
+        }
+
+        template<typename T,
+            typename = std::enable_if_t<std::is_same<T, double>::value ||
+            std::is_same<T, std::complex<double>>::value>>
+        void encode_batch_internal(const std::vector<T> &values_matrix,
+            std::size_t vector_size, parms_id_type parms_id, double scale,
+            std::vector<Plaintext> &destinations, ThreadPool *thread_pool,
+            MemoryPoolHandle pool)
+        {
+            // Verify parameters.
+            auto context_data_ptr = context_->context_data(parms_id);
+            if (!context_data_ptr)
+            {
+                throw std::invalid_argument("parms_id is not valid for encryption parameters");
+            }
+            if (vector_size == 0 || vector_size > slots_)
+            {
+                throw std::invalid_argument("vector_size is invalid");
+            }
+            if (values_matrix.size() % vector_size)
+            {
+                throw std::invalid_argument("values_matrix has invalid size");
+            }
+            if (!pool)
+            {
+                throw std::invalid_argument("pool is uninitialized");
+            }
+
+            auto &context_data = *context_data_ptr;
+            verify_encode_parameters(context_data, scale);
+
+            auto &parms = context_data.parms();
+            std::size_t coeff_mod_count = parms.coeff_modulus().size();
             std::size_t coeff_count = parms.poly_modulus_degree();
+            auto &small_ntt_tables = context_data.small_ntt_tables();
+
+            std::size_t vector_count = values_matrix.size() / vector_size;
+            destinations.resize(vector_count);
+
+            // Each block of vectors shares one scratch buffer, and the NTTs of a
+            // block are computed one prime at a time so that its tables are reused
+            // while they are in cache.
+            std::size_t block_count =
+                (vector_count + batch_block_size_ - 1) / batch_block_size_;
+            auto encode_block = [&](std::size_t block_index) {
+                std::size_t begin = block_index * batch_block_size_;
+                std::size_t end = std::min(begin + batch_block_size_, vector_count);
+
+                auto conj_values = util::allocate<double>(2 * coeff_count, pool);
+                for (std::size_t k = begin; k < end; k++)
+                {
+                    encode_vector(values_matrix.data() + k * vector_size, vector_size,
+                        context_data, scale, conj_values.get(), destinations[k]);
+                }
+                for (std::size_t i = 0; i < coeff_mod_count; i++)
+                {
+                    for (std::size_t k = begin; k < end; k++)
+                    {
+                        util::ntt_negacyclic_harvey(
+                            destinations[k].data(i * coeff_count), small_ntt_tables[i]);
+                    }
+                }
+                for (std::size_t k = begin; k < end; k++)
+                {
+                    destinations[k].parms_id() = parms_id;
+                    destinations[k].scale() = scale;
+                }
+            };
+
+            if (thread_pool)
+            {
+                thread_pool->parallel_for(block_count, encode_block);
+            }
+            else
+            {
+                for (std::size_t block_index = 0; block_index < block_count; block_index++)
+                {
+                    encode_block(block_index);
+                }
+            }
+        }
+
+        void verify_encode_parameters(const SEALContext::ContextData &context_data,
+            double scale)
+        {
+            auto &parms = context_data.parms();
 
             // Quick sanity check
-            if (!util::product_fits_in(coeff_mod_count, coeff_count))
+            if (!util::product_fits_in(parms.coeff_modulus().size(),
+                parms.poly_modulus_degree()))
             {
                 throw std::logic_error("invalid parameters");
             }
@@ -370,69 +691,64 @@ namespace seal
             {
                 throw std::invalid_argument("scale out of bounds");
             }
+        }
 
-            auto &small_ntt_tables = context_data.small_ntt_tables();
+        // Writes the coefficients of the encoding of values to destination, which is
+        // left in coefficient form. The scratch space conj_values must hold 2 * N
+        // doubles.
+        template<typename T,
+            typename = std::enable_if_t<std::is_same<T, double>::value ||
+            std::is_same<T, std::complex<double>>::value>>
+        void encode_vector(const T *values, std::size_t values_size,
+            const SEALContext::ContextData &context_data, double scale,
+            double *conj_values, Plaintext &destination)
+        {
+            auto &parms = context_data.parms();
+            auto &coeff_modulus = parms.coeff_modulus();
+            std::size_t coeff_mod_count = coeff_modulus.size();
+            std::size_t coeff_count = parms.poly_modulus_degree();
 
-            // input_size is guaranteed to be no bigger than slots_
-            std::size_t input_size = values.size();
+            // values_size is guaranteed to be no bigger than slots_
             std::size_t n = util::mul_safe(slots_, std::size_t(2));
 
-            auto conj_values = util::allocate<std::complex<double>>(n, pool, 0);
-            for (std::size_t i = 0; i < input_size; i++)
+            // The slots and their conjugates in split form
+            double *conj_values_real = conj_values;
+            double *conj_values_imag = conj_values_real + n;
+            std::fill_n(conj_values, 2 * n, 0.0);
+            for (std::size_t i = 0; i < values_size; i++)
             {
-                conj_values[matrix_reps_index_map_[i]] = values[i];
-                conj_values[matrix_reps_index_map_[i + slots_]] = std::conj(values[i]);
+                std::complex<double> value(values[i]);
+                conj_values_real[matrix_reps_index_map_[i]] = value.real();
+                conj_values_imag[matrix_reps_index_map_[i]] = value.imag();
+                conj_values_real[matrix_reps_index_map_[i + slots_]] = value.real();
+                conj_values_imag[matrix_reps_index_map_[i + slots_]] = -value.imag();
             }
 
             int logn = util::get_power_of_two(n);
-            std::size_t tt = 1;
-            for (int i = 0; i < logn; i++)
-            {
-                std::size_t mm = std::size_t(1) << (logn - i);
-                std::size_t k_start = 0;
-                std::size_t h = mm / 2;
-
-                for (std::size_t j = 0; j < h; j++)
-                {
-                    std::size_t k_end = k_start + tt;
-                    auto s = inv_roots_[h + j];
-
-                    for (std::size_t k = k_start; k < k_end; k++)
-                    {
-                        auto u = conj_values[k];
-                        auto v = conj_values[k + tt];
-                        conj_values[k] = u + v;
-                        conj_values[k + tt] = (u - v) * s;
-                    }
-
-                    k_start += 2 * tt;
-                }
-                tt *= 2;
-            }
+            util::inverse_fft_split(conj_values_real, conj_values_imag, logn,
+                inv_roots_.get(), inv_roots_.get() + n);
 
             double n_inv = double(1.0) / static_cast<double>(n);
-            
-            // Put the scale in at this point 
+
+            // Put the scale in at this point
             n_inv *= scale;
 
             int max_coeff_bit_count = 1;
             for (std::size_t i = 0; i < n; i++)
             {
-                // Multiply by scale and n_inv (see above)
-                conj_values[i] *= n_inv;
+                // Multiply by scale and n_inv (see above); only the real part is used
+                conj_values_real[i] *= n_inv;
 
                 // Verify that the values are not too large to fit in coeff_modulus
                 // Note that we have an extra + 1 for the sign bit
                 max_coeff_bit_count = std::max(max_coeff_bit_count,
-                    static_cast<int>(std::log2(std::fabs(conj_values[i].real()))) + 2);
+                    static_cast<int>(std::log2(std::fabs(conj_values_real[i]))) + 2);
             }
             if (max_coeff_bit_count >= context_data.total_coeff_modulus_bit_count())
             {
                 throw std::invalid_argument("encoded values are too large");
             }
 
-            double two_pow_64 = std::pow(2.0, 64);
-
             // Resize destination to appropriate size
             // Need to first set parms_id to zero, otherwise resize
             // will throw an exception.
@@ -444,10 +760,10 @@ namespace seal
             {
                 for (std::size_t i = 0; i < n; i++)
                 {
-                    double coeffd = std::round(conj_values[i].real());
+                    double coeffd = std::round(conj_values_real[i]);
                     bool is_negative = std::signbit(coeffd);
 
-                    std::uint64_t coeffu = 
+                    std::uint64_t coeffu =
                         static_cast<std::uint64_t>(std::fabs(coeffd));
 
                     if (is_negative)
@@ -462,128 +778,177 @@ namespace seal
                     {
                         for (std::size_t j = 0; j < coeff_mod_count; j++)
                         {
-                            destination[i + (j * coeff_count)] = 
+                            destination[i + (j * coeff_count)] =
                                 coeffu % coeff_modulus[j].value();
                         }
                     }
                 }
             }
-            else if (max_coeff_bit_count <= 128)
+            else
             {
+                // Larger coefficients are reduced through their exponent
                 for (std::size_t i = 0; i < n; i++)
                 {
-                    double coeffd = std::round(conj_values[i].real());
+                    double coeffd = std::round(conj_values_real[i]);
                     bool is_negative = std::signbit(coeffd);
                     coeffd = std::fabs(coeffd);
 
-                    std::uint64_t coeffu[2]{
-                        static_cast<std::uint64_t>(std::fmod(coeffd, two_pow_64)),
-                        static_cast<std::uint64_t>(coeffd / two_pow_64) };
+                    decompose_single_coeff(coeffd, coeff_mod_count, coeff_modulus,
+                        destination.data() + i, coeff_count);
 
+                    // Finally replace the sign if necessary
                     if (is_negative)
                     {
                         for (std::size_t j = 0; j < coeff_mod_count; j++)
                         {
-                            destination[i + (j * coeff_count)] = 
-                                util::negate_uint_mod(util::barrett_reduce_128(
-                                    coeffu, coeff_modulus[j]), coeff_modulus[j]);
-                        }
-                    }
-                    else
-                    {
-                        for (std::size_t j = 0; j < coeff_mod_count; j++)
-                        {
-                            destination[i + (j * coeff_count)] = 
-                                util::barrett_reduce_128(coeffu, coeff_modulus[j]);
+                            destination[i + (j * coeff_count)] = util::negate_uint_mod(
+                                destination[i + (j * coeff_count)], coeff_modulus[j]);
                         }
                     }
                 }
             }
-            else
-            {
-                // Slow case
-                auto coeffu(util::allocate_uint(coeff_mod_count, pool));
-                auto decomp_coeffu(util::allocate_uint(coeff_mod_count, pool));
-                for (std::size_t i = 0; i < n; i++)
-                {
-                    double coeffd = std::round(conj_values[i].real());
-                    bool is_negative = std::signbit(coeffd);
-                    coeffd = std::fabs(coeffd);
+        }
 
-                    // We are at this point guaranteed to fit in the allocated space
-                    util::set_zero_uint(coeff_mod_count, coeffu.get());
-                    auto coeffu_ptr = coeffu.get();
-                    while (coeffd >= 1)
-                    {
-                        *coeffu_ptr++ = static_cast<std::uint64_t>(
-                            std::fmod(coeffd, two_pow_64));
-                        coeffd /= two_pow_64;
-                    }
+        template<typename T,
+            typename = std::enable_if_t<std::is_same<T, double>::value ||
+            std::is_same<T, std::complex<double>>::value>>
+        void decode_internal(const Plaintext &plain, std::vector<T> &destination,
+            MemoryPoolHandle pool)
+        {
+            // Verify parameters.
+            if (!pool)
+            {
+                throw std::invalid_argument("pool is uninitialized");
+            }
+            auto &context_data = verify_decode_parameters(plain);
 
-                    // Next decompose this coefficient
-                    decompose_single_coeff(context_data, coeffu.get(), 
-                        decomp_coeffu.get(), pool);
+            auto &parms = context_data.parms();
+            std::size_t coeff_mod_count = parms.coeff_modulus().size();
+            std::size_t coeff_count = parms.poly_modulus_degree();
+            std::size_t rns_poly_uint64_count =
+                util::mul_safe(coeff_count, coeff_mod_count);
+            auto &small_ntt_tables = context_data.small_ntt_tables();
 
-                    // Finally replace the sign if necessary
-                    if (is_negative)
-                    {
-                        for (std::size_t j = 0; j < coeff_mod_count; j++)
-                        {
-                            destination[i + (j * coeff_count)] = 
-                                util::negate_uint_mod(decomp_coeffu[j], coeff_modulus[j]);
-                        }
-                    }
-                    else
-                    {
-                        for (std::size_t j = 0; j < coeff_mod_count; j++)
-                        {
-                            destination[i + (j * coeff_count)] = decomp_coeffu[j];
-                        }
-                    }
-                }
-            }
+            // Create mutable copy of input
+            auto plain_copy = util::allocate_uint(rns_poly_uint64_count, pool);
+            util::set_uint_uint(plain.data(), rns_poly_uint64_count, plain_copy.get());
 
-            // Transform to NTT domain
+            // Transform each polynomial from NTT domain
             for (std::size_t i = 0; i < coeff_mod_count; i++)
             {
-                util::ntt_negacyclic_harvey(
-                    destination.data(i * coeff_count), small_ntt_tables[i]);
+                util::inverse_ntt_negacyclic_harvey(
+                    plain_copy.get() + (i * coeff_count), small_ntt_tables[i]);
             }
 
-            destination.parms_id() = parms_id;
-            destination.scale() = scale;
+            // The mixed radix digits of a coefficient
+            auto digits = util::allocate<std::int64_t>(coeff_mod_count, pool);
+
+            // The coefficients are real; the slots are computed in split form
+            auto res = util::allocate<double>(2 * coeff_count, pool);
+
+            destination.resize(slots_);
+            decode_vector(plain_copy.get(), context_data, plain.scale(),
+                digits.get(), res.get(), destination.data());
         }
 
         template<typename T,
             typename = std::enable_if_t<std::is_same<T, double>::value ||
             std::is_same<T, std::complex<double>>::value>>
-        void decode_internal(const Plaintext &plain, std::vector<T> &destination, 
+        void decode_batch_internal(const std::vector<Plaintext> &plains,
+            std::vector<T> &destination, ThreadPool *thread_pool,
             MemoryPoolHandle pool)
         {
             // Verify parameters.
-            if (!plain.is_ntt_form())
-            {
-                throw std::invalid_argument("plain is not in NTT form");
-            }
             if (!pool)
             {
                 throw std::invalid_argument("pool is uninitialized");
             }
-
-            auto context_data_ptr = context_->context_data(plain.parms_id());
-            if (!context_data_ptr)
+            if (plains.empty())
             {
-                throw std::invalid_argument("parms_id is not valid for encryption parameters");
+                destination.clear();
+                return;
             }
+            for (auto &plain : plains)
+            {
+                if (plain.parms_id() != plains[0].parms_id())
+                {
+                    throw std::invalid_argument("plains have different parms_id");
+                }
+                verify_decode_parameters(plain);
+            }
+            auto &context_data = *context_->context_data(plains[0].parms_id());
 
-            auto &parms = context_data_ptr->parms();
-            auto &coeff_modulus = parms.coeff_modulus();
-            std::size_t coeff_mod_count = coeff_modulus.size();
+            auto &parms = context_data.parms();
+            std::size_t coeff_mod_count = parms.coeff_modulus().size();
             std::size_t coeff_count = parms.poly_modulus_degree();
-            std::size_t rns_poly_uint64_count = 
+            std::size_t rns_poly_uint64_count =
                 util::mul_safe(coeff_count, coeff_mod_count);
+            auto &small_ntt_tables = context_data.small_ntt_tables();
+
+            std::size_t vector_count = plains.size();
+            destination.resize(util::mul_safe(vector_count, slots_));
+
+            // As in encode_batch_internal, the inverse NTTs of a block of plaintexts
+            // are computed one prime at a time.
+            std::size_t block_count =
+                (vector_count + batch_block_size_ - 1) / batch_block_size_;
+            auto decode_block = [&](std::size_t block_index) {
+                std::size_t begin = block_index * batch_block_size_;
+                std::size_t end = std::min(begin + batch_block_size_, vector_count);
+
+                auto plain_copies = util::allocate_uint(
+                    util::mul_safe(end - begin, rns_poly_uint64_count), pool);
+                for (std::size_t k = begin; k < end; k++)
+                {
+                    util::set_uint_uint(plains[k].data(), rns_poly_uint64_count,
+                        plain_copies.get() + (k - begin) * rns_poly_uint64_count);
+                }
+                for (std::size_t i = 0; i < coeff_mod_count; i++)
+                {
+                    for (std::size_t k = begin; k < end; k++)
+                    {
+                        util::inverse_ntt_negacyclic_harvey(plain_copies.get() +
+                            (k - begin) * rns_poly_uint64_count + i * coeff_count,
+                            small_ntt_tables[i]);
+                    }
+                }
+
+                auto digits = util::allocate<std::int64_t>(coeff_mod_count, pool);
+                auto res = util::allocate<double>(2 * coeff_count, pool);
+                for (std::size_t k = begin; k < end; k++)
+                {
+                    decode_vector(
+                        plain_copies.get() + (k - begin) * rns_poly_uint64_count,
+                        context_data, plains[k].scale(), digits.get(), res.get(),
+                        destination.data() + k * slots_);
+                }
+            };
+
+            if (thread_pool)
+            {
+                thread_pool->parallel_for(block_count, decode_block);
+            }
+            else
+            {
+                for (std::size_t block_index = 0; block_index < block_count; block_index++)
+                {
+                    decode_block(block_index);
+                }
+            }
+        }
 
-            auto &small_ntt_tables = context_data_ptr->small_ntt_tables();
+        const SEALContext::ContextData &verify_decode_parameters(const Plaintext &plain)
+        {
+            if (!plain.is_ntt_form())
+            {
+                throw std::invalid_argument("plain is not in NTT form");
+            }
+
+            auto context_data_ptr = context_->context_data(plain.parms_id());
+            if (!context_data_ptr)
+            {
+                throw std::invalid_argument("parms_id is not valid for encryption parameters");
+            }
 
             // Check that scale is positive and not too large
             if (plain.scale() <= 0 || (static_cast<int>(log2(plain.scale())) >=
@@ -592,123 +957,92 @@ namespace seal
                 throw std::invalid_argument("scale out of bounds");
             }
 
-            auto decryption_modulus = context_data_ptr->total_coeff_modulus();
-            auto upper_half_threshold = context_data_ptr->upper_half_threshold();
-
-            auto &inv_coeff_products_mod_coeff_array =
-                context_data_ptr->base_converter()->get_inv_coeff_mod_coeff_array();
-            auto coeff_products_array =
-                context_data_ptr->base_converter()->get_coeff_products_array();
-
-            int logn = util::get_power_of_two(coeff_count);
-
             // Quick sanity check
+            std::size_t coeff_count = context_data_ptr->parms().poly_modulus_degree();
+            int logn = util::get_power_of_two(coeff_count);
             if ((logn < 0) || (coeff_count < SEAL_POLY_MOD_DEGREE_MIN) ||
                 (coeff_count > SEAL_POLY_MOD_DEGREE_MAX))
             {
                 throw std::logic_error("invalid parameters");
             }
+            return *context_data_ptr;
+        }
 
-            double inv_scale = double(1.0) / plain.scale();
-
-            // Create mutable copy of input
-            auto plain_copy = util::allocate_uint(rns_poly_uint64_count, pool);
-            util::set_uint_uint(plain.data(), rns_poly_uint64_count, plain_copy.get());
-
-            // Array to keep number bigger than std::uint64_t
-            auto temp(util::allocate_uint(coeff_mod_count, pool));
-
-            // destination mod q
-            auto wide_tmp_dest(util::allocate_zero_uint(rns_poly_uint64_count, pool));
-
-            // Transform each polynomial from NTT domain
-            for (std::size_t i = 0; i < coeff_mod_count; i++)
+        // Writes the slots of the plaintext with coefficients plain_coeffs (in
+        // coefficient form) to destination. The scratch space digits must hold k
+        // words and res 2 * N doubles.
+        template<typename T,
+            typename = std::enable_if_t<std::is_same<T, double>::value ||
+            std::is_same<T, std::complex<double>>::value>>
+        void decode_vector(const std::uint64_t *plain_coeffs,
+            const SEALContext::ContextData &context_data, double scale,
+            std::int64_t *digits, double *res, T *destination)
+        {
+            auto &parms = context_data.parms();
+            auto &coeff_modulus = parms.coeff_modulus();
+            std::size_t coeff_mod_count = coeff_modulus.size();
+            std::size_t coeff_count = parms.poly_modulus_degree();
+#ifdef SEAL_DEBUG
+            if (coeff_mod_count > crt_modulus_count_)
             {
-                util::inverse_ntt_negacyclic_harvey(
-                    plain_copy.get() + (i * coeff_count), small_ntt_tables[i]);
+                throw std::invalid_argument("coeff_modulus is too large");
             }
+#endif
+            int logn = util::get_power_of_two(coeff_count);
+            double inv_scale = double(1.0) / scale;
 
-            auto res = util::allocate<std::complex<double>>(coeff_count, pool);
+            double *res_real = res;
+            double *res_imag = res_real + coeff_count;
+            std::fill_n(res_imag, coeff_count, 0.0);
 
-            double two_pow_64 = std::pow(2.0, 64);
             for (std::size_t i = 0; i < coeff_count; i++)
             {
+                // Compute the digits of the coefficient, centered modulo the product
+                // q of the primes, in the mixed radix q_0, q_1, ... (Garner). Taking
+                // each digit in (-q_j/2, q_j/2) yields exactly the integers in
+                // (-q/2, q/2), so no multiprecision comparison with q/2 is needed.
                 for (std::size_t j = 0; j < coeff_mod_count; j++)
                 {
-                    std::uint64_t tmp = util::multiply_uint_uint_mod(
-                        plain_copy[(j * coeff_count) + i],
-                        inv_coeff_products_mod_coeff_array[j], // (qi/q * plain[i]) mod qi
-                        coeff_modulus[j]);
-                    util::multiply_uint_uint64(
-                        coeff_products_array + (j * coeff_mod_count),
-                        coeff_mod_count, tmp, coeff_mod_count, temp.get());
-                    util::add_uint_uint_mod(temp.get(),
-                        wide_tmp_dest.get() + (i * coeff_mod_count),
-                        decryption_modulus, coeff_mod_count,
-                        wide_tmp_dest.get() + (i * coeff_mod_count));
-                }
+                    std::uint64_t modulus_value = coeff_modulus[j].value();
 
-                double res_accum = 0.0;
-                if (util::is_greater_than_or_equal_uint_uint(
-                    wide_tmp_dest.get() + (i * coeff_mod_count),
-                    upper_half_threshold, coeff_mod_count))
-                {
-                    for (std::size_t j = 0; j < coeff_mod_count; j++)
+                    // A multiple of q_j larger than any |digits[l]|, so that the
+                    // differences below do not wrap around
+                    std::uint64_t offset = modulus_value <<
+                        (SEAL_USER_MOD_BIT_COUNT_MAX - coeff_modulus[j].bit_count());
+
+                    std::uint64_t digit = plain_coeffs[(j * coeff_count) + i];
+                    auto inv = garner_inv_.get() + 2 * j * crt_modulus_count_;
+                    for (std::size_t l = 0; l < j; l++, inv += 2)
                     {
-                        double diff = 0.0;
-                        if (wide_tmp_dest[i * coeff_mod_count + j] > decryption_modulus[j])
-                        {
-                            diff = static_cast<double>(wide_tmp_dest[i * coeff_mod_count + j]
-                                - decryption_modulus[j]);
-                        }
-                        else
-                        {
-                            diff = -static_cast<double>(decryption_modulus[j]
-                                - wide_tmp_dest[i * coeff_mod_count + j]);
-                        }
-                        res_accum += diff * pow(two_pow_64, j);
+                        // digit = (digit - digits[l]) * q_l^(-1) mod q_j
+                        digit = multiply_uint_mod_shoup(
+                            digit + offset - static_cast<std::uint64_t>(digits[l]),
+                            inv[0], inv[1], modulus_value);
                     }
+                    digits[j] = (digit > (modulus_value >> 1)) ?
+                        static_cast<std::int64_t>(digit - modulus_value) :
+                        static_cast<std::int64_t>(digit);
                 }
-                else
+
+                // Horner evaluation from the most significant digit
+                double res_accum = static_cast<double>(digits[coeff_mod_count - 1]);
+                for (std::size_t j = coeff_mod_count - 1; j--; )
                 {
-                    for (std::size_t j = 0; j < coeff_mod_count; j++)
-                    {
-                        res_accum += static_cast<double>(
-                            wide_tmp_dest[i * coeff_mod_count + j]) * pow(two_pow_64, j);
-                    }
+                    res_accum = res_accum * static_cast<double>(coeff_modulus[j].value())
+                        + static_cast<double>(digits[j]);
                 }
 
-                res[i] = res_accum * inv_scale;
+                res_real[i] = res_accum * inv_scale;
             }
 
-            std::size_t tt = coeff_count;
-            for (int i = 0; i < logn; i++)
-            {
-                std::size_t mm = std::size_t(1) << i;
-                tt >>= 1;
-
-                for (std::size_t j = 0; j < mm; j++)
-                {
-                    std::size_t j1 = 2 * j * tt;
-                    std::size_t j2 = j1 + tt - 1;
-                    auto s = roots_[mm + j];
-
-                    for (std::size_t k = j1; k < j2 + 1; k++)
-                    {
-                        auto u = res[k];
-                        auto v = res[k + tt] * s;
-                        res[k] = u + v;
-                        res[k + tt] = u - v;
-                    }
-                }
-            }
+            util::fft_split(res_real, res_imag, logn, roots_.get(),
+                roots_.get() + coeff_count);
 
-            destination.clear();
-            destination.reserve(slots_);
             for (std::size_t i = 0; i < slots_; i++)
             {
-                destination.emplace_back(
-                    from_complex<T>(res[matrix_reps_index_map_[i]]));
+                destination[i] = from_complex<T>(std::complex<double>(
+                    res_real[matrix_reps_index_map_[i]],
+                    res_imag[matrix_reps_index_map_[i]]));
             }
         }
 
@@ -730,16 +1064,36 @@ namespace seal
 
         static constexpr double PI_ = 3.14159265358979323846;
 
+        // The number of vectors encode_batch and decode_batch process together
+        static constexpr std::size_t batch_block_size_ = 8;
+
         static const double two_pow_64_;
 
         std::shared_ptr<SEALContext> context_{ nullptr };
 
         std::size_t slots_;
 
-        util::Pointer<std::complex<double>> roots_;
+        // Split form: the real parts followed by the imaginary parts
+        util::Pointer<double> roots_;
 
-        util::Pointer<std::complex<double>> inv_roots_;
+        util::Pointer<double> inv_roots_;
 
         util::Pointer<std::uint64_t> matrix_reps_index_map_;
+
+        // The number of primes in the first parameters; the primes of the other
+        // parameters in the chain are a prefix of these, so the tables below
+        // serve all of them.
+        std::size_t crt_modulus_count_;
+
+        // The number of powers of two in pow2_mod_ for each prime
+        std::size_t pow2_mod_count_;
+
+        // 2^e mod q_j and its quotient for multiply_uint_mod_shoup, at index
+        // 2 * (j * pow2_mod_count_ + e)
+        util::Pointer<std::uint64_t> pow2_mod_;
+
+        // q_l^(-1) mod q_j and its quotient for multiply_uint_mod_shoup, at index
+        // 2 * (j * crt_modulus_count_ + l) for l < j
+        util::Pointer<std::uint64_t> garner_inv_;
     };
 }
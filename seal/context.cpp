@@ -367,6 +367,13 @@ namespace seal
             }
         }
 
+        // The Galois permutation tables depend only on poly_modulus_degree
+        if (context_data_map_.at(first_parms_id_)->qualifiers_.parameters_set)
+        {
+            galois_tool_ = make_unique<GaloisTool>(get_power_of_two(
+                parms.poly_modulus_degree()), pool_);
+        }
+
         // Set the chain_index for each context_data
         size_t parms_count = context_data_map_.size();
         auto context_data_ptr = context_data_map_.at(first_parms_id_);
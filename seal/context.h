@@ -11,6 +11,7 @@
 #include "seal/util/smallntt.h"
 #include "seal/util/baseconverter.h"
 #include "seal/util/pointer.h"
+#include "seal/util/galois.h"
 
 namespace seal
 {
@@ -379,6 +380,17 @@ namespace seal
             return last_parms_id_;
         }
 
+        /**
+        Returns the cache of the permutation tables that Evaluator and KeyGenerator
+        use to apply Galois automorphisms to polynomials in NTT form. The tables are
+        shared by all parameter sets in the modulus switching chain. Returns nullptr
+        if the encryption parameters are not valid.
+        */
+        inline const util::GaloisTool *galois_tool() const noexcept
+        {
+            return galois_tool_.get();
+        }
+
     private:
         SEALContext(const SEALContext &copy) = delete;
 
@@ -411,5 +423,7 @@ namespace seal
 
         std::unordered_map<
             parms_id_type, std::shared_ptr<const ContextData>> context_data_map_{};
+
+        std::unique_ptr<util::GaloisTool> galois_tool_{ nullptr };
     };
 }
@@ -81,10 +81,8 @@ namespace seal
     void Decryptor::bfv_decrypt(const Ciphertext &encrypted, 
         Plaintext &destination, MemoryPoolHandle pool)
     {
-        if (encrypted.is_ntt_form())
-        {
-            throw invalid_argument("encrypted cannot be in NTT form");
-        }
+        // A ciphertext left in NTT form by Evaluator skips the forward transforms
+        bool is_ntt_form = encrypted.is_ntt_form();
 
         auto &context_data = *context_->context_data(encrypted.parms_id());
         auto &parms = context_data.parms();
@@ -139,7 +137,10 @@ namespace seal
                 set_uint_uint(current_array1, coeff_count, copy_operand1.get());
 
                 // Lazy reduction
-                ntt_negacyclic_harvey_lazy(copy_operand1.get(), small_ntt_tables[i]);
+                if (!is_ntt_form)
+                {
+                    ntt_negacyclic_harvey_lazy(copy_operand1.get(), small_ntt_tables[i]);
+                }
 
                 dyadic_product_coeffmod(copy_operand1.get(), current_array2, coeff_count,
                     coeff_modulus[i], copy_operand1.get());
@@ -151,6 +152,14 @@ namespace seal
                 current_array2 += first_rns_poly_uint64_count;
             }
 
+            // In NTT form c_0 is added before the inverse NTT
+            if (is_ntt_form)
+            {
+                add_poly_poly_coeffmod(tmp_dest_modq.get() + (i * coeff_count),
+                    encrypted.data() + (i * coeff_count), coeff_count, coeff_modulus[i],
+                    tmp_dest_modq.get() + (i * coeff_count));
+            }
+
             // Perform inverse NTT
             inverse_ntt_negacyclic_harvey(tmp_dest_modq.get() + (i * coeff_count),
                 small_ntt_tables[i]);
@@ -164,9 +173,12 @@ namespace seal
             //  tmp_dest_modq.get() + (i * coeff_count));
 
             // Lazy reduction
-            for (size_t j = 0; j < coeff_count; j++)
+            if (!is_ntt_form)
             {
-                tmp_dest_modq[j + (i * coeff_count)] += encrypted[j + (i * coeff_count)];
+                for (size_t j = 0; j < coeff_count; j++)
+                {
+                    tmp_dest_modq[j + (i * coeff_count)] += encrypted[j + (i * coeff_count)];
+                }
             }
 
             // Compute |gamma * plain|qi * ct(s)
@@ -451,10 +463,7 @@ namespace seal
         {
             throw invalid_argument("encrypted is not valid for encryption parameters");
         }
-        if (encrypted.is_ntt_form())
-        {
-            throw invalid_argument("encrypted cannot be in NTT form");
-        }
+        bool is_ntt_form = encrypted.is_ntt_form();
 
         auto &context_data = *context_data_ptr;
         auto &parms = context_data.parms();
@@ -506,7 +515,10 @@ namespace seal
                 set_uint_uint(current_array1, coeff_count, copy_operand1.get());
 
                 // Lazy reduction
-                ntt_negacyclic_harvey_lazy(copy_operand1.get(), small_ntt_tables[i]);
+                if (!is_ntt_form)
+                {
+                    ntt_negacyclic_harvey_lazy(copy_operand1.get(), small_ntt_tables[i]);
+                }
 
                 dyadic_product_coeffmod(copy_operand1.get(), current_array2, coeff_count,
                     coeff_modulus[i], copy_operand1.get());
@@ -519,6 +531,14 @@ namespace seal
                 current_array2 += rns_poly_uint64_count;
             }
 
+            // In NTT form c_0 is added before the inverse NTT
+            if (is_ntt_form)
+            {
+                add_poly_poly_coeffmod(noise_poly.get() + (i * coeff_count),
+                    encrypted.data() + (i * coeff_count), coeff_count, coeff_modulus[i],
+                    noise_poly.get() + (i * coeff_count));
+            }
+
             // Perform inverse NTT
             inverse_ntt_negacyclic_harvey(noise_poly.get() + (i * coeff_count),
                 small_ntt_tables[i]);
@@ -527,9 +547,12 @@ namespace seal
         for (size_t i = 0; i < coeff_mod_count; i++)
         {
             // add c_0 into noise_poly
-            add_poly_poly_coeffmod(noise_poly.get() + (i * coeff_count),
-                encrypted.data() + (i * coeff_count), coeff_count, coeff_modulus[i],
-                noise_poly.get() + (i * coeff_count));
+            if (!is_ntt_form)
+            {
+                add_poly_poly_coeffmod(noise_poly.get() + (i * coeff_count),
+                    encrypted.data() + (i * coeff_count), coeff_count, coeff_modulus[i],
+                    noise_poly.get() + (i * coeff_count));
+            }
 
             // Multiply by parms.plain_modulus() and reduce mod parms.coeff_modulus() to get
             // parms.coeff_modulus()*noise
@@ -44,7 +44,8 @@ namespace seal
     ciphertexts should remain by default in NTT form. We call these scheme-specific 
     NTT states the "default NTT form". Decryption requires the input ciphertexts 
     to be in the default NTT form, and will throw an exception if this is not the 
-    case.
+    case, except that BFV ciphertexts in NTT form, as left by Evaluator
+    with lazy NTT form tracking enabled, are decrypted directly.
     */
     class Decryptor
     {
@@ -91,7 +92,6 @@ namespace seal
         @param[in] encrypted The ciphertext
         @throws std::invalid_argument if the scheme is not BFV
         @throws std::invalid_argument if encrypted is not valid for the encryption parameters
-        @throws std::invalid_argument if encrypted is in NTT form
         */
         int invariant_noise_budget(const Ciphertext &encrypted);
 
@@ -2,6 +2,7 @@
 // Licensed under the MIT license.
 
 #include "seal/encryptionparams.h"
+#include "seal/util/streambuf.h"
 #include <limits>
 
 using namespace std;
@@ -39,6 +40,31 @@ namespace seal
         }
     }
 
+    size_t EncryptionParameters::SaveSize(const EncryptionParameters &parms)
+    {
+        // Scheme, poly_modulus_degree, coeff_modulus size, coeff_modulus primes,
+        // plain_modulus, and noise_standard_deviation
+        return add_safe(sizeof(scheme_type) + 2 * sizeof(uint64_t),
+            mul_safe(parms.coeff_modulus().size(), sizeof(uint64_t)),
+            sizeof(uint64_t) + sizeof(double));
+    }
+
+    size_t EncryptionParameters::Save(const EncryptionParameters &parms,
+        void *destination, size_t size)
+    {
+        ArrayPutBuffer apbuf(destination, size);
+        ostream stream(&apbuf);
+        Save(parms, stream);
+        return apbuf.size();
+    }
+
+    EncryptionParameters EncryptionParameters::Load(const void *source, size_t size)
+    {
+        ArrayGetBuffer agbuf(source, size);
+        istream stream(&agbuf);
+        return Load(stream);
+    }
+
     EncryptionParameters EncryptionParameters::Load(istream &stream)
     {
         // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
@@ -372,6 +372,38 @@ namespace seal
         */
         static EncryptionParameters Load(std::istream &stream);
 
+        /**
+        Returns the exact number of bytes Save writes for given EncryptionParameters.
+
+        @param[in] parms The EncryptionParameters to save
+        */
+        static std::size_t SaveSize(const EncryptionParameters &parms);
+
+        /**
+        Saves EncryptionParameters directly into a caller-owned buffer, which must
+        have room for at least SaveSize(parms) bytes. Returns the number of bytes
+        written.
+
+        @param[in] parms The EncryptionParameters to save
+        @param[out] destination The buffer to save the EncryptionParameters to
+        @param[in] size The size of the buffer in bytes
+        @throws std::invalid_argument if destination is null and size is non-zero
+        @throws std::exception if the EncryptionParameters do not fit in the buffer
+        */
+        static std::size_t Save(const EncryptionParameters &parms, 
+            void *destination, std::size_t size);
+
+        /**
+        Loads EncryptionParameters directly from a caller-owned buffer.
+
+        @param[in] source The buffer to load the EncryptionParameters from
+        @param[in] size The size of the buffer in bytes
+        @throws std::invalid_argument if source is null and size is non-zero
+        @throws std::exception if valid EncryptionParameters could not be read 
+        from source
+        */
+        static EncryptionParameters Load(const void *source, std::size_t size);
+
     private:
         void compute_parms_id();
 
@@ -20,10 +20,114 @@ namespace seal
     namespace
     {
         template<typename T, typename S>
-        bool are_same_scale(T value1, S value2)
+        bool are_same_scale(const T &value1, const S &value2)
         {
             return util::are_close<double>(value1.scale(), value2.scale());
         }
+
+        // Lifts a plaintext value, reduced modulo the plaintext modulus, to the j-th
+        // prime of the coefficient modulus. As in transform_to_ntt_inplace, values
+        // in the upper half represent negative numbers.
+        inline uint64_t lift_plain_scalar(uint64_t value,
+            const SEALContext::ContextData &context_data, size_t j)
+        {
+            auto &parms = context_data.parms();
+            auto &modulus = parms.coeff_modulus()[j];
+            if (value >= context_data.plain_upper_half_threshold())
+            {
+                uint64_t plain_modulus = parms.plain_modulus().value();
+                return negate_uint_mod((plain_modulus - value) % modulus.value(), modulus);
+            }
+            return value % modulus.value();
+        }
+
+        // Decides whether multiply_plain should use negacyclic shifts instead of
+        // NTTs. Each nonzero coefficient costs one pass over the ciphertext, and
+        // the passes for the coefficients 1 and -1 need no multiplications. They
+        // are weighted accordingly against the NTT path, which costs about log2(N)
+        // multiplying passes.
+        bool is_sparse_plain(const Plaintext &plain, size_t plain_coeff_count,
+            size_t coeff_count, uint64_t plain_modulus)
+        {
+            size_t max_cost = 4 * static_cast<size_t>(get_power_of_two(coeff_count));
+            size_t cost = 0;
+            for (size_t k = 0; k < plain_coeff_count; k++)
+            {
+                if (plain[k] == 1 || plain[k] == plain_modulus - 1)
+                {
+                    cost++;
+                }
+                else if (plain[k])
+                {
+                    cost += 4;
+                }
+                if (cost > max_cost)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Adds scalar * x^shift * operand to result in Z_q[x]/(x^N+1); shift < N.
+        // The scalars 1 and q-1 (the nonzero digits of IntegerEncoder) need no
+        // multiplication.
+        inline void negacyclic_multiply_add_monomial(const uint64_t *operand,
+            size_t coeff_count, size_t shift, uint64_t scalar,
+            const SmallModulus &modulus, uint64_t *result)
+        {
+            uint64_t modulus_value = modulus.value();
+            size_t wrap = coeff_count - shift;
+            if (scalar == 1)
+            {
+                add_poly_poly_coeffmod(result + shift, operand, wrap, modulus, 
+                    result + shift);
+                sub_poly_poly_coeffmod(result, operand + wrap, shift, modulus, result);
+            }
+            else if (scalar == modulus_value - 1)
+            {
+                sub_poly_poly_coeffmod(result + shift, operand, wrap, modulus,
+                    result + shift);
+                add_poly_poly_coeffmod(result, operand + wrap, shift, modulus, result);
+            }
+            else
+            {
+                // Multiply with the precomputed quotient floor(scalar * 2^64 / q), as
+                // in the NTT butterflies; the products are then at most 2q.
+                uint64_t wide_quotient[2]{ 0, 0 };
+                uint64_t wide_scalar[2]{ 0, scalar };
+                divide_uint128_uint64_inplace(wide_scalar, modulus_value, wide_quotient);
+                uint64_t scalar_prime = wide_quotient[0];
+                auto multiply = [&](uint64_t value) {
+                    unsigned long long quotient;
+                    multiply_uint64_hw64(scalar_prime, value, &quotient);
+                    uint64_t product = value * scalar - quotient * modulus_value;
+                    return product - (modulus_value & static_cast<uint64_t>(
+                        -static_cast<int64_t>(product >= modulus_value)));
+                };
+                for (size_t i = 0; i < wrap; i++)
+                {
+                    result[i + shift] = add_uint_uint_mod(result[i + shift],
+                        multiply(operand[i]), modulus);
+                }
+                for (size_t i = wrap; i < coeff_count; i++)
+                {
+                    result[i - wrap] = sub_uint_uint_mod(result[i - wrap],
+                        multiply(operand[i]), modulus);
+                }
+            }
+        }
+
+        // Reduces coeff_count 128-bit lazy reduction accumulators in place
+        inline void reduce_wide_accumulator(uint64_t *wide_accumulator,
+            size_t coeff_count, const SmallModulus &modulus)
+        {
+            for (size_t i = 0; i < coeff_count; i++, wide_accumulator += 2)
+            {
+                wide_accumulator[0] = barrett_reduce_128(wide_accumulator, modulus);
+                wide_accumulator[1] = 0;
+            }
+        }
     }
 
     Evaluator::Evaluator(shared_ptr<SEALContext> context) : context_(move(context))
@@ -101,7 +205,24 @@ namespace seal
         }
         if (encrypted1.is_ntt_form() != encrypted2.is_ntt_form())
         {
-            throw invalid_argument("NTT form mismatch");
+            if (!lazy_ntt_form_ ||
+                context_data_ptr->parms().scheme() != scheme_type::BFV)
+            {
+                throw invalid_argument("NTT form mismatch");
+            }
+
+            // Tracked BFV ciphertexts meet in NTT form
+            if (!encrypted1.is_ntt_form())
+            {
+                transform_to_ntt_inplace(encrypted1);
+            }
+            else
+            {
+                Ciphertext encrypted2_ntt;
+                transform_to_ntt(encrypted2, encrypted2_ntt);
+                add_inplace(encrypted1, encrypted2_ntt);
+                return;
+            }
         }
         if (!are_same_scale(encrypted1, encrypted2))
         {
@@ -182,7 +303,24 @@ namespace seal
         }
         if (encrypted1.is_ntt_form() != encrypted2.is_ntt_form())
         {
-            throw invalid_argument("NTT form mismatch");
+            if (!lazy_ntt_form_ ||
+                context_data_ptr->parms().scheme() != scheme_type::BFV)
+            {
+                throw invalid_argument("NTT form mismatch");
+            }
+
+            // Tracked BFV ciphertexts meet in NTT form
+            if (!encrypted1.is_ntt_form())
+            {
+                transform_to_ntt_inplace(encrypted1);
+            }
+            else
+            {
+                Ciphertext encrypted2_ntt;
+                transform_to_ntt(encrypted2, encrypted2_ntt);
+                sub_inplace(encrypted1, encrypted2_ntt);
+                return;
+            }
         }
         if (!are_same_scale(encrypted1, encrypted2))
         {
@@ -249,6 +387,14 @@ namespace seal
         switch (context_data_ptr->parms().scheme())
         {
         case scheme_type::BFV:
+            restore_coeff_form(encrypted1);
+            if (lazy_ntt_form_ && encrypted2.is_ntt_form())
+            {
+                Ciphertext encrypted2_coeff(pool);
+                transform_from_ntt(encrypted2, encrypted2_coeff);
+                bfv_multiply(encrypted1, encrypted2_coeff, pool);
+                return;
+            }
             bfv_multiply(encrypted1, encrypted2, pool);
             return;
 
@@ -356,8 +502,6 @@ namespace seal
         // one for result in base Bsk
         auto tmp1_poly_coeff_base(allocate_poly(coeff_count, coeff_mod_count, pool));
         auto tmp1_poly_bsk_base(allocate_poly(coeff_count, bsk_base_mod_count, pool));
-        auto tmp2_poly_coeff_base(allocate_poly(coeff_count, coeff_mod_count, pool));
-        auto tmp2_poly_bsk_base(allocate_poly(coeff_count, bsk_base_mod_count, pool));
 
         size_t current_encrypted1_limit = 0;
 
@@ -417,157 +561,34 @@ namespace seal
         // Perform Karatsuba multiplication on size 2 ciphertexts
         if (encrypted1_size == 2 && encrypted2_size == 2)
         {
-            auto tmp_first_mul_coeff_base(allocate_poly(coeff_count, coeff_mod_count, pool));
-
-            // Compute c0 + c1 and c0*d0 in base q
-            uint64_t *temp_ptr_1 = tmp1_poly_coeff_base.get();
-            uint64_t *temp_ptr_2 = copy_encrypted1_ntt_coeff_mod.get();
-            uint64_t *temp_ptr_3 = temp_ptr_2 + encrypted_ptr_increment;
+            // Compute Des[0] = c0*d0, Des[1] = (c0 + c1)*(d0 + d1) - c0*d0 - c1*d1 and
+            // Des[2] = c1*d1 in one pass with lazy reduction; the unreduced outputs of
+            // the lazy NTT are used as they are
             for (size_t i = 0; i < coeff_mod_count; i++)
             {
-                //add_poly_poly_coeffmod(copy_encrypted1_ntt_coeff_mod.get() + (i * coeff_count),
-                //    copy_encrypted1_ntt_coeff_mod.get() + (i * coeff_count) + encrypted_ptr_increment,
-                //    coeff_count, coeff_modulus_[i], tmp1_poly_coeff_base.get() + (i * coeff_count));
-
-                // Lazy reduction
-                for (size_t j = 0; j < coeff_count; j++)
-                {
-                    *temp_ptr_1++ = *temp_ptr_2++ + *temp_ptr_3++;
-                }
-                dyadic_product_coeffmod(
+                dyadic_product_karatsuba_coeffmod(
                     copy_encrypted1_ntt_coeff_mod.get() + (i * coeff_count),
+                    copy_encrypted1_ntt_coeff_mod.get() + (i * coeff_count) + encrypted_ptr_increment,
                     copy_encrypted2_ntt_coeff_mod.get() + (i * coeff_count),
+                    copy_encrypted2_ntt_coeff_mod.get() + (i * coeff_count) + encrypted_ptr_increment,
                     coeff_count, coeff_modulus[i],
-                    tmp_first_mul_coeff_base.get() + (i * coeff_count));
+                    tmp_des_coeff_base.get() + (i * coeff_count),
+                    tmp_des_coeff_base.get() + (i * coeff_count) + encrypted_ptr_increment,
+                    tmp_des_coeff_base.get() + (i * coeff_count) + 2 * encrypted_ptr_increment);
             }
 
-            auto tmp_first_mul_bsk_base(allocate_poly(coeff_count, bsk_base_mod_count, pool));
-
-            // Compute c0 + c1 and c0*d0 in base bsk
-            temp_ptr_1 = tmp1_poly_bsk_base.get();
-            temp_ptr_2 = copy_encrypted1_ntt_bsk_base_mod.get();
-            temp_ptr_3 = temp_ptr_2 + encrypted_bsk_ptr_increment;
+            // Same in base bsk
             for (size_t i = 0; i < bsk_base_mod_count; i++)
             {
-                //add_poly_poly_coeffmod(copy_encrypted1_ntt_bsk_base_mod.get() + (i * coeff_count),
-                //    copy_encrypted1_ntt_bsk_base_mod.get() + (i * coeff_count) + encrypted_bsk_ptr_increment,
-                //    coeff_count, bsk_mod_array_[i], tmp1_poly_bsk_base.get() + (i * coeff_count));
-                for (size_t j = 0; j < coeff_count; j++)
-                {
-                    *temp_ptr_1++ = *temp_ptr_2++ + *temp_ptr_3++;
-                }
-                dyadic_product_coeffmod(
+                dyadic_product_karatsuba_coeffmod(
                     copy_encrypted1_ntt_bsk_base_mod.get() + (i * coeff_count),
-                    copy_encrypted2_ntt_bsk_base_mod.get() + (i * coeff_count),
-                    coeff_count, bsk_modulus[i],
-                    tmp_first_mul_bsk_base.get() + (i * coeff_count));
-            }
-
-            auto tmp_second_mul_coeff_base(allocate_poly(coeff_count, coeff_mod_count, pool));
-
-            // Compute d0 + d1 and c1*d1 in base q
-            temp_ptr_1 = tmp2_poly_coeff_base.get();
-            temp_ptr_2 = copy_encrypted2_ntt_coeff_mod.get();
-            temp_ptr_3 = temp_ptr_2 + encrypted_ptr_increment;
-            for (size_t i = 0; i < coeff_mod_count; i++)
-            {
-                //add_poly_poly_coeffmod(copy_encrypted2_ntt_coeff_mod.get() + (i * coeff_count),
-                //    copy_encrypted2_ntt_coeff_mod.get() + (i * coeff_count) + encrypted_ptr_increment,
-                //    coeff_count, coeff_modulus_[i], tmp2_poly_coeff_base.get() + (i * coeff_count));
-                for (size_t j = 0; j < coeff_count; j++)
-                {
-                    *temp_ptr_1++ = *temp_ptr_2++ + *temp_ptr_3++;
-                }
-                dyadic_product_coeffmod(
-                    copy_encrypted1_ntt_coeff_mod.get() + (i * coeff_count) + encrypted_ptr_increment,
-                    copy_encrypted2_ntt_coeff_mod.get() + (i * coeff_count) + encrypted_ptr_increment,
-                    coeff_count, coeff_modulus[i], tmp_second_mul_coeff_base.get() + (i * coeff_count));
-            }
-
-            auto tmp_second_mul_bsk_base(allocate_poly(coeff_count, bsk_base_mod_count, pool));
-
-            // Compute d0 + d1 and c1*d1 in base bsk
-            temp_ptr_1 = tmp2_poly_bsk_base.get();
-            temp_ptr_2 = copy_encrypted2_ntt_bsk_base_mod.get();
-            temp_ptr_3 = temp_ptr_2 + encrypted_bsk_ptr_increment;
-            for (size_t i = 0; i < bsk_base_mod_count; i++)
-            {
-                //add_poly_poly_coeffmod(copy_encrypted2_ntt_bsk_base_mod.get() + (i * coeff_count),
-                //    copy_encrypted2_ntt_bsk_base_mod.get() + (i * coeff_count) + encrypted_bsk_ptr_increment,
-                //    coeff_count, bsk_mod_array_[i], tmp2_poly_bsk_base.get() + (i * coeff_count));
-                for (size_t j = 0; j < coeff_count; j++)
-                {
-                    *temp_ptr_1++ = *temp_ptr_2++ + *temp_ptr_3++;
-                }
-                dyadic_product_coeffmod(
                     copy_encrypted1_ntt_bsk_base_mod.get() + (i * coeff_count) + encrypted_bsk_ptr_increment,
+                    copy_encrypted2_ntt_bsk_base_mod.get() + (i * coeff_count),
                     copy_encrypted2_ntt_bsk_base_mod.get() + (i * coeff_count) + encrypted_bsk_ptr_increment,
-                    coeff_count, bsk_modulus[i], tmp_second_mul_bsk_base.get() + (i * coeff_count));
-            }
-
-            auto tmp_mul_poly_coeff_base(allocate_poly(coeff_count, coeff_mod_count, pool));
-            auto tmp_mul_poly_bsk_base(allocate_poly(coeff_count, bsk_base_mod_count, pool));
-
-            // Set destination first and third polys in base q
-            // Des[0] in base q
-            set_poly_poly(tmp_first_mul_coeff_base.get(), coeff_count,
-                coeff_mod_count, tmp_des_coeff_base.get());
-
-            // Des[2] in base q
-            set_poly_poly(tmp_second_mul_coeff_base.get(), coeff_count,
-                coeff_mod_count, tmp_des_coeff_base.get() + 2 * encrypted_ptr_increment);
-
-            // Compute (c0 + c1)*(d0 + d1) - c0*d0 - c1*d1 in base q
-            for (size_t i = 0; i < coeff_mod_count; i++)
-            {
-                dyadic_product_coeffmod(
-                    tmp1_poly_coeff_base.get() + (i * coeff_count),
-                    tmp2_poly_coeff_base.get() + (i * coeff_count),
-                    coeff_count, coeff_modulus[i],
-                    tmp_mul_poly_coeff_base.get() + (i * coeff_count));
-                sub_poly_poly_coeffmod(
-                    tmp_mul_poly_coeff_base.get() + (i * coeff_count),
-                    tmp_first_mul_coeff_base.get() + (i * coeff_count),
-                    coeff_count, coeff_modulus[i],
-                    tmp_mul_poly_coeff_base.get() + (i * coeff_count));
-
-                // Des[1] in base q
-                sub_poly_poly_coeffmod(
-                    tmp_mul_poly_coeff_base.get() + (i * coeff_count),
-                    tmp_second_mul_coeff_base.get() + (i * coeff_count),
-                    coeff_count, coeff_modulus[i],
-                    tmp_des_coeff_base.get() + (i * coeff_count) + encrypted_ptr_increment);
-            }
-
-            // Set destination first and third polys in base bsk
-            // Des[0] in base bsk
-            set_poly_poly(tmp_first_mul_bsk_base.get(), coeff_count,
-                bsk_base_mod_count, tmp_des_bsk_base.get());
-
-            // Des[2] in base q
-            set_poly_poly(tmp_second_mul_bsk_base.get(), coeff_count, bsk_base_mod_count,
-                tmp_des_bsk_base.get() + 2 * encrypted_bsk_ptr_increment);
-
-            // Compute (c0 + c1)*(d0 + d1)  - c0d0 - c1d1 in base bsk
-            for (size_t i = 0; i < bsk_base_mod_count; i++)
-            {
-                dyadic_product_coeffmod(
-                    tmp1_poly_bsk_base.get() + (i * coeff_count),
-                    tmp2_poly_bsk_base.get() + (i * coeff_count),
-                    coeff_count, bsk_modulus[i],
-                    tmp_mul_poly_bsk_base.get() + (i * coeff_count));
-                sub_poly_poly_coeffmod(
-                    tmp_mul_poly_bsk_base.get() + (i * coeff_count),
-                    tmp_first_mul_bsk_base.get() + (i * coeff_count),
-                    coeff_count, bsk_modulus[i],
-                    tmp_mul_poly_bsk_base.get() + (i * coeff_count));
-
-                // Des[1] in bsk
-                sub_poly_poly_coeffmod(
-                    tmp_mul_poly_bsk_base.get() + (i * coeff_count),
-                    tmp_second_mul_bsk_base.get() + (i * coeff_count),
                     coeff_count, bsk_modulus[i],
-                    tmp_des_bsk_base.get() + (i * coeff_count) + encrypted_bsk_ptr_increment);
+                    tmp_des_bsk_base.get() + (i * coeff_count),
+                    tmp_des_bsk_base.get() + (i * coeff_count) + encrypted_bsk_ptr_increment,
+                    tmp_des_bsk_base.get() + (i * coeff_count) + 2 * encrypted_bsk_ptr_increment);
             }
         }
         else
@@ -745,7 +766,6 @@ namespace seal
 
         //Allocate tmp polys for NTT multiplication results in base q
         auto tmp1_poly(allocate_poly(coeff_count, coeff_mod_count, pool));
-        auto tmp2_poly(allocate_poly(coeff_count, coeff_mod_count, pool));
 
         // First convert all the inputs into NTT form
         auto copy_encrypted1_ntt(allocate_poly(
@@ -761,86 +781,19 @@ namespace seal
         // Perform Karatsuba multiplication on size 2 ciphertexts
         if (encrypted1_size == 2 && encrypted2_size == 2)
         {
-            //Compute c0 + c1 and c0*d0 modulo q
-            //tmp poly to keep c0 * d0
-            auto tmp_first_mul(allocate_poly(coeff_count, coeff_mod_count, pool));
-
-            uint64_t *temp_ptr_1 = tmp1_poly.get(); //pointer to the result of c0 + c1 in NTT
-            uint64_t *temp_ptr_2 = copy_encrypted1_ntt.get(); //Pointer to NTT version of c0
-            uint64_t *temp_ptr_3 = temp_ptr_2 + encrypted_ptr_increment; //Pointer to NTT version of c1
-
+            // Compute Des[0] = c0*d0, Des[1] = (c0 + c1)*(d0 + d1) - c0*d0 - c1*d1 and
+            // Des[2] = c1*d1 in one pass with lazy reduction
             for (size_t i = 0; i < coeff_mod_count; i++)
             {
-                //Lazy reduction (c0 + c1)
-                for (size_t j = 0; j < coeff_count; j++)
-                {
-                    *temp_ptr_1++ = *temp_ptr_2++ + *temp_ptr_3++;
-                }
-                //c0 * d0 in NTT
-                dyadic_product_coeffmod(
+                dyadic_product_karatsuba_coeffmod(
                     copy_encrypted1_ntt.get() + (i * coeff_count),
-                    copy_encrypted2_ntt.get() + (i * coeff_count),
-                    coeff_count, coeff_modulus[i],
-                    tmp_first_mul.get() + (i * coeff_count));
-            }
-
-            //Compute d0 + d1 and c1 * d1 modulo q
-            //tmp poly to keep c1 * d1
-            auto tmp_second_mul(allocate_poly(coeff_count, coeff_mod_count, pool));
-
-            // Compute d0 + d1 and c1*d1 in base q
-            temp_ptr_1 = tmp2_poly.get(); //Pointer to the result of d0 + d1
-            temp_ptr_2 = copy_encrypted2_ntt.get(); //Pointer to d0
-            temp_ptr_3 = temp_ptr_2 + encrypted_ptr_increment; //Pointer to d1
-
-            for (size_t i = 0; i < coeff_mod_count; i++)
-            {
-                //Lazy reduction (d0 + d1)
-                for (size_t j = 0; j < coeff_count; j++)
-                {
-                    *temp_ptr_1++ = *temp_ptr_2++ + *temp_ptr_3++;
-                }
-
-                //c1 * d1 in NTT
-                dyadic_product_coeffmod(
                     copy_encrypted1_ntt.get() + (i * coeff_count) + encrypted_ptr_increment,
+                    copy_encrypted2_ntt.get() + (i * coeff_count),
                     copy_encrypted2_ntt.get() + (i * coeff_count) + encrypted_ptr_increment,
-                    coeff_count, coeff_modulus[i], tmp_second_mul.get() + (i * coeff_count));
-            }
-
-            // Set destination of the first and third polys in base q
-            // Des[0] in base q
-            set_poly_poly(tmp_first_mul.get(), coeff_count,
-                coeff_mod_count, tmp_des.get());
-
-            // Des[2] in base q
-            set_poly_poly(tmp_second_mul.get(), coeff_count,
-                coeff_mod_count, tmp_des.get() + 2 * encrypted_ptr_increment);
-
-            // Compute (c0 + c1) * (d0 + d1) - c0 * d0 - c1 * d1 modulo q
-            auto tmp_mul_poly(allocate_poly(coeff_count, coeff_mod_count, pool));
-
-            for (size_t i = 0; i < coeff_mod_count; i++)
-            {
-                // (c0 + c1) * (d0 + d1) in NTT
-                dyadic_product_coeffmod(
-                    tmp1_poly.get() + (i * coeff_count),
-                    tmp2_poly.get() + (i * coeff_count),
-                    coeff_count, coeff_modulus[i],
-                    tmp_mul_poly.get() + (i * coeff_count));
-                // (c0 + c1) * (d0 + d1) - c0 * d0 in NTT
-                sub_poly_poly_coeffmod(
-                    tmp_mul_poly.get() + (i * coeff_count),
-                    tmp_first_mul.get() + (i * coeff_count),
-                    coeff_count, coeff_modulus[i],
-                    tmp_mul_poly.get() + (i * coeff_count));
-                // (c0 + c1) * (d0 + d1) - c0 * d0 - c1 * d1 in NTT
-                // set the result to Des[1]
-                sub_poly_poly_coeffmod(
-                    tmp_mul_poly.get() + (i * coeff_count),
-                    tmp_second_mul.get() + (i * coeff_count),
                     coeff_count, coeff_modulus[i],
-                    tmp_des.get() + (i * coeff_count) + encrypted_ptr_increment);
+                    tmp_des.get() + (i * coeff_count),
+                    tmp_des.get() + (i * coeff_count) + encrypted_ptr_increment,
+                    tmp_des.get() + (i * coeff_count) + 2 * encrypted_ptr_increment);
             }
         }
         else
@@ -913,6 +866,7 @@ namespace seal
         switch (context_data_ptr->parms().scheme())
         {
         case scheme_type::BFV:
+            restore_coeff_form(encrypted);
             bfv_square(encrypted, move(pool));
             return;
 
@@ -1313,17 +1267,23 @@ namespace seal
         encrypted.scale() = new_scale;
     }
 
-    void Evaluator::relinearize_internal(Ciphertext &encrypted, 
-        const RelinKeys &relin_keys, size_t destination_size, 
+    void Evaluator::relinearize_internal(const vector<Ciphertext *> &encrypteds,
+        const RelinKeys &relin_keys, size_t destination_size,
         MemoryPoolHandle pool)
     {
+        if (encrypteds.empty())
+        {
+            return;
+        }
+
         // Verify parameters.
-        auto context_data_ptr = context_->context_data(encrypted.parms_id());
+        Ciphertext &first_encrypted = *encrypteds[0];
+        auto context_data_ptr = context_->context_data(first_encrypted.parms_id());
         if (!context_data_ptr)
         {
             throw invalid_argument("encrypted is not valid for encryption parameters");
         }
-        if (relin_keys.parms_id() != context_->first_parms_id())
+        if (!is_key_level_valid(relin_keys.parms_id(), *context_data_ptr))
         {
             throw invalid_argument("parameter mismatch");
         }
@@ -1335,7 +1295,19 @@ namespace seal
         // Extract encryption parameters.
         auto &context_data = *context_data_ptr;
         auto &parms = context_data.parms();
-        size_t encrypted_size = encrypted.size();
+        size_t encrypted_size = first_encrypted.size();
+
+        // All ciphertexts in a batch must share parameters, size and form
+        for (auto encrypted : encrypteds)
+        {
+            restore_coeff_form(*encrypted);
+            if (encrypted->parms_id() != first_encrypted.parms_id() ||
+                encrypted->size() != encrypted_size ||
+                encrypted->is_ntt_form() != first_encrypted.is_ntt_form())
+            {
+                throw invalid_argument("encrypteds do not match");
+            }
+        }
 
         // Verify parameters.
         if (destination_size < 2 || destination_size > encrypted_size)
@@ -1356,18 +1328,25 @@ namespace seal
         // Calculate number of relinearize_one_step calls needed
         size_t relins_needed = encrypted_size - destination_size;
 
+        vector<uint64_t *> encrypted_ptrs;
+        encrypted_ptrs.reserve(encrypteds.size());
+        for (auto encrypted : encrypteds)
+        {
+            encrypted_ptrs.push_back(encrypted->data());
+        }
+
         // Update temp to store the current result after relinearization
         switch (context_data_ptr->parms().scheme())
         {
             case scheme_type::BFV:
             {
-                if (encrypted.is_ntt_form())
+                if (first_encrypted.is_ntt_form())
                 {
                     throw invalid_argument("BFV encrypted cannot be in NTT form");
                 }
                 for (size_t i = 0; i < relins_needed; i++)
                 {
-                    bfv_relinearize_one_step(encrypted.data(), encrypted_size,
+                    bfv_relinearize_one_step(encrypted_ptrs, encrypted_size,
                         context_data, relin_keys, pool);
                     encrypted_size--;
                 }
@@ -1376,13 +1355,13 @@ namespace seal
 
             case scheme_type::CKKS:
             {
-                if (!encrypted.is_ntt_form())
+                if (!first_encrypted.is_ntt_form())
                 {
                     throw invalid_argument("CKKS encrypted must be in NTT form");
                 }
                 for (size_t i = 0; i < relins_needed; i++)
                 {
-                    ckks_relinearize_one_step(encrypted.data(), encrypted_size,
+                    ckks_relinearize_one_step(encrypted_ptrs, encrypted_size,
                         context_data, relin_keys, pool);
                     encrypted_size--;
                 }
@@ -1395,12 +1374,36 @@ namespace seal
 
         // Put the output of final relinearization into destination.
         // Prepare destination only at this point because we are resizing down
-        encrypted.resize(context_, parms.parms_id(), destination_size);
+        for (auto encrypted : encrypteds)
+        {
+            encrypted->resize(context_, parms.parms_id(), destination_size);
+        }
     }
 
-    void Evaluator::bfv_relinearize_one_step(uint64_t *encrypted, 
-        size_t encrypted_size, const SEALContext::ContextData &context_data,
-        const RelinKeys &relin_keys, MemoryPool &pool)
+    void Evaluator::relinearize_batch(vector<Ciphertext> &encrypteds,
+        const RelinKeys &relin_keys, MemoryPoolHandle pool)
+    {
+        vector<Ciphertext *> encrypted_ptrs;
+        encrypted_ptrs.reserve(encrypteds.size());
+        for (auto &encrypted : encrypteds)
+        {
+            encrypted_ptrs.push_back(&encrypted);
+        }
+        relinearize_internal(encrypted_ptrs, relin_keys, 2, move(pool));
+    }
+
+    bool Evaluator::is_key_level_valid(const parms_id_type &keys_parms_id,
+        const SEALContext::ContextData &context_data) const
+    {
+        auto keys_context_data_ptr = context_->context_data(keys_parms_id);
+        return keys_context_data_ptr &&
+            keys_context_data_ptr->chain_index() >= context_data.chain_index();
+    }
+
+    void Evaluator::switch_key_inner_product(const vector<const uint64_t *> &targets,
+        const vector<Ciphertext> &key_components, int decomposition_bit_count,
+        const SEALContext::ContextData &context_data,
+        const vector<uint64_t *> &destinations, MemoryPool &pool)
     {
         // Extract encryption parameters.
         // Parameters corresponding to the ciphertext level
@@ -1413,8 +1416,11 @@ namespace seal
         // number of factors in q_l
         size_t coeff_mod_count = coeff_modulus.size();
 
+        // number of ciphertexts sharing the key
+        size_t batch_size = targets.size();
+
         // Size test
-        if (!product_fits_in(encrypted_size, coeff_count, coeff_mod_count))
+        if (!product_fits_in(batch_size, coeff_count, coeff_mod_count))
         {
             throw logic_error("invalid parameters");
         }
@@ -1422,147 +1428,167 @@ namespace seal
         // n * number of factors in q_l
         size_t rns_poly_uint64_count = coeff_count * coeff_mod_count;
 #ifdef SEAL_DEBUG
-        if (encrypted == nullptr)
-        {
-            throw invalid_argument("encrypted cannot be null");
-        }
-        if (encrypted_size <= 2)
+        if (destinations.size() != batch_size)
         {
-            throw invalid_argument("encrypted_size must be at least 3");
+            throw invalid_argument("destinations has wrong size");
         }
-        if (relin_keys.size() < sub_safe(encrypted_size, size_t(2)))
+        if (key_components.size() < coeff_mod_count)
         {
-            throw invalid_argument("not enough relinearization keys");
+            throw invalid_argument("key_components has wrong size");
         }
 #endif
-        // q/qi mod qi
-        auto &first_context_data = *context_->context_data();
+        // (q/qi)^(-1) mod qi for the q of the level the key was generated at;
+        // the primes of every level are a prefix of those of the levels above
+        auto &key_context_data = *context_->context_data(key_components[0].parms_id());
         auto &inv_coeff_products_mod_coeff_array =
-            first_context_data.base_converter()->get_inv_coeff_mod_coeff_array();
-        auto &coeff_small_ntt_tables = first_context_data.small_ntt_tables();
+            key_context_data.base_converter()->get_inv_coeff_mod_coeff_array();
+        auto &coeff_small_ntt_tables = key_context_data.small_ntt_tables();
 
-        // Decompose encrypted_array[count-1] into base w
-        // Want to create an array of polys, each of whose components i is
-        // (encrypted_array[count-1])^(i) - in the notation of FV paper.
-        // This allocation stores one of the decomposed factors modulo one of the primes.
-        auto decomp_encrypted_last(allocate_uint(coeff_count, pool));
+        // Multiply each target by (q/q_i)^(-1) mod q_i once; the decomposition into
+        // base w is extracted from these products.
+        auto encrypted_coeff_prod_inv_coeff(allocate_uint(
+            batch_size * rns_poly_uint64_count, pool));
+        for (size_t b = 0; b < batch_size; b++)
+        {
+            for (size_t i = 0; i < coeff_mod_count; i++)
+            {
+                multiply_poly_scalar_coeffmod(
+                    targets[b] + (i * coeff_count), coeff_count,
+                    inv_coeff_products_mod_coeff_array[i], coeff_modulus[i],
+                    encrypted_coeff_prod_inv_coeff.get() +
+                    (b * rns_poly_uint64_count) + (i * coeff_count));
+            }
+        }
 
-        // Lazy reduction
-        auto wide_innerresult0(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        auto wide_innerresult1(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        auto innerresult(allocate_poly(coeff_count, coeff_mod_count, pool));
+        // This allocation stores one of the decomposed factors modulo one of the primes.
         auto temp_decomp_coeff(allocate_uint(coeff_count, pool));
 
+        // Lazy reduction; accumulators for one prime of every target in the batch
+        auto wide_innerresult0(allocate_uint(
+            mul_safe(batch_size, 2 * coeff_count), pool));
+        auto wide_innerresult1(allocate_uint(
+            mul_safe(batch_size, 2 * coeff_count), pool));
+
         /*
         For lazy reduction to work here, we need to ensure that the 128-bit accumulators
-        (wide_innerresult0 and wide_innerresult1) do not overflow. Since the modulus primes
-        are at most 60 bits, if the total number of summands is K, then the size of the
-        total sum of products (without reduction) is at most 62 + 60 + bit_length(K).
-        We need this to be at most 128, thus we need bit_length(K) <= 6. Thus, we need K <= 63.
-        In this case, this means sum_i relin_keys.data()[encrypted_size - 3][i].size() / 2 <= 63.
+        (wide_innerresult0 and wide_innerresult1) do not overflow. Each summand is the
+        product of a lazy NTT output (less than 4 * q_j) and a key coefficient (less
+        than q_j), so at most lazy_reduction_summand_bound(q_j) of them fit; for 60-bit
+        primes this is 63. The accumulators are reduced once at the end, and in between
+        only if the total number of decomposition factors exceeds this bound.
+
+        The loops run over the output primes q_j first and over the targets in the batch
+        last, so that each row of the key modulo q_j is read from memory once and is
+        then shared by all targets in the batch while it is in the cache.
         */
-        const uint64_t *encrypted_coeff = encrypted + (encrypted_size - 1) * rns_poly_uint64_count;
-        auto encrypted_coeff_prod_inv_coeff(allocate_uint(coeff_count, pool));
-
-        for (size_t i = 0; i < coeff_mod_count; i++)
+        for (size_t j = 0; j < coeff_mod_count; j++)
         {
-            multiply_poly_scalar_coeffmod(
-                encrypted_coeff + (i * coeff_count), coeff_count,
-                inv_coeff_products_mod_coeff_array[i], coeff_modulus[i],
-                encrypted_coeff_prod_inv_coeff.get());
+            uint64_t summand_bound = lazy_reduction_summand_bound(coeff_modulus[j]);
+            set_zero_uint(mul_safe(batch_size, 2 * coeff_count), wide_innerresult0.get());
+            set_zero_uint(mul_safe(batch_size, 2 * coeff_count), wide_innerresult1.get());
+            uint64_t summand_count = 0;
 
-            int shift = 0;
-            auto &key_component_ref = relin_keys.data()[encrypted_size - 3][i];
-            size_t keys_size = key_component_ref.size();
-            for (size_t k = 0; k < keys_size; k += 2)
+            for (size_t i = 0; i < coeff_mod_count; i++)
             {
-                const uint64_t *key_ptr_0 = key_component_ref.data(k);
-                const uint64_t *key_ptr_1 = key_component_ref.data(k + 1);
-
-                // Decompose here
-                int decomposition_bit_count = relin_keys.decomposition_bit_count();
-                for (size_t coeff_index = 0; coeff_index < coeff_count; coeff_index++)
-                {
-                    decomp_encrypted_last[coeff_index] =
-                        encrypted_coeff_prod_inv_coeff[coeff_index] >> shift;
-                    decomp_encrypted_last[coeff_index] &= 
-                        (uint64_t(1) << decomposition_bit_count) - 1;
-                }
-
-                uint64_t *wide_innerresult0_ptr = wide_innerresult0.get();
-                uint64_t *wide_innerresult1_ptr = wide_innerresult1.get();
-                for (size_t j = 0; j < coeff_mod_count; j++)
+                int shift = 0;
+                auto &key_component_ref = key_components[i];
+                size_t keys_size = key_component_ref.size();
+                for (size_t k = 0; k < keys_size; k += 2)
                 {
-                    uint64_t *temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    set_uint_uint(decomp_encrypted_last.get(), coeff_count, temp_decomp_coeff_ptr);
+                    const uint64_t *key_ptr_0 =
+                        key_component_ref.data(k) + (j * coeff_count);
+                    const uint64_t *key_ptr_1 =
+                        key_component_ref.data(k + 1) + (j * coeff_count);
 
-                    // We don't reduce here, so might get up to two extra bits. Thus 62 bits at most.
-                    ntt_negacyclic_harvey_lazy(temp_decomp_coeff_ptr, coeff_small_ntt_tables[j]);
-
-                    // Lazy reduction
-                    unsigned long long wide_innerproduct[2];
-                    unsigned long long temp;
-                    for (size_t m = 0; m < coeff_count; m++, wide_innerresult0_ptr += 2)
+                    // Make room in the accumulators if the next summand could overflow
+                    if (summand_count == summand_bound)
                     {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_0++, wide_innerproduct);
-                        unsigned char carry = add_uint64(wide_innerresult0_ptr[0],
-                            wide_innerproduct[0], &temp);
-                        wide_innerresult0_ptr[0] = temp;
-                        wide_innerresult0_ptr[1] += wide_innerproduct[1] + carry;
+                        for (size_t b = 0; b < batch_size; b++)
+                        {
+                            reduce_wide_accumulator(
+                                wide_innerresult0.get() + (b * 2 * coeff_count),
+                                coeff_count, coeff_modulus[j]);
+                            reduce_wide_accumulator(
+                                wide_innerresult1.get() + (b * 2 * coeff_count),
+                                coeff_count, coeff_modulus[j]);
+                        }
+                        summand_count = 0;
                     }
+                    summand_count++;
 
-                    temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    for (size_t m = 0; m < coeff_count; m++, wide_innerresult1_ptr += 2)
+                    for (size_t b = 0; b < batch_size; b++)
                     {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_1++, wide_innerproduct);
-                        unsigned char carry = add_uint64(wide_innerresult1_ptr[0],
-                            wide_innerproduct[0], &temp);
-                        wide_innerresult1_ptr[0] = temp;
-                        wide_innerresult1_ptr[1] += wide_innerproduct[1] + carry;
+                        const uint64_t *encrypted_coeff_prod_inv_coeff_ptr =
+                            encrypted_coeff_prod_inv_coeff.get() +
+                            (b * rns_poly_uint64_count) + (i * coeff_count);
+
+                        // Decompose here
+                        uint64_t *temp_decomp_coeff_ptr = temp_decomp_coeff.get();
+                        for (size_t m = 0; m < coeff_count; m++)
+                        {
+                            temp_decomp_coeff_ptr[m] =
+                                encrypted_coeff_prod_inv_coeff_ptr[m] >> shift;
+                            temp_decomp_coeff_ptr[m] &=
+                                (uint64_t(1) << decomposition_bit_count) - 1;
+                        }
+
+                        // We don't reduce here, so might get up to two extra bits.
+                        // Thus 62 bits at most.
+                        ntt_negacyclic_harvey_lazy(temp_decomp_coeff_ptr,
+                            coeff_small_ntt_tables[j]);
+
+                        // Lazy reduction
+                        uint64_t *wide_innerresult0_ptr =
+                            wide_innerresult0.get() + (b * 2 * coeff_count);
+                        uint64_t *wide_innerresult1_ptr =
+                            wide_innerresult1.get() + (b * 2 * coeff_count);
+                        unsigned long long wide_innerproduct[2];
+                        unsigned long long temp;
+                        for (size_t m = 0; m < coeff_count; m++, wide_innerresult0_ptr += 2)
+                        {
+                            multiply_uint64(temp_decomp_coeff_ptr[m], key_ptr_0[m],
+                                wide_innerproduct);
+                            unsigned char carry = add_uint64(wide_innerresult0_ptr[0],
+                                wide_innerproduct[0], &temp);
+                            wide_innerresult0_ptr[0] = temp;
+                            wide_innerresult0_ptr[1] += wide_innerproduct[1] + carry;
+                        }
+
+                        for (size_t m = 0; m < coeff_count; m++, wide_innerresult1_ptr += 2)
+                        {
+                            multiply_uint64(temp_decomp_coeff_ptr[m], key_ptr_1[m],
+                                wide_innerproduct);
+                            unsigned char carry = add_uint64(wide_innerresult1_ptr[0],
+                                wide_innerproduct[0], &temp);
+                            wide_innerresult1_ptr[0] = temp;
+                            wide_innerresult1_ptr[1] += wide_innerproduct[1] + carry;
+                        }
                     }
+                    shift += decomposition_bit_count;
                 }
-                shift += decomposition_bit_count;
-            }
-        }
-
-        uint64_t *innerresult_poly_ptr = innerresult.get();
-        uint64_t *wide_innerresult_poly_ptr = wide_innerresult0.get();
-        uint64_t *encrypted_ptr = encrypted;
-        uint64_t *innerresult_coeff_ptr = innerresult_poly_ptr;
-        uint64_t *wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (size_t i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count)
-        {
-            for (size_t m = 0; m < coeff_count; m++, wide_innerresult_coeff_ptr += 2)
-            {
-                *innerresult_coeff_ptr++ = barrett_reduce_128(
-                    wide_innerresult_coeff_ptr, coeff_modulus[i]);
             }
-            inverse_ntt_negacyclic_harvey(innerresult_poly_ptr, coeff_small_ntt_tables[i]);
-            add_poly_poly_coeffmod(encrypted_ptr, innerresult_poly_ptr, coeff_count,
-                coeff_modulus[i], encrypted_ptr);
-        }
 
-        innerresult_poly_ptr = innerresult.get();
-        wide_innerresult_poly_ptr = wide_innerresult1.get();
-        encrypted_ptr = encrypted + rns_poly_uint64_count;
-        innerresult_coeff_ptr = innerresult_poly_ptr;
-        wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (size_t i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count)
-        {
-            for (size_t m = 0; m < coeff_count; m++, wide_innerresult_coeff_ptr += 2)
+            // Reduce the accumulators into destinations
+            for (size_t b = 0; b < batch_size; b++)
             {
-                *innerresult_coeff_ptr++ = barrett_reduce_128(
-                    wide_innerresult_coeff_ptr, coeff_modulus[i]);
+                const uint64_t *wide_innerresult0_ptr =
+                    wide_innerresult0.get() + (b * 2 * coeff_count);
+                const uint64_t *wide_innerresult1_ptr =
+                    wide_innerresult1.get() + (b * 2 * coeff_count);
+                uint64_t *destination0_ptr = destinations[b] + (j * coeff_count);
+                uint64_t *destination1_ptr = destination0_ptr + rns_poly_uint64_count;
+                for (size_t m = 0; m < coeff_count; m++)
+                {
+                    destination0_ptr[m] = barrett_reduce_128(
+                        wide_innerresult0_ptr + (2 * m), coeff_modulus[j]);
+                    destination1_ptr[m] = barrett_reduce_128(
+                        wide_innerresult1_ptr + (2 * m), coeff_modulus[j]);
+                }
             }
-            inverse_ntt_negacyclic_harvey(innerresult_poly_ptr, coeff_small_ntt_tables[i]);
-            add_poly_poly_coeffmod(encrypted_ptr, innerresult_poly_ptr, coeff_count,
-                coeff_modulus[i], encrypted_ptr);
         }
     }
 
-    void Evaluator::ckks_relinearize_one_step(uint64_t *encrypted, 
+    void Evaluator::bfv_relinearize_one_step(const vector<uint64_t *> &encrypteds,
         size_t encrypted_size, const SEALContext::ContextData &context_data,
         const RelinKeys &relin_keys, MemoryPool &pool)
     {
@@ -1577,8 +1603,12 @@ namespace seal
         // number of factors in q_l
         size_t coeff_mod_count = coeff_modulus.size();
 
+        // number of ciphertexts sharing the key
+        size_t batch_size = encrypteds.size();
+
         // Size test
-        if (!product_fits_in(encrypted_size, coeff_count, coeff_mod_count))
+        if (!product_fits_in(encrypted_size, coeff_count, coeff_mod_count) ||
+            !product_fits_in(batch_size, coeff_count, coeff_mod_count, size_t(2)))
         {
             throw logic_error("invalid parameters");
         }
@@ -1586,9 +1616,12 @@ namespace seal
         // n * number of factors in q_l
         size_t rns_poly_uint64_count = coeff_count * coeff_mod_count;
 #ifdef SEAL_DEBUG
-        if (encrypted == nullptr)
+        for (auto encrypted : encrypteds)
         {
-            throw invalid_argument("encrypted cannot be null");
+            if (encrypted == nullptr)
+            {
+                throw invalid_argument("encrypted cannot be null");
+            }
         }
         if (encrypted_size <= 2)
         {
@@ -1596,136 +1629,126 @@ namespace seal
         }
         if (relin_keys.size() < sub_safe(encrypted_size, size_t(2)))
         {
-            throw invalid_argument("not enough evaluation keys");
+            throw invalid_argument("not enough relinearization keys");
         }
 #endif
-        // q/qi mod qi
-        auto &first_context_data = *context_->context_data();
-        auto &inv_coeff_products_mod_coeff_array =
-            first_context_data.base_converter()->get_inv_coeff_mod_coeff_array();
-        auto &coeff_small_ntt_tables = first_context_data.small_ntt_tables();
-
-        // Decompose encrypted_array[count-1] into base w
-        // Want to create an array of polys, each of whose components i is
-        // (encrypted_array[count-1])^(i) - in the notation of FV paper.
-        // This allocation stores one of the decomposed factors modulo one of the primes.
-        auto decomp_encrypted_last(allocate_uint(coeff_count, pool));
-
-        // Lazy reduction
-        auto wide_innerresult0(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        auto wide_innerresult1(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        auto innerresult(allocate_poly(coeff_count, coeff_mod_count, pool));
-        auto temp_decomp_coeff(allocate_uint(coeff_count, pool));
-
-        /*
-        For lazy reduction to work here, we need to ensure that the 128-bit accumulators
-        (wide_innerresult0 and wide_innerresult1) do not overflow. Since the modulus primes
-        are at most 60 bits, if the total number of summands is K, then the size of the
-        total sum of products (without reduction) is at most 62 + 60 + bit_length(K).
-        We need this to be at most 128, thus we need bit_length(K) <= 6. Thus, we need K <= 63.
-        In this case, this means sum_i evaluation_keys.data()[encrypted_size - 3][i].size() / 2 <= 63.
-        */
-        uint64_t *encrypted_coeff = encrypted + (encrypted_size - 1) * rns_poly_uint64_count;
-        auto encrypted_coeff_prod_inv_coeff(allocate_uint(coeff_count, pool));
+        auto &coeff_small_ntt_tables = context_->context_data()->small_ntt_tables();
 
-        // inner product of evaluation keys and the bit-decomposition of the last ciphertext polynomial
-        for (size_t i = 0; i < coeff_mod_count; i++)
+        // Inner product of relinearization keys and the decomposition of the last
+        // ciphertext polynomial, for every ciphertext in the batch
+        auto innerresult(allocate_uint(batch_size * 2 * rns_poly_uint64_count, pool));
+        vector<const uint64_t *> encrypted_last_ptrs;
+        vector<uint64_t *> innerresult_ptrs;
+        for (size_t b = 0; b < batch_size; b++)
         {
-            // Convert the last polynomial of encrypted from NTT to create a bit-decomposition
-            inverse_ntt_negacyclic_harvey(
-                encrypted_coeff + (i * coeff_count), coeff_small_ntt_tables[i]);
-            // c*(q_i/q) mod q_i
-            multiply_poly_scalar_coeffmod(
-                encrypted_coeff + (i * coeff_count), coeff_count,
-                inv_coeff_products_mod_coeff_array[i], coeff_modulus[i],
-                encrypted_coeff_prod_inv_coeff.get());
-
-            int shift = 0;
-            auto &key_component_ref = relin_keys.data()[encrypted_size - 3][i];
-            size_t keys_size = key_component_ref.size();
-            for (size_t k = 0; k < keys_size; k += 2)
-            {
-                const uint64_t *key_ptr_0 = key_component_ref.data(k);
-                const uint64_t *key_ptr_1 = key_component_ref.data(k + 1);
-
-                // Decompose here
-                int decomposition_bit_count = relin_keys.decomposition_bit_count();
-                for (size_t coeff_index = 0; coeff_index < coeff_count; coeff_index++)
-                {
-                    decomp_encrypted_last[coeff_index] =
-                        encrypted_coeff_prod_inv_coeff[coeff_index] >> shift;
-                    decomp_encrypted_last[coeff_index] &= 
-                        (uint64_t(1) << decomposition_bit_count) - 1;
-                }
-
-                uint64_t *wide_innerresult0_ptr = wide_innerresult0.get();
-                uint64_t *wide_innerresult1_ptr = wide_innerresult1.get();
-                for (size_t j = 0; j < coeff_mod_count; j++)
-                {
-                    uint64_t *temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    set_uint_uint(decomp_encrypted_last.get(), coeff_count, temp_decomp_coeff_ptr);
-
-                    // We don't reduce here, so might get up to two extra bits. Thus 62 bits at most.
-                    ntt_negacyclic_harvey_lazy(temp_decomp_coeff_ptr, coeff_small_ntt_tables[j]);
-
-                    // Lazy reduction
-                    unsigned long long wide_innerproduct[2];
-                    unsigned long long temp;
-                    for (size_t m = 0; m < coeff_count; m++, wide_innerresult0_ptr += 2)
-                    {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_0++, wide_innerproduct);
-                        unsigned char carry = add_uint64(wide_innerresult0_ptr[0],
-                            wide_innerproduct[0], &temp);
-                        wide_innerresult0_ptr[0] = temp;
-                        wide_innerresult0_ptr[1] += wide_innerproduct[1] + carry;
-                    }
-
-                    temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    for (size_t m = 0; m < coeff_count; m++, wide_innerresult1_ptr += 2)
-                    {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_1++, wide_innerproduct);
-                        unsigned char carry = add_uint64(wide_innerresult1_ptr[0],
-                            wide_innerproduct[0], &temp);
-                        wide_innerresult1_ptr[0] = temp;
-                        wide_innerresult1_ptr[1] += wide_innerproduct[1] + carry;
-                    }
-                }
-                shift += decomposition_bit_count;
-            }
+            encrypted_last_ptrs.push_back(
+                encrypteds[b] + (encrypted_size - 1) * rns_poly_uint64_count);
+            innerresult_ptrs.push_back(innerresult.get() + (b * 2 * rns_poly_uint64_count));
         }
+        switch_key_inner_product(encrypted_last_ptrs,
+            relin_keys.data()[encrypted_size - 3], relin_keys.decomposition_bit_count(),
+            context_data, innerresult_ptrs, pool);
 
-        uint64_t *innerresult_poly_ptr = innerresult.get();
-        uint64_t *wide_innerresult_poly_ptr = wide_innerresult0.get();
-        uint64_t *encrypted_ptr = encrypted;
-        uint64_t *innerresult_coeff_ptr = innerresult_poly_ptr;
-        uint64_t *wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (size_t i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count)
+        for (size_t b = 0; b < batch_size; b++)
         {
-            for (size_t m = 0; m < coeff_count; m++, wide_innerresult_coeff_ptr += 2)
+            uint64_t *innerresult_poly_ptr = innerresult_ptrs[b];
+            uint64_t *encrypted_ptr = encrypteds[b];
+            for (size_t l = 0; l < 2; l++)
             {
-                *innerresult_coeff_ptr++ = barrett_reduce_128(
-                    wide_innerresult_coeff_ptr, coeff_modulus[i]);
+                for (size_t i = 0; i < coeff_mod_count; i++,
+                    innerresult_poly_ptr += coeff_count, encrypted_ptr += coeff_count)
+                {
+                    inverse_ntt_negacyclic_harvey(innerresult_poly_ptr,
+                        coeff_small_ntt_tables[i]);
+                    add_poly_poly_coeffmod(encrypted_ptr, innerresult_poly_ptr, coeff_count,
+                        coeff_modulus[i], encrypted_ptr);
+                }
             }
-            add_poly_poly_coeffmod(encrypted_ptr, innerresult_poly_ptr, coeff_count,
-                coeff_modulus[i], encrypted_ptr);
         }
+    }
 
-        innerresult_poly_ptr = innerresult.get();
-        wide_innerresult_poly_ptr = wide_innerresult1.get();
-        encrypted_ptr = encrypted + rns_poly_uint64_count;
-        innerresult_coeff_ptr = innerresult_poly_ptr;
-        wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (size_t i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count)
-        {
-            for (size_t m = 0; m < coeff_count; m++, wide_innerresult_coeff_ptr += 2)
-            {
-                *innerresult_coeff_ptr++ = barrett_reduce_128(
-                    wide_innerresult_coeff_ptr, coeff_modulus[i]);
-            }
-            add_poly_poly_coeffmod(encrypted_ptr, innerresult_poly_ptr, coeff_count,
-                coeff_modulus[i], encrypted_ptr);
+    void Evaluator::ckks_relinearize_one_step(const vector<uint64_t *> &encrypteds,
+        size_t encrypted_size, const SEALContext::ContextData &context_data,
+        const RelinKeys &relin_keys, MemoryPool &pool)
+    {
+        // Extract encryption parameters.
+        // Parameters corresponding to the ciphertext level
+        auto &parms = context_data.parms();
+
+        // q_l corresponding to the ciphertext level
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+
+        // number of factors in q_l
+        size_t coeff_mod_count = coeff_modulus.size();
+
+        // number of ciphertexts sharing the key
+        size_t batch_size = encrypteds.size();
+
+        // Size test
+        if (!product_fits_in(encrypted_size, coeff_count, coeff_mod_count) ||
+            !product_fits_in(batch_size, coeff_count, coeff_mod_count, size_t(2)))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        // n * number of factors in q_l
+        size_t rns_poly_uint64_count = coeff_count * coeff_mod_count;
+#ifdef SEAL_DEBUG
+        for (auto encrypted : encrypteds)
+        {
+            if (encrypted == nullptr)
+            {
+                throw invalid_argument("encrypted cannot be null");
+            }
+        }
+        if (encrypted_size <= 2)
+        {
+            throw invalid_argument("encrypted_size must be at least 3");
+        }
+        if (relin_keys.size() < sub_safe(encrypted_size, size_t(2)))
+        {
+            throw invalid_argument("not enough evaluation keys");
+        }
+#endif
+        auto &coeff_small_ntt_tables = context_->context_data()->small_ntt_tables();
+
+        // Inner product of relinearization keys and the decomposition of the last
+        // ciphertext polynomial, for every ciphertext in the batch
+        auto innerresult(allocate_uint(batch_size * 2 * rns_poly_uint64_count, pool));
+        vector<const uint64_t *> encrypted_last_ptrs;
+        vector<uint64_t *> innerresult_ptrs;
+        for (size_t b = 0; b < batch_size; b++)
+        {
+            uint64_t *encrypted_coeff =
+                encrypteds[b] + (encrypted_size - 1) * rns_poly_uint64_count;
+
+            // Convert the last polynomial of encrypted from NTT to create a bit-decomposition
+            for (size_t i = 0; i < coeff_mod_count; i++)
+            {
+                inverse_ntt_negacyclic_harvey(
+                    encrypted_coeff + (i * coeff_count), coeff_small_ntt_tables[i]);
+            }
+            encrypted_last_ptrs.push_back(encrypted_coeff);
+            innerresult_ptrs.push_back(innerresult.get() + (b * 2 * rns_poly_uint64_count));
+        }
+        switch_key_inner_product(encrypted_last_ptrs,
+            relin_keys.data()[encrypted_size - 3], relin_keys.decomposition_bit_count(),
+            context_data, innerresult_ptrs, pool);
+
+        for (size_t b = 0; b < batch_size; b++)
+        {
+            uint64_t *innerresult_poly_ptr = innerresult_ptrs[b];
+            uint64_t *encrypted_ptr = encrypteds[b];
+            for (size_t l = 0; l < 2; l++)
+            {
+                for (size_t i = 0; i < coeff_mod_count; i++,
+                    innerresult_poly_ptr += coeff_count, encrypted_ptr += coeff_count)
+                {
+                    add_poly_poly_coeffmod(encrypted_ptr, innerresult_poly_ptr, coeff_count,
+                        coeff_modulus[i], encrypted_ptr);
+                }
+            }
         }
     }
 
@@ -1737,7 +1760,14 @@ namespace seal
         if (context_data_ptr->parms().scheme() == scheme_type::BFV &&
             encrypted.is_ntt_form())
         {
-            throw invalid_argument("BFV encrypted cannot be in NTT form");
+            if (!lazy_ntt_form_)
+            {
+                throw invalid_argument("BFV encrypted cannot be in NTT form");
+            }
+            Ciphertext encrypted_coeff(pool);
+            transform_from_ntt(encrypted, encrypted_coeff);
+            mod_switch_scale_to_next(encrypted_coeff, destination, move(pool));
+            return;
         }
         if (context_data_ptr->parms().scheme() == scheme_type::CKKS &&
             !encrypted.is_ntt_form())
@@ -1749,8 +1779,19 @@ namespace seal
             throw invalid_argument("pool is uninitialized");
         }
 
+        if (&encrypted != &destination)
+        {
+            destination = encrypted;
+        }
+        mod_switch_scale_to_next_inplace(destination, pool);
+    }
+
+    void Evaluator::mod_switch_scale_to_next_inplace(Ciphertext &encrypted,
+        MemoryPool &pool)
+    {
         // Extract encryption parameters.
-        auto &context_data = *context_data_ptr;
+        auto &context_data = *context_->context_data(encrypted.parms_id());
+        auto &coeff_small_ntt_tables = context_data.small_ntt_tables();
         auto &next_parms = context_data.next_context_data()->parms();
 
         // q_1,...,q_{k-1}
@@ -1767,59 +1808,59 @@ namespace seal
             throw logic_error("invalid parameters");
         }
 
-        // In CKKS need to transform away from NTT form
-        Ciphertext encrypted_copy(pool);
-        encrypted_copy = encrypted;
-        if (next_parms.scheme() == scheme_type::CKKS)
-        {
-            transform_from_ntt_inplace(encrypted_copy);
-        }
-
-        auto temp1(allocate_uint(coeff_count, pool));
-
-        // Allocate enough room for the result
-        auto temp2(allocate_poly(coeff_count * encrypted_size, next_coeff_mod_count, pool));
-        auto temp2_ptr = temp2.get();
+        /*
+        Each polynomial is replaced by qk^(-1) * ((ct mod qi) - (ct mod qk)) mod qi. 
+        The result for polynomial j is written over the first next_coeff_mod_count 
+        primes of the input from polynomial j on, so the input of polynomial j is 
+        only overwritten after it has been read. In NTT form (CKKS) only ct mod qk 
+        is transformed to coefficient form; its reductions mod qi are transformed 
+        back, and the rest is computed in NTT form.
+        */
+        bool is_ntt_form = encrypted.is_ntt_form();
+        auto temp(allocate_uint(2 * coeff_count, pool));
+        uint64_t *last_ptr = temp.get();
+        uint64_t *reduced_ptr = last_ptr + coeff_count;
+        uint64_t *destination_ptr = encrypted.data();
 
         for (size_t poly_index = 0; poly_index < encrypted_size; poly_index++)
         {
-            // Set temp1 to ct mod qk
-            set_uint_uint(encrypted_copy.data(poly_index) + next_coeff_mod_count * coeff_count,
-                coeff_count, temp1.get());
+            const uint64_t *encrypted_ptr = encrypted.data(poly_index);
+
+            // Set last_ptr to ct mod qk
+            set_uint_uint(encrypted_ptr + next_coeff_mod_count * coeff_count,
+                coeff_count, last_ptr);
+            if (is_ntt_form)
+            {
+                inverse_ntt_negacyclic_harvey(last_ptr,
+                    coeff_small_ntt_tables[next_coeff_mod_count]);
+            }
             for (size_t mod_index = 0; mod_index < next_coeff_mod_count; mod_index++,
-                temp2_ptr += coeff_count)
+                encrypted_ptr += coeff_count, destination_ptr += coeff_count)
             {
                 // (ct mod qk) mod qi
-                modulo_poly_coeffs(temp1.get(), coeff_count,
-                    next_coeff_modulus[mod_index], temp2_ptr);
-                // (-(ct mod qk)) mod qi
-                negate_poly_coeffmod(temp2_ptr, coeff_count,
-                    next_coeff_modulus[mod_index], temp2_ptr);
+                modulo_poly_coeffs(last_ptr, coeff_count,
+                    next_coeff_modulus[mod_index], reduced_ptr);
+                if (is_ntt_form)
+                {
+                    ntt_negacyclic_harvey(reduced_ptr, coeff_small_ntt_tables[mod_index]);
+                }
                 // ((ct mod qi) - (ct mod qk)) mod qi
-                add_poly_poly_coeffmod(
-                    encrypted_copy.data(poly_index) + mod_index * coeff_count, temp2_ptr,
-                    coeff_count, next_coeff_modulus[mod_index], temp2_ptr);
+                sub_poly_poly_coeffmod(encrypted_ptr, reduced_ptr, coeff_count,
+                    next_coeff_modulus[mod_index], destination_ptr);
                 // qk^(-1) * ((ct mod qi) - (ct mod qk)) mod qi
-                multiply_poly_scalar_coeffmod(temp2_ptr, coeff_count,
+                multiply_poly_scalar_coeffmod(destination_ptr, coeff_count,
                     inv_last_coeff_mod_array[mod_index],
-                    next_coeff_modulus[mod_index], temp2_ptr);
+                    next_coeff_modulus[mod_index], destination_ptr);
             }
         }
 
-        // Resize destination
-        destination.resize(context_, next_parms.parms_id(), encrypted_size);
-        destination.is_ntt_form() = false;
-
-        set_poly_poly(temp2.get(), coeff_count * encrypted_size, next_coeff_mod_count,
-            destination.data());
+        // Drop the last prime; this only shrinks the data
+        encrypted.resize(context_, next_parms.parms_id(), encrypted_size);
 
-        // In CKKS need to transform back to NTT form
+        // In CKKS also change the scale
         if (next_parms.scheme() == scheme_type::CKKS)
         {
-            transform_to_ntt_inplace(destination);
-
-            // Also change the scale
-            destination.scale() = encrypted.scale() /
+            encrypted.scale() /=
                 static_cast<double>(context_data.parms().coeff_modulus().back().value());
         }
     }
@@ -2083,9 +2124,46 @@ namespace seal
         }
     }
 
-    void Evaluator::multiply_many(vector<Ciphertext> &encrypteds,
-        const RelinKeys &relin_keys, Ciphertext &destination,
+    void Evaluator::multiply_relin_rescale_inplace(Ciphertext &encrypted1,
+        const Ciphertext &encrypted2, const RelinKeys &relin_keys,
         MemoryPoolHandle pool)
+    {
+        // Verify parameters before anything is modified; multiply_inplace and
+        // relinearize_inplace verify the rest.
+        auto context_data_ptr = context_->context_data(encrypted1.parms_id());
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("encrypted1 is not valid for encryption parameters");
+        }
+        if (context_->last_parms_id() == encrypted1.parms_id())
+        {
+            throw invalid_argument("end of modulus switching chain reached");
+        }
+        if (!is_key_level_valid(relin_keys.parms_id(), *context_data_ptr))
+        {
+            throw invalid_argument("relin_keys is not valid for encryption parameters");
+        }
+        if (relin_keys.size() < 
+            sub_safe(add_safe(encrypted1.size(), encrypted2.size()), size_t(3)))
+        {
+            throw invalid_argument("not enough relinearization keys");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        multiply_inplace(encrypted1, encrypted2, pool);
+        relinearize_inplace(encrypted1, relin_keys, pool);
+
+        // Relinearization leaves BFV ciphertexts in coefficient form and CKKS 
+        // ciphertexts in NTT form, as mod_switch_scale_to_next_inplace expects.
+        mod_switch_scale_to_next_inplace(encrypted1, pool);
+    }
+
+    void Evaluator::multiply_many_internal(const vector<Ciphertext> &encrypteds,
+        const RelinKeys &relin_keys, Ciphertext &destination,
+        ThreadPool *thread_pool, MemoryPoolHandle pool)
     {
         // Verify parameters.
         if (encrypteds.size() == 0)
@@ -2096,13 +2174,6 @@ namespace seal
         {
             throw invalid_argument("pool is uninitialized");
         }
-        for (size_t i = 0; i < encrypteds.size(); i++)
-        {
-            if (&encrypteds[i] == &destination)
-            {
-                throw invalid_argument("encrypteds must be different from destination");
-            }
-        }
 
         // There is at least one ciphertext
         auto context_data_ptr = context_->context_data(encrypteds[0].parms_id());
@@ -2127,33 +2198,66 @@ namespace seal
             return;
         }
 
-        // Repeatedly multiply and add to the back of the vector until the end is reached
-        Ciphertext product(context_, parms.parms_id(), pool);
-        for (size_t i = 0; i < encrypteds.size() - 1; i += 2)
+        // Multiply pairwise in a balanced product tree; with an odd number of 
+        // operands the last one moves up to the next level unchanged. The products
+        // on one level are independent, so they can be computed in parallel.
+        vector<Ciphertext> level;
+        const vector<Ciphertext> *operands = &encrypteds;
+        while (operands->size() > 1)
         {
-            // We only compare pointers to determine if a faster path can be taken.
-            // This is under the assumption that if the two pointers are the same and
-            // the parameter sets match, then it makes no sense for one of the ciphertexts
-            // to be of different size than the other. More generally, it seems like
-            // a reasonable assumption that if the pointers are the same, then the
-            // ciphertexts are the same.
-            if (encrypteds[i].data() == encrypteds[i + 1].data())
+            size_t product_count = operands->size() / 2;
+            vector<Ciphertext> products;
+            products.reserve(product_count + (operands->size() & 1));
+            for (size_t i = 0; i < product_count; i++)
+            {
+                products.emplace_back(pool);
+            }
+
+            auto multiply_pair = [&](size_t i) {
+                auto &operand1 = (*operands)[2 * i];
+                auto &operand2 = (*operands)[2 * i + 1];
+
+                // We only compare pointers to determine if a faster path can be taken.
+                // This is under the assumption that if the two pointers are the same and
+                // the parameter sets match, then it makes no sense for one of the 
+                // ciphertexts to be of different size than the other. More generally, it
+                // seems like a reasonable assumption that if the pointers are the same, 
+                // then the ciphertexts are the same.
+                if (operand1.data() == operand2.data())
+                {
+                    square(operand1, products[i], pool);
+                }
+                else
+                {
+                    multiply(operand1, operand2, products[i], pool);
+                }
+                relinearize_inplace(products[i], relin_keys, pool);
+            };
+            if (thread_pool)
             {
-                square(encrypteds[i], product);
+                thread_pool->parallel_for(product_count, multiply_pair);
             }
             else
             {
-                multiply(encrypteds[i], encrypteds[i + 1], product);
+                for (size_t i = 0; i < product_count; i++)
+                {
+                    multiply_pair(i);
+                }
+            }
+
+            if (operands->size() & 1)
+            {
+                products.emplace_back(operands->back());
             }
-            relinearize_inplace(product, relin_keys, pool);
-            encrypteds.emplace_back(product);
+            level = move(products);
+            operands = &level;
         }
 
-        destination = encrypteds[encrypteds.size() - 1];
+        destination = move(level[0]);
     }
 
-    void Evaluator::exponentiate_inplace(Ciphertext &encrypted, uint64_t exponent,
-        const RelinKeys &relin_keys, MemoryPoolHandle pool)
+    void Evaluator::exponentiate_internal(Ciphertext &encrypted, uint64_t exponent,
+        const RelinKeys &relin_keys, ThreadPool *thread_pool, MemoryPoolHandle pool)
     {
         // Verify parameters.
         auto context_data_ptr = context_->context_data(encrypted.parms_id());
@@ -2161,6 +2265,10 @@ namespace seal
         {
             throw invalid_argument("encrypted is not valid for encryption parameters");
         }
+        if (context_data_ptr->parms().scheme() != scheme_type::BFV)
+        {
+            throw logic_error("unsupported scheme");
+        }
         if (!context_->context_data(relin_keys.parms_id()))
         {
             throw invalid_argument("relin_keys is not valid for encryption parameters");
@@ -2180,9 +2288,82 @@ namespace seal
             return;
         }
 
-        // Create a vector of copies of encrypted
-        vector<Ciphertext> exp_vector(exponent, encrypted);
-        multiply_many(exp_vector, relin_keys, encrypted, move(pool));
+        /*
+        Right-to-left binary exponentiation: the powers encrypted^(2^i) are computed
+        by repeated squaring, and those for the set bits of the exponent are folded
+        into the result as soon as they are available. This takes floor(log2(e)) 
+        squarings and popcount(e) - 1 further multiplications instead of the e - 1 
+        multiplications of a product tree of copies. The result folded from bits 
+        below i has multiplicative depth at most i, so the total depth is still the
+        optimal ceil(log2(e)). The fold of one power and the squaring that produces
+        the next one only read that power, so they can run in parallel.
+        */
+        Ciphertext power(encrypted);
+        Ciphertext next_power(pool);
+        Ciphertext result(pool);
+        Ciphertext next_result(pool);
+        bool result_set = false;
+        while (true)
+        {
+            bool fold = (exponent & 1) != 0;
+            exponent >>= 1;
+
+            // Only the last fold remains
+            if (!exponent)
+            {
+                break;
+            }
+
+            auto step = [&](size_t i) {
+                if (i == 0)
+                {
+                    square(power, next_power, pool);
+                    relinearize_inplace(next_power, relin_keys, pool);
+                }
+                else
+                {
+                    multiply(result, power, next_result, pool);
+                    relinearize_inplace(next_result, relin_keys, pool);
+                }
+            };
+            size_t step_count = (fold && result_set) ? 2 : 1;
+            if (thread_pool)
+            {
+                thread_pool->parallel_for(step_count, step);
+            }
+            else
+            {
+                for (size_t i = 0; i < step_count; i++)
+                {
+                    step(i);
+                }
+            }
+
+            if (fold)
+            {
+                if (result_set)
+                {
+                    swap(result, next_result);
+                }
+                else
+                {
+                    result = power;
+                    result_set = true;
+                }
+            }
+            swap(power, next_power);
+        }
+
+        // The highest bit of the exponent is always set
+        if (result_set)
+        {
+            multiply(result, power, encrypted, pool);
+            relinearize_inplace(encrypted, relin_keys, pool);
+        }
+        else
+        {
+            encrypted = move(power);
+        }
     }
 
     void Evaluator::add_plain_inplace(Ciphertext &encrypted, const Plaintext &plain)
@@ -2196,7 +2377,12 @@ namespace seal
         if (context_data_ptr->parms().scheme() == scheme_type::BFV &&
             encrypted.is_ntt_form())
         {
-            throw invalid_argument("BFV encrypted cannot be in NTT form");
+            if (!lazy_ntt_form_)
+            {
+                throw invalid_argument("BFV encrypted cannot be in NTT form");
+            }
+            bfv_add_plain_ntt(encrypted, plain, false);
+            return;
         }
         if (context_data_ptr->parms().scheme() == scheme_type::CKKS &&
             !encrypted.is_ntt_form())
@@ -2318,7 +2504,12 @@ namespace seal
         if (context_data_ptr->parms().scheme() == scheme_type::BFV &&
             encrypted.is_ntt_form())
         {
-            throw invalid_argument("BFV encrypted cannot be in NTT form");
+            if (!lazy_ntt_form_)
+            {
+                throw invalid_argument("BFV encrypted cannot be in NTT form");
+            }
+            bfv_add_plain_ntt(encrypted, plain, true);
+            return;
         }
         if (context_data_ptr->parms().scheme() == scheme_type::CKKS &&
             !encrypted.is_ntt_form())
@@ -2422,90 +2613,385 @@ namespace seal
         }
     }
 
-    void Evaluator::multiply_plain_inplace(Ciphertext &encrypted, 
-        const Plaintext &plain, MemoryPoolHandle pool)
+    void Evaluator::bfv_scale_plain(const Plaintext &plain,
+        const SEALContext::ContextData &context_data, uint64_t *destination)
     {
+        // Extract encryption parameters.
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+
         // Verify parameters.
-        if (!context_->context_data(encrypted.parms_id()))
+        if (plain.is_ntt_form())
         {
-            throw invalid_argument("encrypted is not valid for encryption parameters");
+            throw invalid_argument("plain cannot be in NTT form");
         }
-        if (encrypted.is_ntt_form() != plain.is_ntt_form())
+        if (plain.coeff_count() > coeff_count)
         {
-            throw invalid_argument("NTT form mismatch");
+            throw invalid_argument("plain is not valid for encryption parameters");
         }
-        if (!pool)
+#ifdef SEAL_DEBUG
+        if (!are_poly_coefficients_less_than(plain.data(),
+            plain.coeff_count(), parms.plain_modulus().value()))
         {
-            throw invalid_argument("pool is uninitialized");
+            throw invalid_argument("plain is not valid for encryption parameters");
         }
+#endif
+        auto coeff_div_plain_modulus = context_data.coeff_div_plain_modulus();
+        auto plain_upper_half_threshold = context_data.plain_upper_half_threshold();
+        auto upper_half_increment = context_data.upper_half_increment();
 
-        if (encrypted.is_ntt_form())
-        {
-            multiply_plain_ntt(encrypted, plain);
-        }
-        else
+        // This is Encryptor::preencrypt into a separate polynomial
+        set_zero_poly(coeff_count, coeff_mod_count, destination);
+        for (size_t i = 0; i < plain.coeff_count(); i++)
         {
-            multiply_plain_normal(encrypted, plain, move(pool));
+            if (plain[i] >= plain_upper_half_threshold)
+            {
+                for (size_t j = 0; j < coeff_mod_count; j++)
+                {
+                    unsigned long long temp[2]{ 0, 0 };
+                    multiply_uint64(coeff_div_plain_modulus[j], plain[i], temp);
+                    temp[1] += add_uint64(temp[0], upper_half_increment[j], temp);
+                    destination[i + (j * coeff_count)] =
+                        barrett_reduce_128(temp, coeff_modulus[j]);
+                }
+            }
+            else
+            {
+                for (size_t j = 0; j < coeff_mod_count; j++)
+                {
+                    destination[i + (j * coeff_count)] = multiply_uint_uint_mod(
+                        coeff_div_plain_modulus[j], plain[i], coeff_modulus[j]);
+                }
+            }
         }
     }
 
-    void Evaluator::multiply_plain_normal(Ciphertext &encrypted, 
-        const Plaintext &plain, MemoryPool &pool)
+    void Evaluator::bfv_add_plain_ntt(Ciphertext &encrypted_ntt,
+        const Plaintext &plain, bool subtract)
     {
         // Extract encryption parameters.
-        auto &context_data = *context_->context_data(encrypted.parms_id());
+        auto &context_data = *context_->context_data(encrypted_ntt.parms_id());
         auto &parms = context_data.parms();
         auto &coeff_modulus = parms.coeff_modulus();
         size_t coeff_count = parms.poly_modulus_degree();
         size_t coeff_mod_count = coeff_modulus.size();
-
-        auto plain_upper_half_threshold = context_data.plain_upper_half_threshold();
-        auto plain_upper_half_increment = context_data.plain_upper_half_increment();
         auto &coeff_small_ntt_tables = context_data.small_ntt_tables();
 
-        size_t encrypted_size = encrypted.size();
-        size_t plain_coeff_count = plain.coeff_count();
-
         // Size check
-        if (!product_fits_in(encrypted_size, coeff_count, coeff_mod_count))
+        if (!product_fits_in(coeff_count, coeff_mod_count))
         {
             throw logic_error("invalid parameters");
         }
 
-        double new_scale = encrypted.scale() * plain.scale();
+        // Scale plain into a temporary polynomial, which is then transformed to
+        // NTT form and added to (or subtracted from) c0.
+        auto pool = MemoryManager::GetPool();
+        auto scaled_plain(allocate_poly(coeff_count, coeff_mod_count, pool));
+        bfv_scale_plain(plain, context_data, scaled_plain.get());
 
-        // Check that scale is positive and not too large
-        if (new_scale <= 0 || (static_cast<int>(log2(new_scale)) >=
-            context_data.total_coeff_modulus_bit_count()))
+        for (size_t j = 0; j < coeff_mod_count; j++)
         {
-            throw invalid_argument("scale out of bounds");
+            uint64_t *scaled_plain_ptr = scaled_plain.get() + (j * coeff_count);
+            uint64_t *encrypted_ptr = encrypted_ntt.data() + (j * coeff_count);
+            ntt_negacyclic_harvey(scaled_plain_ptr, coeff_small_ntt_tables[j]);
+            if (subtract)
+            {
+                sub_poly_poly_coeffmod(encrypted_ptr, scaled_plain_ptr, coeff_count,
+                    coeff_modulus[j], encrypted_ptr);
+            }
+            else
+            {
+                add_poly_poly_coeffmod(encrypted_ptr, scaled_plain_ptr, coeff_count,
+                    coeff_modulus[j], encrypted_ptr);
+            }
         }
+    }
 
-        // Verify more parameters.
-#ifdef SEAL_THROW_ON_MULTIPLY_PLAIN_BY_ZERO
-        if (plain.is_zero())
-        {
-            throw invalid_argument("plain cannot be zero");
-        }
-#endif
-        if (plain.coeff_count() > coeff_count)
+    void Evaluator::prepare_plain(const Plaintext &plain, parms_id_type parms_id,
+        PreparedPlaintext &destination, MemoryPoolHandle pool)
+    {
+        // Verify parameters.
+        auto context_data_ptr = context_->context_data(parms_id);
+        if (!context_data_ptr)
         {
-            throw invalid_argument("plain is not valid for encryption parameters");
+            throw invalid_argument("parms_id is not valid for the current context");
         }
-#ifdef SEAL_DEBUG
-        if (!are_poly_coefficients_less_than(plain.data(),
-            plain.coeff_count(), parms.plain_modulus().value()))
+        if (!pool)
         {
-            throw invalid_argument("plain is not valid for encryption parameters");
+            throw invalid_argument("pool is uninitialized");
         }
-#endif
-        // Set the scale
-        encrypted.scale() = new_scale;
 
-        // Multiplying just by a constant?
-        if (plain_coeff_count == 1)
-        {
-            if (!context_data.qualifiers().using_fast_plain_lift)
+        // Extract encryption parameters.
+        auto &context_data = *context_data_ptr;
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+        auto &coeff_small_ntt_tables = context_data.small_ntt_tables();
+
+        // Size check
+        if (!product_fits_in(coeff_count, coeff_mod_count))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        switch (parms.scheme())
+        {
+        case scheme_type::BFV:
+        {
+            if (plain.is_ntt_form())
+            {
+                throw invalid_argument("BFV plain cannot be in NTT form");
+            }
+
+            // Plain multiplication operand: lifted to all primes and in NTT form
+            transform_to_ntt(plain, parms_id, destination.multiply_operand_, pool);
+
+            // Plain addition operands: Delta * plain in coefficient and NTT form
+            auto &add_operand = destination.add_operand_;
+            add_operand.resize(coeff_count * coeff_mod_count);
+            bfv_scale_plain(plain, context_data, add_operand.data());
+
+            auto &add_operand_ntt = destination.add_operand_ntt_;
+            add_operand_ntt = add_operand;
+            for (size_t j = 0; j < coeff_mod_count; j++)
+            {
+                ntt_negacyclic_harvey(add_operand_ntt.data() + (j * coeff_count),
+                    coeff_small_ntt_tables[j]);
+            }
+            break;
+        }
+
+        case scheme_type::CKKS:
+        {
+            if (!plain.is_ntt_form())
+            {
+                throw invalid_argument("CKKS plain must be in NTT form");
+            }
+
+            // Drop plain to the requested level once, instead of for every use
+            if (plain.parms_id() == parms_id)
+            {
+                destination.multiply_operand_ = plain;
+            }
+            else
+            {
+                mod_switch_to(plain, parms_id, destination.multiply_operand_);
+            }
+            destination.add_operand_.release();
+            destination.add_operand_ntt_.release();
+            break;
+        }
+
+        default:
+            throw invalid_argument("unsupported scheme");
+        }
+
+        destination.parms_id_ = parms_id;
+    }
+
+    void Evaluator::multiply_plain_inplace(Ciphertext &encrypted,
+        const PreparedPlaintext &prepared)
+    {
+        // Verify parameters.
+        auto context_data_ptr = context_->context_data(encrypted.parms_id());
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (encrypted.parms_id() != prepared.parms_id())
+        {
+            throw invalid_argument("encrypted and prepared parameter mismatch");
+        }
+
+        // BFV ciphertexts in coefficient form are transformed for the product; 
+        // with lazy NTT form tracking they are left in NTT form.
+        if (!encrypted.is_ntt_form())
+        {
+            if (context_data_ptr->parms().scheme() != scheme_type::BFV)
+            {
+                throw invalid_argument("CKKS encrypted must be in NTT form");
+            }
+            transform_to_ntt_inplace(encrypted);
+            multiply_plain_ntt(encrypted, prepared.multiply_operand_);
+            if (!lazy_ntt_form_)
+            {
+                transform_from_ntt_inplace(encrypted);
+            }
+            return;
+        }
+        multiply_plain_ntt(encrypted, prepared.multiply_operand_);
+    }
+
+    void Evaluator::add_prepared_plain(Ciphertext &encrypted,
+        const PreparedPlaintext &prepared, bool subtract)
+    {
+        // Verify parameters.
+        auto context_data_ptr = context_->context_data(encrypted.parms_id());
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (encrypted.parms_id() != prepared.parms_id())
+        {
+            throw invalid_argument("encrypted and prepared parameter mismatch");
+        }
+        if (!are_same_scale(encrypted, prepared.multiply_operand_))
+        {
+            throw invalid_argument("scale mismatch");
+        }
+
+        // Extract encryption parameters.
+        auto &parms = context_data_ptr->parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+
+        // Pick the operand matching the form of encrypted
+        const uint64_t *operand_ptr = nullptr;
+        switch (parms.scheme())
+        {
+        case scheme_type::BFV:
+            operand_ptr = encrypted.is_ntt_form() ? prepared.add_operand_ntt_.data() :
+                prepared.add_operand_.data();
+            break;
+
+        case scheme_type::CKKS:
+            if (!encrypted.is_ntt_form())
+            {
+                throw invalid_argument("CKKS encrypted must be in NTT form");
+            }
+            operand_ptr = prepared.multiply_operand_.data();
+            break;
+
+        default:
+            throw invalid_argument("unsupported scheme");
+        }
+
+        for (size_t j = 0; j < coeff_mod_count; j++)
+        {
+            uint64_t *encrypted_ptr = encrypted.data() + (j * coeff_count);
+            if (subtract)
+            {
+                sub_poly_poly_coeffmod(encrypted_ptr, operand_ptr + (j * coeff_count),
+                    coeff_count, coeff_modulus[j], encrypted_ptr);
+            }
+            else
+            {
+                add_poly_poly_coeffmod(encrypted_ptr, operand_ptr + (j * coeff_count),
+                    coeff_count, coeff_modulus[j], encrypted_ptr);
+            }
+        }
+    }
+
+    void Evaluator::multiply_plain_inplace(Ciphertext &encrypted, 
+        const Plaintext &plain, MemoryPoolHandle pool)
+    {
+        // Verify parameters.
+        auto context_data_ptr = context_->context_data(encrypted.parms_id());
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // With lazy NTT form tracking the BFV ciphertext is left in NTT form, so
+        // that a chain of plain multiplications only transforms the plaintexts.
+        if (lazy_ntt_form_ && context_data_ptr->parms().scheme() == scheme_type::BFV)
+        {
+            if (!encrypted.is_ntt_form())
+            {
+                transform_to_ntt_inplace(encrypted);
+            }
+            if (plain.is_ntt_form())
+            {
+                multiply_plain_ntt(encrypted, plain);
+            }
+            else
+            {
+                Plaintext plain_ntt(pool);
+                transform_to_ntt(plain, encrypted.parms_id(), plain_ntt, pool);
+                multiply_plain_ntt(encrypted, plain_ntt);
+            }
+            return;
+        }
+        if (encrypted.is_ntt_form() != plain.is_ntt_form())
+        {
+            throw invalid_argument("NTT form mismatch");
+        }
+
+        if (encrypted.is_ntt_form())
+        {
+            multiply_plain_ntt(encrypted, plain);
+        }
+        else
+        {
+            multiply_plain_normal(encrypted, plain, move(pool));
+        }
+    }
+
+    void Evaluator::multiply_plain_normal(Ciphertext &encrypted, 
+        const Plaintext &plain, MemoryPool &pool)
+    {
+        // Extract encryption parameters.
+        auto &context_data = *context_->context_data(encrypted.parms_id());
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+
+        auto plain_upper_half_threshold = context_data.plain_upper_half_threshold();
+        auto plain_upper_half_increment = context_data.plain_upper_half_increment();
+        auto &coeff_small_ntt_tables = context_data.small_ntt_tables();
+
+        size_t encrypted_size = encrypted.size();
+        size_t plain_coeff_count = plain.coeff_count();
+
+        // Size check
+        if (!product_fits_in(encrypted_size, coeff_count, coeff_mod_count))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        double new_scale = encrypted.scale() * plain.scale();
+
+        // Check that scale is positive and not too large
+        if (new_scale <= 0 || (static_cast<int>(log2(new_scale)) >=
+            context_data.total_coeff_modulus_bit_count()))
+        {
+            throw invalid_argument("scale out of bounds");
+        }
+
+        // Verify more parameters.
+#ifdef SEAL_THROW_ON_MULTIPLY_PLAIN_BY_ZERO
+        if (plain.is_zero())
+        {
+            throw invalid_argument("plain cannot be zero");
+        }
+#endif
+        if (plain.coeff_count() > coeff_count)
+        {
+            throw invalid_argument("plain is not valid for encryption parameters");
+        }
+#ifdef SEAL_DEBUG
+        if (!are_poly_coefficients_less_than(plain.data(),
+            plain.coeff_count(), parms.plain_modulus().value()))
+        {
+            throw invalid_argument("plain is not valid for encryption parameters");
+        }
+#endif
+        // Set the scale
+        encrypted.scale() = new_scale;
+
+        // Multiplying just by a constant?
+        if (plain_coeff_count == 1)
+        {
+            if (!context_data.qualifiers().using_fast_plain_lift)
             {
                 auto adjusted_coeff(allocate_uint(coeff_mod_count, pool));
                 if (plain[0] >= plain_upper_half_threshold)
@@ -2576,6 +3062,49 @@ namespace seal
             }
         }
 
+        // Sparse plain case, such as the output of IntegerEncoder: the product is a 
+        // sum of scaled negacyclic shifts, which needs no NTT.
+        if (is_sparse_plain(plain, plain_coeff_count, coeff_count,
+            parms.plain_modulus().value()))
+        {
+            auto result(allocate_uint(coeff_count, pool));
+
+            // Positions of the nonzero coefficients, and their values lifted to
+            // the current prime; the lift is shared by all ciphertext polynomials.
+            auto nonzero_index(allocate_uint(plain_coeff_count, pool));
+            auto nonzero_value(allocate_uint(plain_coeff_count, pool));
+            size_t nonzero_count = 0;
+            for (size_t k = 0; k < plain_coeff_count; k++)
+            {
+                if (plain[k])
+                {
+                    nonzero_index[nonzero_count++] = k;
+                }
+            }
+
+            for (size_t j = 0; j < coeff_mod_count; j++)
+            {
+                for (size_t t = 0; t < nonzero_count; t++)
+                {
+                    nonzero_value[t] = lift_plain_scalar(
+                        plain[nonzero_index[t]], context_data, j);
+                }
+                for (size_t i = 0; i < encrypted_size; i++)
+                {
+                    uint64_t *encrypted_ptr = encrypted.data(i) + (j * coeff_count);
+                    set_zero_uint(coeff_count, result.get());
+                    for (size_t t = 0; t < nonzero_count; t++)
+                    {
+                        negacyclic_multiply_add_monomial(encrypted_ptr, coeff_count, 
+                            nonzero_index[t], nonzero_value[t],
+                            coeff_modulus[j], result.get());
+                    }
+                    set_uint_uint(result.get(), coeff_count, encrypted_ptr);
+                }
+            }
+            return;
+        }
+
         // Generic plain case
         auto adjusted_poly(allocate_zero_uint(coeff_count * coeff_mod_count, pool));
         auto decomposed_poly(allocate_uint(coeff_count * coeff_mod_count, pool));
@@ -2725,22 +3254,13 @@ namespace seal
         encrypted_ntt.scale() = new_scale;
     }
 
-    void Evaluator::transform_to_ntt_inplace(Plaintext &plain, 
-        parms_id_type parms_id, MemoryPoolHandle pool)
+    void Evaluator::multiply_scalar_inplace(Ciphertext &encrypted, uint64_t scalar)
     {
         // Verify parameters.
-        auto context_data_ptr = context_->context_data(parms_id);
+        auto context_data_ptr = context_->context_data(encrypted.parms_id());
         if (!context_data_ptr)
         {
-            throw invalid_argument("parms_id is not valid for the current context");
-        }
-        if (plain.is_ntt_form())
-        {
-            throw invalid_argument("plain is already in NTT form");
-        }
-        if (!pool)
-        {
-            throw invalid_argument("pool is uninitialized");
+            throw invalid_argument("encrypted is not valid for encryption parameters");
         }
 
         // Extract encryption parameters.
@@ -2749,24 +3269,314 @@ namespace seal
         auto &coeff_modulus = parms.coeff_modulus();
         size_t coeff_count = parms.poly_modulus_degree();
         size_t coeff_mod_count = coeff_modulus.size();
-        size_t plain_coeff_count = plain.coeff_count();
-
-        auto plain_upper_half_threshold = context_data.plain_upper_half_threshold();
-        auto plain_upper_half_increment = context_data.plain_upper_half_increment();
+        size_t encrypted_size = encrypted.size();
 
-        // Verify more parameters.
-        if (plain.coeff_count() > coeff_count)
-        {
-            throw invalid_argument("plain is not valid for encryption parameters");
-        }
-#ifdef SEAL_DEBUG
-        if (!are_poly_coefficients_less_than(plain.data(),
-            plain.coeff_count(), parms.plain_modulus().value()))
+        // Size check
+        if (!product_fits_in(encrypted_size, coeff_count, coeff_mod_count))
         {
-            throw invalid_argument("plain is not valid for encryption parameters");
+            throw logic_error("invalid parameters");
         }
-#endif
-        auto &coeff_small_ntt_tables = context_data.small_ntt_tables();
+
+        // For BFV the scalar is a plaintext value and is lifted like the constant
+        // coefficient of a plaintext; for CKKS it is an integer.
+        vector<uint64_t> scalar_mod_coeff(coeff_mod_count);
+        switch (parms.scheme())
+        {
+        case scheme_type::BFV:
+            scalar %= parms.plain_modulus().value();
+            for (size_t j = 0; j < coeff_mod_count; j++)
+            {
+                scalar_mod_coeff[j] = lift_plain_scalar(scalar, context_data, j);
+            }
+            break;
+
+        case scheme_type::CKKS:
+            for (size_t j = 0; j < coeff_mod_count; j++)
+            {
+                scalar_mod_coeff[j] = scalar % coeff_modulus[j].value();
+            }
+            break;
+
+        default:
+            throw invalid_argument("unsupported scheme");
+        }
+#ifdef SEAL_THROW_ON_MULTIPLY_PLAIN_BY_ZERO
+        if (!scalar)
+        {
+            throw invalid_argument("scalar cannot be zero");
+        }
+#endif
+        // The product with a constant is the same in both NTT forms
+        for (size_t i = 0; i < encrypted_size; i++)
+        {
+            for (size_t j = 0; j < coeff_mod_count; j++)
+            {
+                multiply_poly_scalar_coeffmod(encrypted.data(i) + (j * coeff_count),
+                    coeff_count, scalar_mod_coeff[j], coeff_modulus[j],
+                    encrypted.data(i) + (j * coeff_count));
+            }
+        }
+    }
+
+    void Evaluator::multiply_scalar_inplace(Ciphertext &encrypted, double scalar,
+        double scale)
+    {
+        // Verify parameters.
+        auto context_data_ptr = context_->context_data(encrypted.parms_id());
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (context_data_ptr->parms().scheme() != scheme_type::CKKS)
+        {
+            throw logic_error("unsupported scheme");
+        }
+        if (!encrypted.is_ntt_form())
+        {
+            throw invalid_argument("CKKS encrypted must be in NTT form");
+        }
+
+        // Extract encryption parameters.
+        auto &context_data = *context_data_ptr;
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+        size_t encrypted_size = encrypted.size();
+
+        // Size check
+        if (!product_fits_in(encrypted_size, coeff_count, coeff_mod_count))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        double new_scale = encrypted.scale() * scale;
+
+        // Check that scale is positive and not too large
+        if (scale <= 0 || new_scale <= 0 || (static_cast<int>(log2(new_scale)) >=
+            context_data.total_coeff_modulus_bit_count()))
+        {
+            throw invalid_argument("scale out of bounds");
+        }
+
+        // The scalar encodes to the constant polynomial round(scalar * scale)
+        double scaled_scalar = round(scalar * scale);
+        double two_pow_63 = static_cast<double>(uint64_t(1) << 63);
+        if (!(fabs(scaled_scalar) < two_pow_63))
+        {
+            throw invalid_argument("scalar out of bounds");
+        }
+        bool is_negative = scaled_scalar < 0;
+        uint64_t scaled_scalar_abs = static_cast<uint64_t>(fabs(scaled_scalar));
+#ifdef SEAL_THROW_ON_MULTIPLY_PLAIN_BY_ZERO
+        if (!scaled_scalar_abs)
+        {
+            throw invalid_argument("scalar cannot be zero");
+        }
+#endif
+        for (size_t j = 0; j < coeff_mod_count; j++)
+        {
+            uint64_t scalar_mod_coeff = scaled_scalar_abs % coeff_modulus[j].value();
+            if (is_negative)
+            {
+                scalar_mod_coeff = negate_uint_mod(scalar_mod_coeff, coeff_modulus[j]);
+            }
+            for (size_t i = 0; i < encrypted_size; i++)
+            {
+                multiply_poly_scalar_coeffmod(encrypted.data(i) + (j * coeff_count),
+                    coeff_count, scalar_mod_coeff, coeff_modulus[j],
+                    encrypted.data(i) + (j * coeff_count));
+            }
+        }
+
+        encrypted.scale() = new_scale;
+    }
+
+    void Evaluator::multiply_monomial_inplace(Ciphertext &encrypted, uint64_t coeff,
+        size_t exponent, MemoryPoolHandle pool)
+    {
+        // Verify parameters.
+        auto context_data_ptr = context_->context_data(encrypted.parms_id());
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // Extract encryption parameters.
+        auto &context_data = *context_data_ptr;
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+        size_t encrypted_size = encrypted.size();
+
+        // Size check
+        if (!product_fits_in(encrypted_size, coeff_count, coeff_mod_count))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        vector<uint64_t> coeff_mod_coeff(coeff_mod_count);
+        switch (parms.scheme())
+        {
+        case scheme_type::BFV:
+            coeff %= parms.plain_modulus().value();
+            for (size_t j = 0; j < coeff_mod_count; j++)
+            {
+                coeff_mod_coeff[j] = lift_plain_scalar(coeff, context_data, j);
+            }
+            break;
+
+        case scheme_type::CKKS:
+            for (size_t j = 0; j < coeff_mod_count; j++)
+            {
+                coeff_mod_coeff[j] = coeff % coeff_modulus[j].value();
+            }
+            break;
+
+        default:
+            throw invalid_argument("unsupported scheme");
+        }
+#ifdef SEAL_THROW_ON_MULTIPLY_PLAIN_BY_ZERO
+        if (!coeff)
+        {
+            throw invalid_argument("coeff cannot be zero");
+        }
+#endif
+        // X^(2N) = 1 in the negacyclic ring
+        exponent &= (coeff_count << 1) - 1;
+
+        // The shift is done in coefficient form. A BFV ciphertext tracked lazily is
+        // left there; any other ciphertext is returned to NTT form afterwards.
+        bool is_ntt_form = encrypted.is_ntt_form();
+        if (is_ntt_form)
+        {
+            transform_from_ntt_inplace(encrypted);
+        }
+
+        auto temp(allocate_uint(coeff_count, pool));
+        for (size_t i = 0; i < encrypted_size; i++)
+        {
+            for (size_t j = 0; j < coeff_mod_count; j++)
+            {
+                uint64_t *encrypted_ptr = encrypted.data(i) + (j * coeff_count);
+                negacyclic_shift_poly_coeffmod(encrypted_ptr, coeff_count, exponent,
+                    coeff_modulus[j], temp.get());
+                multiply_poly_scalar_coeffmod(temp.get(), coeff_count,
+                    coeff_mod_coeff[j], coeff_modulus[j], encrypted_ptr);
+            }
+        }
+
+        if (is_ntt_form && !(lazy_ntt_form_ && parms.scheme() == scheme_type::BFV))
+        {
+            transform_to_ntt_inplace(encrypted);
+        }
+    }
+
+    void Evaluator::add_scalar_inplace(Ciphertext &encrypted, uint64_t scalar)
+    {
+        // Verify parameters.
+        auto context_data_ptr = context_->context_data(encrypted.parms_id());
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (context_data_ptr->parms().scheme() != scheme_type::BFV)
+        {
+            throw logic_error("unsupported scheme");
+        }
+
+        // Extract encryption parameters.
+        auto &context_data = *context_data_ptr;
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+
+        // Size check
+        if (!product_fits_in(coeff_count, coeff_mod_count))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        // This is add_plain for a constant plaintext: only the constant coefficient 
+        // of c0 changes in coefficient form, and every coefficient in NTT form.
+        scalar %= parms.plain_modulus().value();
+        auto coeff_div_plain_modulus = context_data.coeff_div_plain_modulus();
+        auto upper_half_increment = context_data.upper_half_increment();
+        for (size_t j = 0; j < coeff_mod_count; j++)
+        {
+            // This is Encryptor::preencrypt for a single coefficient
+            uint64_t scaled_scalar;
+            if (scalar >= context_data.plain_upper_half_threshold())
+            {
+                unsigned long long temp[2]{ 0, 0 };
+                multiply_uint64(coeff_div_plain_modulus[j], scalar, temp);
+                temp[1] += add_uint64(temp[0], upper_half_increment[j], temp);
+                scaled_scalar = barrett_reduce_128(temp, coeff_modulus[j]);
+            }
+            else
+            {
+                scaled_scalar = multiply_uint_uint_mod(
+                    coeff_div_plain_modulus[j], scalar, coeff_modulus[j]);
+            }
+
+            uint64_t *encrypted_ptr = encrypted.data() + (j * coeff_count);
+            size_t count = encrypted.is_ntt_form() ? coeff_count : 1;
+            for (size_t i = 0; i < count; i++)
+            {
+                encrypted_ptr[i] = add_uint_uint_mod(encrypted_ptr[i], scaled_scalar,
+                    coeff_modulus[j]);
+            }
+        }
+    }
+
+    void Evaluator::transform_to_ntt_inplace(Plaintext &plain, 
+        parms_id_type parms_id, MemoryPoolHandle pool)
+    {
+        // Verify parameters.
+        auto context_data_ptr = context_->context_data(parms_id);
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("parms_id is not valid for the current context");
+        }
+        if (plain.is_ntt_form())
+        {
+            throw invalid_argument("plain is already in NTT form");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // Extract encryption parameters.
+        auto &context_data = *context_data_ptr;
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+        size_t plain_coeff_count = plain.coeff_count();
+
+        auto plain_upper_half_threshold = context_data.plain_upper_half_threshold();
+        auto plain_upper_half_increment = context_data.plain_upper_half_increment();
+
+        // Verify more parameters.
+        if (plain.coeff_count() > coeff_count)
+        {
+            throw invalid_argument("plain is not valid for encryption parameters");
+        }
+#ifdef SEAL_DEBUG
+        if (!are_poly_coefficients_less_than(plain.data(),
+            plain.coeff_count(), parms.plain_modulus().value()))
+        {
+            throw invalid_argument("plain is not valid for encryption parameters");
+        }
+#endif
+        auto &coeff_small_ntt_tables = context_data.small_ntt_tables();
 
         // Size check
         if (!product_fits_in(coeff_count, coeff_mod_count))
@@ -2924,14 +3734,18 @@ namespace seal
         {
             throw invalid_argument("encrypted is not valid for encryption parameters");
         }
-        if (galois_keys.parms_id() != context_->first_parms_id())
+        if (!is_key_level_valid(galois_keys.parms_id(), *context_data_ptr))
         {
             throw invalid_argument("parameter mismatch");
         }
         if (context_data_ptr->parms().scheme() == scheme_type::BFV && 
             encrypted.is_ntt_form())
         {
-            throw invalid_argument("BFV encrypted cannot be in NTT form");
+            if (!lazy_ntt_form_)
+            {
+                throw invalid_argument("BFV encrypted cannot be in NTT form");
+            }
+            transform_from_ntt_inplace(encrypted);
         }
         if (context_data_ptr->parms().scheme() == scheme_type::CKKS && 
             !encrypted.is_ntt_form())
@@ -2959,7 +3773,6 @@ namespace seal
 
         uint64_t m = mul_safe(static_cast<uint64_t>(coeff_count), uint64_t(2));
         uint64_t subgroup_size = static_cast<uint64_t>(coeff_count >> 1);
-        int n_power_of_two = get_power_of_two(static_cast<uint64_t>(coeff_count));
 
         // Verify parameters
         if (!(galois_elt & 1) || unsigned_geq(galois_elt, m))
@@ -2971,11 +3784,6 @@ namespace seal
             throw invalid_argument("encrypted size must be 2");
         }
 
-        auto &first_context_data = *context_->context_data();
-        auto &inv_coeff_products_mod_coeff_array =
-            first_context_data.base_converter()->get_inv_coeff_mod_coeff_array();
-        auto &coeff_small_ntt_tables = first_context_data.small_ntt_tables();
-
         // Check if Galois key is generated or not.
         // If not, attempt a bit decomposition; maybe we have log(n) many keys
         if (!galois_keys.has_key(galois_elt))
@@ -3019,188 +3827,551 @@ namespace seal
             return;
         }
 
-        auto temp0(allocate_zero_uint(coeff_count * coeff_mod_count, pool));
-        auto temp1(allocate_zero_uint(coeff_count * coeff_mod_count, pool));
+        apply_galois_with_key({ &encrypted }, galois_elt, galois_keys, pool);
+    }
 
-        if (context_data_ptr->parms().scheme() == scheme_type::BFV)
+    void Evaluator::apply_galois_batch(vector<Ciphertext> &encrypteds,
+        uint64_t galois_elt, const GaloisKeys &galois_keys, MemoryPoolHandle pool)
+    {
+        if (encrypteds.empty())
         {
-            // Apply Galois for each ciphertext
-            for (size_t i = 0; i < coeff_mod_count; i++)
+            return;
+        }
+
+        // Verify parameters.
+        auto context_data_ptr = context_->context_data(encrypteds[0].parms_id());
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (!is_key_level_valid(galois_keys.parms_id(), *context_data_ptr))
+        {
+            throw invalid_argument("parameter mismatch");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+        for (auto &encrypted : encrypteds)
+        {
+            if (encrypted.parms_id() != encrypteds[0].parms_id())
             {
-                util::apply_galois(encrypted.data() + (i * coeff_count), n_power_of_two,
-                    galois_elt, coeff_modulus[i], temp0.get() + (i * coeff_count));
+                throw invalid_argument("encrypteds do not match");
             }
-            for (size_t i = 0; i < coeff_mod_count; i++)
+            if (context_data_ptr->parms().scheme() == scheme_type::BFV &&
+                encrypted.is_ntt_form())
             {
-                util::apply_galois(encrypted.data(1) + (i * coeff_count), n_power_of_two,
-                    galois_elt, coeff_modulus[i], temp1.get() + (i * coeff_count));
+                if (!lazy_ntt_form_)
+                {
+                    throw invalid_argument("BFV encrypted cannot be in NTT form");
+                }
+                transform_from_ntt_inplace(encrypted);
             }
+            if (context_data_ptr->parms().scheme() == scheme_type::CKKS &&
+                !encrypted.is_ntt_form())
+            {
+                throw invalid_argument("CKKS encrypted must be in NTT form");
+            }
+            if (encrypted.size() > 2)
+            {
+                throw invalid_argument("encrypted size must be 2");
+            }
+        }
+
+        // Extract encryption parameters.
+        auto &parms = context_data_ptr->parms();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = parms.coeff_modulus().size();
+
+        // Size check
+        if (!product_fits_in(coeff_count, coeff_mod_count))
+        {
+            throw logic_error("invalid parameters");
         }
-        else if (context_data_ptr->parms().scheme() == scheme_type::CKKS)
+
+        // Verify parameters
+        uint64_t m = mul_safe(static_cast<uint64_t>(coeff_count), uint64_t(2));
+        if (!(galois_elt & 1) || unsigned_geq(galois_elt, m))
         {
-            // Apply Galois for each ciphertext
-            for (size_t i = 0; i < coeff_mod_count; i++)
+            throw invalid_argument("galois element is not valid");
+        }
+
+        // Without a key of its own the automorphism is composed out of several
+        // key switchings; batching does not apply.
+        if (!galois_keys.has_key(galois_elt))
+        {
+            for (auto &encrypted : encrypteds)
             {
-                util::apply_galois_ntt(encrypted.data() + (i * coeff_count), n_power_of_two,
-                    galois_elt, temp0.get() + (i * coeff_count));
+                apply_galois_inplace(encrypted, galois_elt, galois_keys, pool);
             }
-            for (size_t i = 0; i < coeff_mod_count; i++)
+            return;
+        }
+
+        vector<Ciphertext *> encrypted_ptrs;
+        encrypted_ptrs.reserve(encrypteds.size());
+        for (auto &encrypted : encrypteds)
+        {
+            encrypted_ptrs.push_back(&encrypted);
+        }
+        apply_galois_with_key(encrypted_ptrs, galois_elt, galois_keys, pool);
+    }
+
+    void Evaluator::apply_galois_with_key(const vector<Ciphertext *> &encrypteds,
+        uint64_t galois_elt, const GaloisKeys &galois_keys, MemoryPool &pool)
+    {
+        // Extract encryption parameters.
+        auto &context_data = *context_->context_data(encrypteds[0]->parms_id());
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+        size_t batch_size = encrypteds.size();
+        int n_power_of_two = get_power_of_two(static_cast<uint64_t>(coeff_count));
+
+        // Size check
+        if (!product_fits_in(batch_size, coeff_count, coeff_mod_count, size_t(2)))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        // n * number of factors in q_l
+        size_t rns_poly_uint64_count = coeff_count * coeff_mod_count;
+
+        auto &coeff_small_ntt_tables = context_->context_data()->small_ntt_tables();
+
+        auto temp0(allocate_uint(batch_size * rns_poly_uint64_count, pool));
+        auto temp1(allocate_uint(batch_size * rns_poly_uint64_count, pool));
+        vector<const uint64_t *> temp1_ptrs;
+        for (size_t b = 0; b < batch_size; b++)
+        {
+            const Ciphertext &encrypted = *encrypteds[b];
+            uint64_t *temp0_ptr = temp0.get() + (b * rns_poly_uint64_count);
+            uint64_t *temp1_ptr = temp1.get() + (b * rns_poly_uint64_count);
+            if (parms.scheme() == scheme_type::BFV)
             {
-                util::apply_galois_ntt(encrypted.data(1) + (i * coeff_count), n_power_of_two,
-                    galois_elt, temp1.get() + (i * coeff_count));
+                // Apply Galois for each ciphertext
+                for (size_t i = 0; i < coeff_mod_count; i++)
+                {
+                    util::apply_galois(encrypted.data() + (i * coeff_count), n_power_of_two,
+                        galois_elt, coeff_modulus[i], temp0_ptr + (i * coeff_count));
+                }
+                for (size_t i = 0; i < coeff_mod_count; i++)
+                {
+                    util::apply_galois(encrypted.data(1) + (i * coeff_count), n_power_of_two,
+                        galois_elt, coeff_modulus[i], temp1_ptr + (i * coeff_count));
+                }
             }
+            else if (parms.scheme() == scheme_type::CKKS)
+            {
+                // Apply Galois for each ciphertext
+                auto permutation = context_->galois_tool()->permutation_ntt(galois_elt);
+                for (size_t i = 0; i < coeff_mod_count; i++)
+                {
+                    util::apply_galois_ntt(encrypted.data() + (i * coeff_count),
+                        coeff_count, permutation, temp0_ptr + (i * coeff_count));
+                }
+                for (size_t i = 0; i < coeff_mod_count; i++)
+                {
+                    util::apply_galois_ntt(encrypted.data(1) + (i * coeff_count),
+                        coeff_count, permutation, temp1_ptr + (i * coeff_count));
+                }
 
-            // Transform ct[1] from NTT
-            for (size_t i = 0; i < coeff_mod_count; i++)
+                // Transform ct[1] from NTT
+                for (size_t i = 0; i < coeff_mod_count; i++)
+                {
+                    inverse_ntt_negacyclic_harvey(temp1_ptr + (i * coeff_count),
+                        coeff_small_ntt_tables[i]);
+                }
+            }
+            else
             {
-                inverse_ntt_negacyclic_harvey(temp1.get() + (i * coeff_count),
-                    coeff_small_ntt_tables[i]);
+                throw logic_error("scheme not implemented");
             }
+            temp1_ptrs.push_back(temp1_ptr);
         }
-        else
+
+        // Calculate (temp1 * galois_key.first, temp1 * galois_key.second) + (temp0, 0)
+        auto innerresult(allocate_uint(batch_size * 2 * rns_poly_uint64_count, pool));
+        vector<uint64_t *> innerresult_ptrs;
+        for (size_t b = 0; b < batch_size; b++)
+        {
+            innerresult_ptrs.push_back(innerresult.get() + (b * 2 * rns_poly_uint64_count));
+        }
+        switch_key_inner_product(temp1_ptrs, galois_keys.key(galois_elt),
+            galois_keys.decomposition_bit_count(), context_data, innerresult_ptrs, pool);
+
+        for (size_t b = 0; b < batch_size; b++)
+        {
+            Ciphertext &encrypted = *encrypteds[b];
+            uint64_t *temp_ptr = temp0.get() + (b * rns_poly_uint64_count);
+            uint64_t *innerresult0_ptr = innerresult_ptrs[b];
+            uint64_t *innerresult1_ptr = innerresult0_ptr + rns_poly_uint64_count;
+            uint64_t *encrypted0_ptr = encrypted.data();
+            uint64_t *encrypted1_ptr = encrypted.data(1);
+            for (size_t i = 0; i < coeff_mod_count; i++, temp_ptr += coeff_count,
+                innerresult0_ptr += coeff_count, innerresult1_ptr += coeff_count,
+                encrypted0_ptr += coeff_count, encrypted1_ptr += coeff_count)
+            {
+                if (parms.scheme() == scheme_type::BFV)
+                {
+                    inverse_ntt_negacyclic_harvey(innerresult0_ptr,
+                        coeff_small_ntt_tables[i]);
+                    inverse_ntt_negacyclic_harvey(innerresult1_ptr,
+                        coeff_small_ntt_tables[i]);
+                }
+                add_poly_poly_coeffmod(temp_ptr, innerresult0_ptr, coeff_count,
+                    coeff_modulus[i], encrypted0_ptr);
+                set_uint_uint(innerresult1_ptr, coeff_count, encrypted1_ptr);
+            }
+
+            // If CKKS, mark encrypted as NTT form
+            if (parms.scheme() == scheme_type::CKKS)
+            {
+                encrypted.is_ntt_form() = true;
+            }
+        }
+    }
+
+    void Evaluator::rotate_internal(Ciphertext &encrypted, int steps,
+        const GaloisKeys &galois_keys, MemoryPoolHandle pool)
+    {
+        // Verify parameters.
+        auto context_data_ptr = context_->context_data(encrypted.parms_id());
+        if (!context_data_ptr)
         {
-            throw logic_error("scheme not implemented");
+            throw invalid_argument("encrypted is not valid for encryption parameters");
         }
 
-        // Calculate (temp1 * galois_key.first, temp1 * galois_key.second) + (temp0, 0)
-        const uint64_t *encrypted_coeff = temp1.get();
-        auto encrypted_coeff_prod_inv_coeff(allocate_uint(coeff_count, pool));
+        // Extract encryption parameters.
+        auto &context_data = *context_data_ptr;
+        if (!context_data.qualifiers().using_batching)
+        {
+            throw logic_error("encryption parameters do not support batching");
+        }
 
-        // decompose encrypted_array[count-1] into base w
-        // want to create an array of polys, each of whose components i is
-        // (encrypted_array[count-1])^(i) - in the notation of FV paper.
-        // This allocation stores one of the decomposed factors modulo one of the primes.
-        auto decomp_encrypted_last(allocate_uint(coeff_count, pool));
+        // Is there anything to do?
+        if (steps == 0)
+        {
+            return;
+        }
 
-        // Lazy reduction
-        auto wide_innerresult0(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        auto wide_innerresult1(allocate_zero_poly(coeff_count, 2 * coeff_mod_count, pool));
-        auto innerresult(allocate_poly(coeff_count, coeff_mod_count, pool));
-        auto temp_decomp_coeff(allocate_uint(coeff_count, pool));
+        auto &parms = context_data.parms();
+        size_t coeff_count = parms.poly_modulus_degree();
 
-        /*
-        For lazy reduction to work here, we need to ensure that the 128-bit accumulators
-        (wide_innerresult0 and wide_innerresult1) do not overflow. Since the modulus primes
-        are at most 60 bits, if the total number of summands is K, then the size of the
-        total sum of products (without reduction) is at most 62 + 60 + bit_length(K).
-        We need this to be at most 128, thus we need bit_length(K) <= 6. Thus, we need K <= 63.
-        In this case, this means sum_i galois_keys.key(galois_elt)[i].size() / 2 <= 63.
-        */
-        for (size_t i = 0; i < coeff_mod_count; i++)
+        // Perform rotation and key switching
+        apply_galois_inplace(encrypted, 
+            steps_to_galois_elt(steps, coeff_count), 
+            galois_keys, move(pool));
+    }
+
+    void Evaluator::apply_galois_many(const Ciphertext &encrypted,
+        const vector<uint64_t> &galois_elts, const GaloisKeys &galois_keys,
+        vector<Ciphertext> &destinations, MemoryPoolHandle pool)
+    {
+        // Verify parameters.
+        auto context_data_ptr = context_->context_data(encrypted.parms_id());
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("encrypted is not valid for encryption parameters");
+        }
+        if (!is_key_level_valid(galois_keys.parms_id(), *context_data_ptr))
+        {
+            throw invalid_argument("parameter mismatch");
+        }
+        if (context_data_ptr->parms().scheme() == scheme_type::BFV &&
+            encrypted.is_ntt_form())
+        {
+            if (!lazy_ntt_form_)
+            {
+                throw invalid_argument("BFV encrypted cannot be in NTT form");
+            }
+            Ciphertext encrypted_coeff(pool);
+            transform_from_ntt(encrypted, encrypted_coeff);
+            apply_galois_many(encrypted_coeff, galois_elts, galois_keys,
+                destinations, move(pool));
+            return;
+        }
+        if (context_data_ptr->parms().scheme() == scheme_type::CKKS &&
+            !encrypted.is_ntt_form())
+        {
+            throw invalid_argument("CKKS encrypted must be in NTT form");
+        }
+        if (!pool)
+        {
+            throw invalid_argument("pool is uninitialized");
+        }
+
+        // Extract encryption parameters.
+        auto &context_data = *context_data_ptr;
+        auto &parms = context_data.parms();
+        auto &coeff_modulus = parms.coeff_modulus();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = coeff_modulus.size();
+        size_t encrypted_size = encrypted.size();
+        bool is_bfv = (parms.scheme() == scheme_type::BFV);
+
+        // Size check
+        if (!product_fits_in(coeff_count, coeff_mod_count))
         {
-            multiply_poly_scalar_coeffmod(
-                encrypted_coeff + (i * coeff_count), coeff_count,
-                inv_coeff_products_mod_coeff_array[i], coeff_modulus[i],
-                encrypted_coeff_prod_inv_coeff.get());
+            throw logic_error("invalid parameters");
+        }
+
+        uint64_t m = mul_safe(static_cast<uint64_t>(coeff_count), uint64_t(2));
+        int n_power_of_two = get_power_of_two(static_cast<uint64_t>(coeff_count));
 
-            int shift = 0;
-            auto &key_component_ref = galois_keys.key(galois_elt)[i];
-            size_t keys_size = key_component_ref.size();
-            for (size_t k = 0; k < keys_size; k += 2)
+        // Verify parameters
+        for (auto galois_elt : galois_elts)
+        {
+            if (!(galois_elt & 1) || unsigned_geq(galois_elt, m))
             {
-                const uint64_t *key_ptr_0 = key_component_ref.data(k);
-                const uint64_t *key_ptr_1 = key_component_ref.data(k + 1);
+                throw invalid_argument("galois element is not valid");
+            }
+        }
+        if (encrypted_size > 2)
+        {
+            throw invalid_argument("encrypted size must be 2");
+        }
 
-                // Decompose here
-                int decomposition_bit_count = galois_keys.decomposition_bit_count();
-                for (size_t coeff_index = 0; coeff_index < coeff_count; coeff_index++)
+        auto &key_context_data = *context_->context_data(galois_keys.parms_id());
+        auto &inv_coeff_products_mod_coeff_array =
+            key_context_data.base_converter()->get_inv_coeff_mod_coeff_array();
+        auto &coeff_small_ntt_tables = key_context_data.small_ntt_tables();
+        int decomposition_bit_count = galois_keys.decomposition_bit_count();
+
+        // Only Galois elements with a key of their own can share the decomposition;
+        // all others go through apply_galois_inplace, which composes the automorphism
+        // out of several key switchings.
+        const vector<Ciphertext> *hoisted_key = nullptr;
+        for (auto galois_elt : galois_elts)
+        {
+            if (!galois_keys.has_key(galois_elt))
+            {
+                continue;
+            }
+            if (!hoisted_key)
+            {
+                hoisted_key = &galois_keys.key(galois_elt);
+                continue;
+            }
+            for (size_t i = 0; i < coeff_mod_count; i++)
+            {
+                if (galois_keys.key(galois_elt)[i].size() != (*hoisted_key)[i].size())
                 {
-                    decomp_encrypted_last[coeff_index] = 
-                        encrypted_coeff_prod_inv_coeff[coeff_index] >> shift;
-                    decomp_encrypted_last[coeff_index] &= 
-                        (uint64_t(1) << decomposition_bit_count) - 1;
+                    throw invalid_argument("galois_keys is not valid");
                 }
+            }
+        }
 
-                uint64_t *wide_innerresult0_ptr = wide_innerresult0.get();
-                uint64_t *wide_innerresult1_ptr = wide_innerresult1.get();
-                for (size_t j = 0; j < coeff_mod_count; j++)
+        // Count the decomposition factors over all primes
+        size_t decomp_count = 0;
+        if (hoisted_key)
+        {
+            for (size_t i = 0; i < coeff_mod_count; i++)
+            {
+                decomp_count += (*hoisted_key)[i].size() / 2;
+            }
+        }
+
+        // Decompose encrypted.data(1) once. Each decomposed factor is stored modulo
+        // every prime j in (lazy) NTT form at index (factor * coeff_mod_count + j).
+        // A Galois automorphism only permutes the NTT coefficients of a factor, and
+        // takes a factor with coefficients in [0, w) to one with coefficients in
+        // (-w, w), so the noise growth is the same as in apply_galois_inplace.
+        auto decomp_ntt(allocate_uint(
+            mul_safe(decomp_count, coeff_mod_count, coeff_count), pool));
+        if (hoisted_key)
+        {
+            auto temp1(allocate_uint(coeff_count * coeff_mod_count, pool));
+            set_uint_uint(encrypted.data(1), coeff_count * coeff_mod_count, temp1.get());
+            if (!is_bfv)
+            {
+                // Transform ct[1] from NTT
+                for (size_t i = 0; i < coeff_mod_count; i++)
                 {
-                    uint64_t *temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    set_uint_uint(decomp_encrypted_last.get(), coeff_count, temp_decomp_coeff_ptr);
+                    inverse_ntt_negacyclic_harvey(temp1.get() + (i * coeff_count),
+                        coeff_small_ntt_tables[i]);
+                }
+            }
 
-                    // We don't reduce here, so might get up to two extra bits. Thus 62 bits at most.
-                    ntt_negacyclic_harvey_lazy(temp_decomp_coeff_ptr, coeff_small_ntt_tables[j]);
+            auto encrypted_coeff_prod_inv_coeff(allocate_uint(coeff_count, pool));
+            uint64_t *decomp_ptr = decomp_ntt.get();
+            for (size_t i = 0; i < coeff_mod_count; i++)
+            {
+                multiply_poly_scalar_coeffmod(
+                    temp1.get() + (i * coeff_count), coeff_count,
+                    inv_coeff_products_mod_coeff_array[i], coeff_modulus[i],
+                    encrypted_coeff_prod_inv_coeff.get());
 
-                    // Lazy reduction
-                    unsigned long long wide_innerproduct[2];
-                    unsigned long long temp;
-                    for (size_t l = 0; l < coeff_count; l++, wide_innerresult0_ptr += 2)
+                int shift = 0;
+                size_t keys_size = (*hoisted_key)[i].size();
+                for (size_t k = 0; k < keys_size; k += 2)
+                {
+                    // Decompose here
+                    for (size_t coeff_index = 0; coeff_index < coeff_count; coeff_index++)
                     {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_0++, wide_innerproduct);
-                        unsigned char carry = add_uint64(wide_innerresult0_ptr[0],
-                            wide_innerproduct[0], &temp);
-                        wide_innerresult0_ptr[0] = temp;
-                        wide_innerresult0_ptr[1] += wide_innerproduct[1] + carry;
+                        decomp_ptr[coeff_index] =
+                            encrypted_coeff_prod_inv_coeff[coeff_index] >> shift;
+                        decomp_ptr[coeff_index] &=
+                            (uint64_t(1) << decomposition_bit_count) - 1;
                     }
-
-                    temp_decomp_coeff_ptr = temp_decomp_coeff.get();
-                    for (size_t l = 0; l < coeff_count; l++, wide_innerresult1_ptr += 2)
+                    for (size_t j = 1; j < coeff_mod_count; j++)
                     {
-                        multiply_uint64(*temp_decomp_coeff_ptr++, *key_ptr_1++, wide_innerproduct);
-                        unsigned char carry = add_uint64(wide_innerresult1_ptr[0],
-                            wide_innerproduct[0], &temp);
-                        wide_innerresult1_ptr[0] = temp;
-                        wide_innerresult1_ptr[1] += wide_innerproduct[1] + carry;
+                        set_uint_uint(decomp_ptr, coeff_count,
+                            decomp_ptr + (j * coeff_count));
                     }
+                    for (size_t j = 0; j < coeff_mod_count; j++, decomp_ptr += coeff_count)
+                    {
+                        // We don't reduce here, so might get up to two extra bits.
+                        // Thus 62 bits at most.
+                        ntt_negacyclic_harvey_lazy(decomp_ptr, coeff_small_ntt_tables[j]);
+                    }
+                    shift += decomposition_bit_count;
                 }
-                shift += decomposition_bit_count;
             }
         }
 
-        uint64_t *temp_ptr = temp0.get();
-        uint64_t *innerresult_poly_ptr = innerresult.get();
-        uint64_t *wide_innerresult_poly_ptr = wide_innerresult0.get();
-        uint64_t *encrypted_ptr = encrypted.data();
-        uint64_t *innerresult_coeff_ptr = innerresult_poly_ptr;
-        uint64_t *wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (size_t i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count,
-            temp_ptr += coeff_count)
+        // Results are collected separately so that encrypted may alias one of the
+        // destinations.
+        vector<Ciphertext> results;
+        results.reserve(galois_elts.size());
+
+        // The accumulators share one summand count, so the smallest bound applies
+        uint64_t summand_bound = numeric_limits<uint64_t>::max();
+        for (size_t j = 0; j < coeff_mod_count; j++)
         {
-            for (size_t k = 0; k < coeff_count; 
-                k++, wide_innerresult_coeff_ptr += 2, innerresult_coeff_ptr++)
+            summand_bound = min(summand_bound, lazy_reduction_summand_bound(coeff_modulus[j]));
+        }
+
+        auto temp0(allocate_uint(coeff_count * coeff_mod_count, pool));
+        auto permuted_decomp(allocate_uint(coeff_count, pool));
+        auto wide_innerresult0(allocate_poly(coeff_count, 2 * coeff_mod_count, pool));
+        auto wide_innerresult1(allocate_poly(coeff_count, 2 * coeff_mod_count, pool));
+        for (auto galois_elt : galois_elts)
+        {
+            results.emplace_back(pool);
+            Ciphertext &result = results.back();
+
+            if (!galois_keys.has_key(galois_elt))
             {
-                *innerresult_coeff_ptr = barrett_reduce_128(
-                    wide_innerresult_coeff_ptr, coeff_modulus[i]);
+                result = encrypted;
+                apply_galois_inplace(result, galois_elt, galois_keys, pool);
+                continue;
             }
-            if (context_data_ptr->parms().scheme() == scheme_type::BFV)
+
+            // Apply Galois to ct[0]
+            auto permutation = context_->galois_tool()->permutation_ntt(galois_elt);
+            for (size_t i = 0; i < coeff_mod_count; i++)
             {
-                inverse_ntt_negacyclic_harvey(innerresult_poly_ptr, 
-                    coeff_small_ntt_tables[i]);
+                if (is_bfv)
+                {
+                    util::apply_galois(encrypted.data() + (i * coeff_count), n_power_of_two,
+                        galois_elt, coeff_modulus[i], temp0.get() + (i * coeff_count));
+                }
+                else
+                {
+                    util::apply_galois_ntt(encrypted.data() + (i * coeff_count),
+                        coeff_count, permutation, temp0.get() + (i * coeff_count));
+                }
             }
-            add_poly_poly_coeffmod(temp_ptr, innerresult_poly_ptr, coeff_count,
-                coeff_modulus[i], encrypted_ptr);
-        }
 
-        innerresult_poly_ptr = innerresult.get();
-        wide_innerresult_poly_ptr = wide_innerresult1.get();
-        encrypted_ptr = encrypted.data(1);
-        wide_innerresult_coeff_ptr = wide_innerresult_poly_ptr;
-        for (size_t i = 0; i < coeff_mod_count; i++, innerresult_poly_ptr += coeff_count,
-            wide_innerresult_poly_ptr += 2 * coeff_count, encrypted_ptr += coeff_count)
-        {
-            innerresult_coeff_ptr = encrypted_ptr;
-            for (size_t k = 0; k < coeff_count; 
-                k++, wide_innerresult_coeff_ptr += 2, innerresult_coeff_ptr++)
+            // Lazy reduction; the accumulators are reduced in between only if the
+            // number of decomposition factors exceeds summand_bound
+            set_zero_uint(2 * coeff_count * coeff_mod_count, wide_innerresult0.get());
+            set_zero_uint(2 * coeff_count * coeff_mod_count, wide_innerresult1.get());
+            uint64_t summand_count = 0;
+            const uint64_t *decomp_ptr = decomp_ntt.get();
+            for (size_t i = 0; i < coeff_mod_count; i++)
             {
-                *innerresult_coeff_ptr = barrett_reduce_128(
-                    wide_innerresult_coeff_ptr, coeff_modulus[i]);
+                auto &key_component_ref = galois_keys.key(galois_elt)[i];
+                size_t keys_size = key_component_ref.size();
+                for (size_t k = 0; k < keys_size; k += 2)
+                {
+                    const uint64_t *key_ptr_0 = key_component_ref.data(k);
+                    const uint64_t *key_ptr_1 = key_component_ref.data(k + 1);
+
+                    if (summand_count == summand_bound)
+                    {
+                        for (size_t j = 0; j < coeff_mod_count; j++)
+                        {
+                            reduce_wide_accumulator(
+                                wide_innerresult0.get() + (2 * j * coeff_count),
+                                coeff_count, coeff_modulus[j]);
+                            reduce_wide_accumulator(
+                                wide_innerresult1.get() + (2 * j * coeff_count),
+                                coeff_count, coeff_modulus[j]);
+                        }
+                        summand_count = 0;
+                    }
+                    summand_count++;
+
+                    uint64_t *wide_innerresult0_ptr = wide_innerresult0.get();
+                    uint64_t *wide_innerresult1_ptr = wide_innerresult1.get();
+                    for (size_t j = 0; j < coeff_mod_count; j++, decomp_ptr += coeff_count)
+                    {
+                        uint64_t *permuted_decomp_ptr = permuted_decomp.get();
+                        util::apply_galois_ntt(decomp_ptr, coeff_count, permutation,
+                            permuted_decomp_ptr);
+
+                        unsigned long long wide_innerproduct[2];
+                        unsigned long long temp;
+                        for (size_t l = 0; l < coeff_count; l++, wide_innerresult0_ptr += 2)
+                        {
+                            multiply_uint64(*permuted_decomp_ptr++, *key_ptr_0++,
+                                wide_innerproduct);
+                            unsigned char carry = add_uint64(wide_innerresult0_ptr[0],
+                                wide_innerproduct[0], &temp);
+                            wide_innerresult0_ptr[0] = temp;
+                            wide_innerresult0_ptr[1] += wide_innerproduct[1] + carry;
+                        }
+
+                        permuted_decomp_ptr = permuted_decomp.get();
+                        for (size_t l = 0; l < coeff_count; l++, wide_innerresult1_ptr += 2)
+                        {
+                            multiply_uint64(*permuted_decomp_ptr++, *key_ptr_1++,
+                                wide_innerproduct);
+                            unsigned char carry = add_uint64(wide_innerresult1_ptr[0],
+                                wide_innerproduct[0], &temp);
+                            wide_innerresult1_ptr[0] = temp;
+                            wide_innerresult1_ptr[1] += wide_innerproduct[1] + carry;
+                        }
+                    }
+                }
             }
-            if (context_data_ptr->parms().scheme() == scheme_type::BFV)
+
+            result.resize(context_, encrypted.parms_id(), 2);
+            result.is_ntt_form() = encrypted.is_ntt_form();
+            result.scale() = encrypted.scale();
+            for (size_t i = 0; i < coeff_mod_count; i++)
             {
-                inverse_ntt_negacyclic_harvey(encrypted_ptr, coeff_small_ntt_tables[i]);
+                const uint64_t *wide_innerresult0_ptr =
+                    wide_innerresult0.get() + (2 * i * coeff_count);
+                const uint64_t *wide_innerresult1_ptr =
+                    wide_innerresult1.get() + (2 * i * coeff_count);
+                uint64_t *result0_ptr = result.data() + (i * coeff_count);
+                uint64_t *result1_ptr = result.data(1) + (i * coeff_count);
+                for (size_t k = 0; k < coeff_count; k++)
+                {
+                    result0_ptr[k] = barrett_reduce_128(
+                        wide_innerresult0_ptr + (2 * k), coeff_modulus[i]);
+                    result1_ptr[k] = barrett_reduce_128(
+                        wide_innerresult1_ptr + (2 * k), coeff_modulus[i]);
+                }
+                if (is_bfv)
+                {
+                    inverse_ntt_negacyclic_harvey(result0_ptr, coeff_small_ntt_tables[i]);
+                    inverse_ntt_negacyclic_harvey(result1_ptr, coeff_small_ntt_tables[i]);
+                }
+                add_poly_poly_coeffmod(temp0.get() + (i * coeff_count), result0_ptr,
+                    coeff_count, coeff_modulus[i], result0_ptr);
             }
         }
 
-        // If CKKS, mark encrypted as NTT form
-        if (context_data_ptr->parms().scheme() == scheme_type::CKKS)
-        {
-            encrypted.is_ntt_form() = true;
-        }
+        destinations.swap(results);
     }
 
-    void Evaluator::rotate_internal(Ciphertext &encrypted, int steps,
-        const GaloisKeys &galois_keys, MemoryPoolHandle pool)
+    void Evaluator::rotate_many(const Ciphertext &encrypted, const vector<int> &steps,
+        const GaloisKeys &galois_keys, vector<Ciphertext> &destinations,
+        MemoryPoolHandle pool)
     {
         // Verify parameters.
         auto context_data_ptr = context_->context_data(encrypted.parms_id());
@@ -3216,18 +4387,36 @@ namespace seal
             throw logic_error("encryption parameters do not support batching");
         }
 
-        // Is there anything to do?
-        if (steps == 0)
+        auto &parms = context_data.parms();
+        size_t coeff_count = parms.poly_modulus_degree();
+
+        // Zero steps need no key switching
+        vector<uint64_t> galois_elts;
+        for (auto step : steps)
         {
-            return;
+            if (step != 0)
+            {
+                galois_elts.push_back(steps_to_galois_elt(step, coeff_count));
+            }
         }
 
-        auto &parms = context_data.parms();
-        size_t coeff_count = parms.poly_modulus_degree();
+        vector<Ciphertext> rotated;
+        apply_galois_many(encrypted, galois_elts, galois_keys, rotated, move(pool));
 
-        // Perform rotation and key switching
-        apply_galois_inplace(encrypted, 
-            steps_to_galois_elt(steps, coeff_count), 
-            galois_keys, move(pool));
+        vector<Ciphertext> results;
+        results.reserve(steps.size());
+        auto rotated_iter = rotated.begin();
+        for (auto step : steps)
+        {
+            if (step == 0)
+            {
+                results.push_back(encrypted);
+            }
+            else
+            {
+                results.push_back(move(*rotated_iter++));
+            }
+        }
+        destinations.swap(results);
     }
 }
@@ -12,6 +12,8 @@
 #include "seal/memorymanager.h"
 #include "seal/ciphertext.h"
 #include "seal/plaintext.h"
+#include "seal/preparedplaintext.h"
+#include "seal/threadpool.h"
 #include "seal/galoiskeys.h"
 #include "seal/util/pointer.h"
 #include "seal/secretkey.h"
@@ -81,6 +83,16 @@ namespace seal
     and transform_from_ntt functions, which change the state. Ideally, unless these 
     two functions are called, all other functions should "just work".
 
+    @par Lazy NTT form tracking
+    When using the BFV scheme, plain multiplication transforms the ciphertext to
+    NTT form and back on every call. With lazy NTT form tracking enabled (see
+    set_lazy_ntt_form), BFV ciphertexts are instead left in NTT form by plain
+    multiplication, and stay in NTT form across further plain multiplications,
+    additions and subtractions. Operations that require the coefficient 
+    representation, such as multiply, relinearize, mod_switch_to_next and the
+    rotations, transform their inputs back automatically. Decryptor accepts BFV 
+    ciphertexts in either form.
+
     @see EncryptionParameters for more details on encryption parameters.
     @see BatchEncoder for more details on batching
     @see RelinKeys for more details on relinearization keys.
@@ -98,6 +110,29 @@ namespace seal
         */
         Evaluator(std::shared_ptr<SEALContext> context);
 
+        /**
+        Enables or disables lazy NTT form tracking for the BFV scheme. When enabled,
+        multiply_plain leaves BFV ciphertexts in NTT form, add, sub, add_plain, 
+        sub_plain and multiply_plain accept them in either form, and the functions 
+        that require the coefficient representation transform them back first. 
+        Ciphertexts given as const inputs are transformed in a temporary copy.
+        The setting has no effect for the CKKS scheme.
+
+        @param[in] enabled Whether to track the NTT form lazily
+        */
+        inline void set_lazy_ntt_form(bool enabled) noexcept
+        {
+            lazy_ntt_form_ = enabled;
+        }
+
+        /**
+        Returns whether lazy NTT form tracking is enabled.
+        */
+        inline bool lazy_ntt_form() const noexcept
+        {
+            return lazy_ntt_form_;
+        }
+
         /**
         Negates a ciphertext.
 
@@ -325,15 +360,15 @@ namespace seal
         @throws std::invalid_argument if encrypted or relin_keys is not valid for the
         encryption parameters
         @throws std::invalid_argument if encrypted is not in the default NTT form
-        @throws std::invalid_argument if relin_keys do not correspond to the top level
-        parameters in the current context
+        @throws std::invalid_argument if relin_keys were generated for a level below
+        the level of encrypted
         @throws std::invalid_argument if the size of relin_keys is too small
         @throws std::invalid_argument if pool is uninitialized
         */
         inline void relinearize_inplace(Ciphertext &encrypted, const RelinKeys &relin_keys,
             MemoryPoolHandle pool = MemoryManager::GetPool())
         {
-            relinearize_internal(encrypted, relin_keys, 2, std::move(pool));
+            relinearize_internal({ &encrypted }, relin_keys, 2, std::move(pool));
         }
 
         /**
@@ -350,8 +385,8 @@ namespace seal
         @throws std::invalid_argument if encrypted or relin_keys is not valid for the
         encryption parameters
         @throws std::invalid_argument if encrypted is not in the default NTT form
-        @throws std::invalid_argument if relin_keys do not correspond to the top level
-        parameters in the current context
+        @throws std::invalid_argument if relin_keys were generated for a level below
+        the level of encrypted
         @throws std::invalid_argument if the size of relin_keys is too small
         @throws std::invalid_argument if pool is uninitialized
         */
@@ -363,6 +398,32 @@ namespace seal
             relinearize_inplace(destination, relin_keys, std::move(pool));
         }
 
+        /**
+        Relinearizes a batch of ciphertexts, reducing the size of each of them down
+        to 2. The ciphertexts must all be at the same level and have the same size.
+        The work is tiled so that every relinearization key polynomial is loaded once
+        per batch and applied to all ciphertexts while it is still in cache, which
+        is considerably faster than relinearizing the ciphertexts one by one when
+        the keys do not fit in the cache. Dynamic memory allocations in the process
+        are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypteds The ciphertexts to relinearize
+        @param[in] relin_keys The relinearization keys
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypteds or relin_keys is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if encrypteds have different parameters, sizes
+        or NTT forms
+        @throws std::invalid_argument if encrypteds are not in the default NTT form
+        @throws std::invalid_argument if relin_keys were generated for a level below
+        the level of encrypted
+        @throws std::invalid_argument if the size of relin_keys is too small
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void relinearize_batch(std::vector<Ciphertext> &encrypteds,
+            const RelinKeys &relin_keys,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
         /**
         Given a ciphertext encrypted modulo q_1...q_k, this function switches the 
         modulus down to q_1...q_{k-1} and stores the result in the destination 
@@ -618,6 +679,80 @@ namespace seal
             rescale_to_inplace(destination, parms_id, std::move(pool));
         }
 
+        /**
+        Multiplies two ciphertexts, relinearizes the product to size 2, and switches
+        it to the next modulus in the modulus switching chain, scaling the message
+        down accordingly. For the CKKS scheme this is rescale_to_next and for the BFV
+        scheme mod_switch_to_next. The result is identical to that of the composed
+        calls to multiply_inplace, relinearize_inplace, and rescale_to_next_inplace
+        or mod_switch_to_next_inplace, but the modulus switch works in place and, for
+        the CKKS scheme, in NTT form, so that only the last prime of each polynomial
+        is transformed out of and back into NTT form. Dynamic memory allocations in
+        the process are allocated from the memory pool pointed to by the given
+        MemoryPoolHandle.
+
+        @param[in] encrypted1 The first multiplicand
+        @param[in] encrypted2 The second multiplicand
+        @param[in] relin_keys The relinearization keys
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted1 or encrypted2 is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if encrypted1 and encrypted2 are at different
+        level or have different NTT form
+        @throws std::invalid_argument if encrypted1 is already at lowest level
+        @throws std::invalid_argument if relin_keys is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if the size of relin_keys is too small
+        @throws std::invalid_argument if, when using scheme_type::CKKS, the output scale
+        is too large for the encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void multiply_relin_rescale_inplace(Ciphertext &encrypted1, 
+            const Ciphertext &encrypted2, const RelinKeys &relin_keys,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Multiplies two ciphertexts, relinearizes the product to size 2, switches it
+        to the next modulus in the modulus switching chain, and stores the result in
+        the destination parameter. The result is identical to that of the composed
+        calls to multiply, relinearize_inplace, and rescale_to_next_inplace (CKKS) or
+        mod_switch_to_next_inplace (BFV). Dynamic memory allocations in the process
+        are allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted1 The first multiplicand
+        @param[in] encrypted2 The second multiplicand
+        @param[in] relin_keys The relinearization keys
+        @param[out] destination The ciphertext to overwrite with the result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted1 or encrypted2 is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if encrypted1 and encrypted2 are at different
+        level or have different NTT form
+        @throws std::invalid_argument if encrypted1 is already at lowest level
+        @throws std::invalid_argument if relin_keys is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if the size of relin_keys is too small
+        @throws std::invalid_argument if, when using scheme_type::CKKS, the output scale
+        is too large for the encryption parameters
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        inline void multiply_relin_rescale(const Ciphertext &encrypted1, 
+            const Ciphertext &encrypted2, const RelinKeys &relin_keys, 
+            Ciphertext &destination, MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            if (&encrypted2 == &destination)
+            {
+                multiply_relin_rescale_inplace(destination, encrypted1, relin_keys,
+                    std::move(pool));
+            }
+            else
+            {
+                destination = encrypted1;
+                multiply_relin_rescale_inplace(destination, encrypted2, relin_keys,
+                    std::move(pool));
+            }
+        }
+
         /**
         Multiplies several ciphertexts together. This function computes the product 
         of several ciphertext given as an std::vector and stores the result in the 
@@ -641,9 +776,45 @@ namespace seal
         @throws std::invalid_argument if the size of relin_keys is too small
         @throws std::invalid_argument if pool is uninitialized
         */
-        void multiply_many(std::vector<Ciphertext> &encrypteds,
+        inline void multiply_many(const std::vector<Ciphertext> &encrypteds,
             const RelinKeys &relin_keys, Ciphertext &destination,
-            MemoryPoolHandle pool = MemoryManager::GetPool());
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            multiply_many_internal(encrypteds, relin_keys, destination, nullptr,
+                std::move(pool));
+        }
+
+        /**
+        Multiplies several ciphertexts together using the given ThreadPool. The
+        ciphertexts are multiplied pairwise in a balanced product tree, and the
+        products on each level of the tree are computed and relinearized in parallel
+        on the threads of the ThreadPool. The result is the same as that of the
+        single-threaded overload. Dynamic memory allocations in the process are
+        allocated from the memory pool pointed to by the given MemoryPoolHandle,
+        which should be thread-safe.
+
+        @param[in] encrypteds The ciphertexts to multiply
+        @param[in] relin_keys The relinearization keys
+        @param[out] destination The ciphertext to overwrite with the multiplication result
+        @param[in] thread_pool The ThreadPool to compute the products on
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::BFV
+        @throws std::invalid_argument if encrypteds is empty
+        @throws std::invalid_argument if the ciphertexts or relin_keys are not valid for
+        the encryption parameters
+        @throws std::invalid_argument if encrypteds are not in the default NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, the output scale
+        is too large for the encryption parameters
+        @throws std::invalid_argument if the size of relin_keys is too small
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        inline void multiply_many(const std::vector<Ciphertext> &encrypteds,
+            const RelinKeys &relin_keys, Ciphertext &destination,
+            ThreadPool &thread_pool, MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            multiply_many_internal(encrypteds, relin_keys, destination, &thread_pool,
+                std::move(pool));
+        }
 
         /**
         Exponentiates a ciphertext. This functions raises encrypted to a power. 
@@ -667,9 +838,44 @@ namespace seal
         @throws std::invalid_argument if the size of relin_keys is too small
         @throws std::invalid_argument if pool is uninitialized
         */
-        void exponentiate_inplace(Ciphertext &encrypted, 
+        inline void exponentiate_inplace(Ciphertext &encrypted, 
             std::uint64_t exponent, const RelinKeys &relin_keys, 
-            MemoryPoolHandle pool = MemoryManager::GetPool());
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            exponentiate_internal(encrypted, exponent, relin_keys, nullptr,
+                std::move(pool));
+        }
+
+        /**
+        Exponentiates a ciphertext using the given ThreadPool. Each multiplication
+        that folds a power of two into the result is computed concurrently with the
+        squaring that produces the next power of two. The result is the same as that
+        of the single-threaded overload. Dynamic memory allocations in the process
+        are allocated from the memory pool pointed to by the given MemoryPoolHandle,
+        which should be thread-safe.
+
+        @param[in] encrypted The ciphertext to exponentiate
+        @param[in] exponent The power to raise the ciphertext to
+        @param[in] relin_keys The relinearization keys
+        @param[in] thread_pool The ThreadPool to compute the products on
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::BFV
+        @throws std::invalid_argument if encrypted or relin_keys is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, the output scale
+        is too large for the encryption parameters
+        @throws std::invalid_argument if exponent is zero
+        @throws std::invalid_argument if the size of relin_keys is too small
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        inline void exponentiate_inplace(Ciphertext &encrypted, 
+            std::uint64_t exponent, const RelinKeys &relin_keys, 
+            ThreadPool &thread_pool, MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            exponentiate_internal(encrypted, exponent, relin_keys, &thread_pool,
+                std::move(pool));
+        }
 
         /**
         Exponentiates a ciphertext. This functions raises encrypted to a power and 
@@ -702,6 +908,39 @@ namespace seal
             exponentiate_inplace(destination, exponent, relin_keys, std::move(pool));
         }
 
+        /**
+        Exponentiates a ciphertext using the given ThreadPool and stores the result
+        in the destination parameter. Each multiplication that folds a power of two
+        into the result is computed concurrently with the squaring that produces
+        the next power of two. Dynamic memory allocations in the process are
+        allocated from the memory pool pointed to by the given MemoryPoolHandle,
+        which should be thread-safe.
+
+        @param[in] encrypted The ciphertext to exponentiate
+        @param[in] exponent The power to raise the ciphertext to
+        @param[in] relin_keys The relinearization keys
+        @param[out] destination The ciphertext to overwrite with the power
+        @param[in] thread_pool The ThreadPool to compute the products on
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if scheme is not scheme_type::BFV
+        @throws std::invalid_argument if encrypted or relin_keys is not valid for the
+        encryption parameters
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, the output scale
+        is too large for the encryption parameters
+        @throws std::invalid_argument if exponent is zero
+        @throws std::invalid_argument if the size of relin_keys is too small
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        inline void exponentiate(const Ciphertext &encrypted, std::uint64_t exponent,
+            const RelinKeys &relin_keys, Ciphertext &destination,
+            ThreadPool &thread_pool, MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            destination = encrypted;
+            exponentiate_inplace(destination, exponent, relin_keys, thread_pool,
+                std::move(pool));
+        }
+
         /**
         Adds a ciphertext and a plaintext. This function adds a plaintext to 
         a ciphertext. For the operation to be valid, the plaintext must have less 
@@ -829,6 +1068,307 @@ namespace seal
             multiply_plain_inplace(destination, plain, std::move(pool));
         }
 
+        /**
+        Prepares a plaintext for repeated use in multiply_plain, add_plain and 
+        sub_plain with ciphertexts at the given parms_id. When using the BFV scheme, 
+        the plaintext must not be in NTT form; it is lifted to all primes of the 
+        coefficient modulus and transformed to NTT form, and additionally scaled 
+        for plain addition and subtraction. When using the CKKS scheme, the 
+        plaintext must be in NTT form, and is switched down to the given parms_id. 
+        Dynamic memory allocations in the process are allocated from the memory 
+        pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] plain The plaintext to prepare
+        @param[in] parms_id The parms_id for which the plaintext is prepared
+        @param[out] destination The prepared plaintext to overwrite
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if plain or parms_id is not valid for the 
+        encryption parameters
+        @throws std::invalid_argument if plain is not in the default NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, parms_id 
+        is not at a lower or the same level as plain
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void prepare_plain(const Plaintext &plain, parms_id_type parms_id,
+            PreparedPlaintext &destination, 
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Multiplies a ciphertext with a prepared plaintext. The ciphertext must be 
+        at the parms_id the plaintext was prepared for. A BFV ciphertext in 
+        coefficient form is transformed to NTT form for the product and back, 
+        unless lazy NTT form tracking is enabled.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] prepared The prepared plaintext to multiply
+        @throws std::invalid_argument if encrypted is not valid for the encryption 
+        parameters
+        @throws std::invalid_argument if encrypted and prepared are at different 
+        parms_ids
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted 
+        is not in NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, the output 
+        scale is too large for the encryption parameters
+        */
+        void multiply_plain_inplace(Ciphertext &encrypted,
+            const PreparedPlaintext &prepared);
+
+        /**
+        Multiplies a ciphertext with a prepared plaintext and stores the result in 
+        the destination parameter.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] prepared The prepared plaintext to multiply
+        @param[out] destination The ciphertext to overwrite with the multiplication result
+        @throws std::invalid_argument if encrypted is not valid for the encryption 
+        parameters
+        @throws std::invalid_argument if encrypted and prepared are at different 
+        parms_ids
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted 
+        is not in NTT form
+        @throws std::invalid_argument if, when using scheme_type::CKKS, the output 
+        scale is too large for the encryption parameters
+        */
+        inline void multiply_plain(const Ciphertext &encrypted,
+            const PreparedPlaintext &prepared, Ciphertext &destination)
+        {
+            destination = encrypted;
+            multiply_plain_inplace(destination, prepared);
+        }
+
+        /**
+        Adds a prepared plaintext to a ciphertext. The ciphertext must be at the 
+        parms_id the plaintext was prepared for. BFV ciphertexts can be in either 
+        NTT form.
+
+        @param[in] encrypted The ciphertext to add to
+        @param[in] prepared The prepared plaintext to add
+        @throws std::invalid_argument if encrypted is not valid for the encryption 
+        parameters
+        @throws std::invalid_argument if encrypted and prepared are at different 
+        parms_ids or scales
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted 
+        is not in NTT form
+        */
+        inline void add_plain_inplace(Ciphertext &encrypted,
+            const PreparedPlaintext &prepared)
+        {
+            add_prepared_plain(encrypted, prepared, false);
+        }
+
+        /**
+        Adds a prepared plaintext to a ciphertext and stores the result in the 
+        destination parameter.
+
+        @param[in] encrypted The ciphertext to add to
+        @param[in] prepared The prepared plaintext to add
+        @param[out] destination The ciphertext to overwrite with the addition result
+        @throws std::invalid_argument if encrypted is not valid for the encryption 
+        parameters
+        @throws std::invalid_argument if encrypted and prepared are at different 
+        parms_ids or scales
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted 
+        is not in NTT form
+        */
+        inline void add_plain(const Ciphertext &encrypted,
+            const PreparedPlaintext &prepared, Ciphertext &destination)
+        {
+            destination = encrypted;
+            add_plain_inplace(destination, prepared);
+        }
+
+        /**
+        Subtracts a prepared plaintext from a ciphertext. The ciphertext must be at 
+        the parms_id the plaintext was prepared for. BFV ciphertexts can be in 
+        either NTT form.
+
+        @param[in] encrypted The ciphertext to subtract from
+        @param[in] prepared The prepared plaintext to subtract
+        @throws std::invalid_argument if encrypted is not valid for the encryption 
+        parameters
+        @throws std::invalid_argument if encrypted and prepared are at different 
+        parms_ids or scales
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted 
+        is not in NTT form
+        */
+        inline void sub_plain_inplace(Ciphertext &encrypted,
+            const PreparedPlaintext &prepared)
+        {
+            add_prepared_plain(encrypted, prepared, true);
+        }
+
+        /**
+        Subtracts a prepared plaintext from a ciphertext and stores the result in 
+        the destination parameter.
+
+        @param[in] encrypted The ciphertext to subtract from
+        @param[in] prepared The prepared plaintext to subtract
+        @param[out] destination The ciphertext to overwrite with the subtraction result
+        @throws std::invalid_argument if encrypted is not valid for the encryption 
+        parameters
+        @throws std::invalid_argument if encrypted and prepared are at different 
+        parms_ids or scales
+        @throws std::invalid_argument if, when using scheme_type::CKKS, encrypted 
+        is not in NTT form
+        */
+        inline void sub_plain(const Ciphertext &encrypted,
+            const PreparedPlaintext &prepared, Ciphertext &destination)
+        {
+            destination = encrypted;
+            sub_plain_inplace(destination, prepared);
+        }
+
+        /**
+        Multiplies a ciphertext with an integer scalar. When using the BFV scheme,
+        the scalar is a plaintext value and is reduced modulo the plaintext 
+        modulus, so that e.g. plain_modulus - 1 multiplies by -1. When using the 
+        CKKS scheme, the scalar multiplies the values without changing the scale. 
+        This is the same as multiplying with a constant plaintext, but needs no 
+        NTT, and works both in and out of NTT form.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] scalar The scalar to multiply with
+        @throws std::invalid_argument if encrypted is not valid for the encryption 
+        parameters
+        @throws std::invalid_argument if scalar is zero
+        */
+        void multiply_scalar_inplace(Ciphertext &encrypted, std::uint64_t scalar);
+
+        /**
+        Multiplies a ciphertext with an integer scalar and stores the result in 
+        the destination parameter.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] scalar The scalar to multiply with
+        @param[out] destination The ciphertext to overwrite with the multiplication result
+        @throws std::invalid_argument if encrypted is not valid for the encryption 
+        parameters
+        @throws std::invalid_argument if scalar is zero
+        */
+        inline void multiply_scalar(const Ciphertext &encrypted, std::uint64_t scalar,
+            Ciphertext &destination)
+        {
+            destination = encrypted;
+            multiply_scalar_inplace(destination, scalar);
+        }
+
+        /**
+        Multiplies a CKKS ciphertext with a real scalar. The scalar is encoded 
+        with the given scale, which multiplies the scale of the ciphertext, as for 
+        a constant plaintext encoded by CKKSEncoder.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] scalar The scalar to multiply with
+        @param[in] scale The scale to encode the scalar with
+        @throws std::logic_error if scheme is not scheme_type::CKKS
+        @throws std::invalid_argument if encrypted is not valid for the encryption 
+        parameters
+        @throws std::invalid_argument if encrypted is not in NTT form
+        @throws std::invalid_argument if the output scale is too large for the 
+        encryption parameters
+        @throws std::invalid_argument if scalar times scale does not fit in 63 bits
+        @throws std::invalid_argument if scalar times scale rounds to zero
+        */
+        void multiply_scalar_inplace(Ciphertext &encrypted, double scalar, double scale);
+
+        /**
+        Multiplies a CKKS ciphertext with a real scalar and stores the result in 
+        the destination parameter.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] scalar The scalar to multiply with
+        @param[in] scale The scale to encode the scalar with
+        @param[out] destination The ciphertext to overwrite with the multiplication result
+        @throws std::logic_error if scheme is not scheme_type::CKKS
+        @throws std::invalid_argument if encrypted is not valid for the encryption 
+        parameters
+        @throws std::invalid_argument if encrypted is not in NTT form
+        @throws std::invalid_argument if the output scale is too large for the 
+        encryption parameters
+        @throws std::invalid_argument if scalar times scale does not fit in 63 bits
+        @throws std::invalid_argument if scalar times scale rounds to zero
+        */
+        inline void multiply_scalar(const Ciphertext &encrypted, double scalar,
+            double scale, Ciphertext &destination)
+        {
+            destination = encrypted;
+            multiply_scalar_inplace(destination, scalar, scale);
+        }
+
+        /**
+        Multiplies a ciphertext with the monomial coeff * x^exponent, where coeff 
+        is interpreted as in multiply_scalar_inplace. The product is a negacyclic 
+        shift of each polynomial, computed in coefficient form; ciphertexts in NTT 
+        form are transformed for it. Dynamic memory allocations in the process are 
+        allocated from the memory pool pointed to by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] coeff The coefficient of the monomial
+        @param[in] exponent The exponent of the monomial
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted is not valid for the encryption 
+        parameters
+        @throws std::invalid_argument if coeff is zero
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void multiply_monomial_inplace(Ciphertext &encrypted, std::uint64_t coeff,
+            std::size_t exponent, MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Multiplies a ciphertext with the monomial coeff * x^exponent and stores 
+        the result in the destination parameter. Dynamic memory allocations in the 
+        process are allocated from the memory pool pointed to by the given 
+        MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to multiply
+        @param[in] coeff The coefficient of the monomial
+        @param[in] exponent The exponent of the monomial
+        @param[out] destination The ciphertext to overwrite with the multiplication result
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted is not valid for the encryption 
+        parameters
+        @throws std::invalid_argument if coeff is zero
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        inline void multiply_monomial(const Ciphertext &encrypted, std::uint64_t coeff,
+            std::size_t exponent, Ciphertext &destination,
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            destination = encrypted;
+            multiply_monomial_inplace(destination, coeff, exponent, std::move(pool));
+        }
+
+        /**
+        Adds a scalar to a BFV ciphertext. The scalar is a plaintext value and is 
+        reduced modulo the plaintext modulus. This is the same as adding a constant 
+        plaintext, and works both in and out of NTT form.
+
+        @param[in] encrypted The ciphertext to add to
+        @param[in] scalar The scalar to add
+        @throws std::logic_error if scheme is not scheme_type::BFV
+        @throws std::invalid_argument if encrypted is not valid for the encryption 
+        parameters
+        */
+        void add_scalar_inplace(Ciphertext &encrypted, std::uint64_t scalar);
+
+        /**
+        Adds a scalar to a BFV ciphertext and stores the result in the destination 
+        parameter.
+
+        @param[in] encrypted The ciphertext to add to
+        @param[in] scalar The scalar to add
+        @param[out] destination The ciphertext to overwrite with the addition result
+        @throws std::logic_error if scheme is not scheme_type::BFV
+        @throws std::invalid_argument if encrypted is not valid for the encryption 
+        parameters
+        */
+        inline void add_scalar(const Ciphertext &encrypted, std::uint64_t scalar,
+            Ciphertext &destination)
+        {
+            destination = encrypted;
+            add_scalar_inplace(destination, scalar);
+        }
+
         /**
         Transforms a plaintext to NTT domain. This functions applies the Number 
         Theoretic Transform to a plaintext by first embedding integers modulo the 
@@ -963,8 +1503,8 @@ namespace seal
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if encrypted or galois_keys is not valid for 
         the encryption parameters
-        @throws std::invalid_argument if galois_keys do not correspond to the top 
-        level parameters in the current context
+        @throws std::invalid_argument if galois_keys were generated for a level below
+        the level of encrypted
         @throws std::invalid_argument if encrypted is not in the default NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if the Galois element is not valid
@@ -998,8 +1538,8 @@ namespace seal
         @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
         @throws std::invalid_argument if encrypted or galois_keys is not valid for 
         the encryption parameters
-        @throws std::invalid_argument if galois_keys do not correspond to the top 
-        level parameters in the current context
+        @throws std::invalid_argument if galois_keys were generated for a level below
+        the level of encrypted
         @throws std::invalid_argument if encrypted is not in the default NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if the Galois element is not valid
@@ -1015,6 +1555,65 @@ namespace seal
             apply_galois_inplace(destination, galois_elt, galois_keys, std::move(pool));
         }
 
+        /**
+        Applies a Galois automorphism to a batch of ciphertexts. The ciphertexts must
+        all be at the same level. The key switching is tiled so that every Galois key
+        polynomial is loaded once per batch and applied to all ciphertexts while it
+        is still in cache. If no Galois key is present for the Galois element itself,
+        the ciphertexts are processed one by one as in apply_galois_inplace. Dynamic
+        memory allocations in the process are allocated from the memory pool pointed
+        to by the given MemoryPoolHandle.
+
+        @param[in] encrypteds The ciphertexts to apply the Galois automorphism to
+        @param[in] galois_elt The Galois element
+        @param[in] galois_keys The Galois keys
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypteds or galois_keys is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if encrypteds have different parameters
+        @throws std::invalid_argument if galois_keys were generated for a level below
+        the level of encrypted
+        @throws std::invalid_argument if encrypteds are not in the default NTT form
+        @throws std::invalid_argument if any of encrypteds has size larger than 2
+        @throws std::invalid_argument if the Galois element is not valid
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void apply_galois_batch(std::vector<Ciphertext> &encrypteds,
+            std::uint64_t galois_elt, const GaloisKeys &galois_keys,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Applies several Galois automorphisms to the same ciphertext and writes the
+        results to the destinations parameter, one ciphertext per Galois element.
+        The base-w decomposition of the second ciphertext polynomial and its NTT
+        transforms are computed only once and shared by all automorphisms (hoisting),
+        so that each additional Galois element only costs a permutation and a key
+        inner product. Galois elements for which no Galois key is present directly
+        are evaluated through apply_galois_inplace instead. Dynamic memory allocations
+        in the process are allocated from the memory pool pointed to by the given
+        MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to apply the Galois automorphisms to
+        @param[in] galois_elts The Galois elements
+        @param[in] galois_keys The Galois keys
+        @param[out] destinations The vector to overwrite with the results
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if galois_keys were generated for a level below
+        the level of encrypted
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if any of the Galois elements is not valid
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void apply_galois_many(const Ciphertext &encrypted,
+            const std::vector<std::uint64_t> &galois_elts,
+            const GaloisKeys &galois_keys, std::vector<Ciphertext> &destinations,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
         /**
         Rotates plaintext matrix rows cyclically. When batching is used with the 
         BFV scheme, this function rotates the encrypted plaintext matrix rows 
@@ -1033,8 +1632,8 @@ namespace seal
         @throws std::logic_error if the encryption parameters do not support batching
         @throws std::invalid_argument if encrypted or galois_keys is not valid for 
         the encryption parameters
-        @throws std::invalid_argument if galois_keys do not correspond to the top 
-        level parameters in the current context
+        @throws std::invalid_argument if galois_keys were generated for a level below
+        the level of encrypted
         @throws std::invalid_argument if encrypted is not in the default NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if steps has too big absolute value
@@ -1071,8 +1670,8 @@ namespace seal
         @throws std::logic_error if the encryption parameters do not support batching
         @throws std::invalid_argument if encrypted or galois_keys is not valid for 
         the encryption parameters
-        @throws std::invalid_argument if galois_keys do not correspond to the top 
-        level parameters in the current context
+        @throws std::invalid_argument if galois_keys were generated for a level below
+        the level of encrypted
         @throws std::invalid_argument if encrypted is in NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if steps has too big absolute value
@@ -1104,8 +1703,8 @@ namespace seal
         @throws std::logic_error if the encryption parameters do not support batching
         @throws std::invalid_argument if encrypted or galois_keys is not valid for 
         the encryption parameters
-        @throws std::invalid_argument if galois_keys do not correspond to the top 
-        level parameters in the current context
+        @throws std::invalid_argument if galois_keys were generated for a level below
+        the level of encrypted
         @throws std::invalid_argument if encrypted is in NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if necessary Galois keys are not present
@@ -1139,8 +1738,8 @@ namespace seal
         @throws std::logic_error if the encryption parameters do not support batching
         @throws std::invalid_argument if encrypted or galois_keys is not valid for 
         the encryption parameters
-        @throws std::invalid_argument if galois_keys do not correspond to the top 
-        level parameters in the current context
+        @throws std::invalid_argument if galois_keys were generated for a level below
+        the level of encrypted
         @throws std::invalid_argument if encrypted is in NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if necessary Galois keys are not present
@@ -1170,8 +1769,8 @@ namespace seal
         @throws std::logic_error if scheme is not scheme_type::CKKS
         @throws std::invalid_argument if encrypted or galois_keys is not valid for 
         the encryption parameters
-        @throws std::invalid_argument if galois_keys do not correspond to the top 
-        level parameters in the current context
+        @throws std::invalid_argument if galois_keys were generated for a level below
+        the level of encrypted
         @throws std::invalid_argument if encrypted is not in the default NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if steps has too big absolute value
@@ -1206,8 +1805,8 @@ namespace seal
         @throws std::logic_error if scheme is not scheme_type::CKKS
         @throws std::invalid_argument if encrypted or galois_keys is not valid for 
         the encryption parameters
-        @throws std::invalid_argument if galois_keys do not correspond to the top 
-        level parameters in the current context
+        @throws std::invalid_argument if galois_keys were generated for a level below
+        the level of encrypted
         @throws std::invalid_argument if encrypted is in NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if steps has too big absolute value
@@ -1222,6 +1821,36 @@ namespace seal
             rotate_vector_inplace(destination, steps, galois_keys, std::move(pool));
         }
 
+        /**
+        Rotates the same ciphertext by several step counts at once and writes the
+        results to the destinations parameter, one ciphertext per entry of steps.
+        When using the BFV scheme each result equals that of rotate_rows, and when
+        using the CKKS scheme that of rotate_vector. The expensive decomposition of
+        the ciphertext is shared by all rotations (see apply_galois_many), which
+        makes this considerably faster than rotating repeatedly. Dynamic memory
+        allocations in the process are allocated from the memory pool pointed to
+        by the given MemoryPoolHandle.
+
+        @param[in] encrypted The ciphertext to rotate
+        @param[in] steps The numbers of steps to rotate (negative left, positive right)
+        @param[in] galois_keys The Galois keys
+        @param[out] destinations The vector to overwrite with the rotated results
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::logic_error if the encryption parameters do not support batching
+        @throws std::invalid_argument if encrypted or galois_keys is not valid for
+        the encryption parameters
+        @throws std::invalid_argument if galois_keys were generated for a level below
+        the level of encrypted
+        @throws std::invalid_argument if encrypted is not in the default NTT form
+        @throws std::invalid_argument if encrypted has size larger than 2
+        @throws std::invalid_argument if any of the steps has too big absolute value
+        @throws std::invalid_argument if necessary Galois keys are not present
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        void rotate_many(const Ciphertext &encrypted, const std::vector<int> &steps,
+            const GaloisKeys &galois_keys, std::vector<Ciphertext> &destinations,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
         /**
         Complex conjugates plaintext slot values. When using the CKKS scheme, this 
         function complex conjugates all values in the underlying plaintext. Dynamic 
@@ -1235,8 +1864,8 @@ namespace seal
         @throws std::logic_error if scheme is not scheme_type::CKKS
         @throws std::invalid_argument if encrypted or galois_keys is not valid for 
         the encryption parameters
-        @throws std::invalid_argument if galois_keys do not correspond to the top 
-        level parameters in the current context
+        @throws std::invalid_argument if galois_keys were generated for a level below
+        the level of encrypted
         @throws std::invalid_argument if encrypted is in NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if necessary Galois keys are not present
@@ -1267,8 +1896,8 @@ namespace seal
         @throws std::logic_error if scheme is not scheme_type::CKKS
         @throws std::invalid_argument if encrypted or galois_keys is not valid for 
         the encryption parameters
-        @throws std::invalid_argument if galois_keys do not correspond to the top 
-        level parameters in the current context
+        @throws std::invalid_argument if galois_keys were generated for a level below
+        the level of encrypted
         @throws std::invalid_argument if encrypted is in NTT form
         @throws std::invalid_argument if encrypted has size larger than 2
         @throws std::invalid_argument if necessary Galois keys are not present
@@ -1301,12 +1930,24 @@ namespace seal
 
         void ckks_square(Ciphertext &encrypted, MemoryPoolHandle pool);
 
-        void relinearize_internal(Ciphertext &encrypted, const RelinKeys &relin_keys,
+        void multiply_many_internal(const std::vector<Ciphertext> &encrypteds,
+            const RelinKeys &relin_keys, Ciphertext &destination,
+            ThreadPool *thread_pool, MemoryPoolHandle pool);
+
+        void exponentiate_internal(Ciphertext &encrypted, std::uint64_t exponent,
+            const RelinKeys &relin_keys, ThreadPool *thread_pool,
+            MemoryPoolHandle pool);
+
+        void relinearize_internal(const std::vector<Ciphertext *> &encrypteds,
+            const RelinKeys &relin_keys,
             std::size_t destination_size, MemoryPoolHandle pool);
 
         void mod_switch_scale_to_next(const Ciphertext &encrypted, Ciphertext &destination,
             MemoryPoolHandle pool);
 
+        void mod_switch_scale_to_next_inplace(Ciphertext &encrypted,
+            util::MemoryPool &pool);
+
         void mod_switch_drop_to_next(const Ciphertext &encrypted, Ciphertext &destination);
 
         void mod_switch_drop_to_next(Plaintext &plain);
@@ -1439,23 +2080,64 @@ namespace seal
             }
         }
 
-        void bfv_relinearize_one_step(std::uint64_t *encrypted, std::size_t encrypted_size,
-            const SEALContext::ContextData &context_data,
+        void bfv_relinearize_one_step(const std::vector<std::uint64_t *> &encrypteds,
+            std::size_t encrypted_size, const SEALContext::ContextData &context_data,
             const RelinKeys &relin_keys, util::MemoryPool &pool);
 
-        void ckks_relinearize_one_step(std::uint64_t *encrypted, std::size_t encrypted_size,
-            const SEALContext::ContextData &context_data,
+        void ckks_relinearize_one_step(const std::vector<std::uint64_t *> &encrypteds,
+            std::size_t encrypted_size, const SEALContext::ContextData &context_data,
             const RelinKeys &relin_keys, util::MemoryPool &pool);
 
+        // Returns whether keys generated at the level of keys_parms_id can switch
+        // keys of ciphertexts at the level of context_data, i.e. at that level or
+        // below it.
+        bool is_key_level_valid(const parms_id_type &keys_parms_id,
+            const SEALContext::ContextData &context_data) const;
+
+        // Computes the key switching inner products of the decompositions of targets
+        // (in coefficient form) with key_components, and writes them in NTT form to
+        // destinations, two polynomials each. All targets share every key read.
+        void switch_key_inner_product(const std::vector<const std::uint64_t *> &targets,
+            const std::vector<Ciphertext> &key_components, int decomposition_bit_count,
+            const SEALContext::ContextData &context_data,
+            const std::vector<std::uint64_t *> &destinations, util::MemoryPool &pool);
+
+        void apply_galois_with_key(const std::vector<Ciphertext *> &encrypteds,
+            std::uint64_t galois_elt, const GaloisKeys &galois_keys,
+            util::MemoryPool &pool);
+
         void multiply_plain_normal(Ciphertext &encrypted, const Plaintext &plain,
             util::MemoryPool &pool);
 
         void multiply_plain_ntt(Ciphertext &encrypted_ntt, const Plaintext &plain_ntt);
 
+        // Writes Delta * plain, lifted to all primes, in coefficient form
+        void bfv_scale_plain(const Plaintext &plain,
+            const SEALContext::ContextData &context_data, std::uint64_t *destination);
+
+        // Adds Delta * plain to (or subtracts it from) a BFV ciphertext that lazy 
+        // NTT form tracking has left in NTT form.
+        void bfv_add_plain_ntt(Ciphertext &encrypted_ntt, const Plaintext &plain,
+            bool subtract);
+
+        void add_prepared_plain(Ciphertext &encrypted,
+            const PreparedPlaintext &prepared, bool subtract);
+
+        inline void restore_coeff_form(Ciphertext &encrypted)
+        {
+            if (lazy_ntt_form_ && encrypted.is_ntt_form() &&
+                context_->context_data()->parms().scheme() == scheme_type::BFV)
+            {
+                transform_from_ntt_inplace(encrypted);
+            }
+        }
+
         void populate_Zmstar_to_generator();
 
         std::shared_ptr<SEALContext> context_{ nullptr };
 
+        bool lazy_ntt_form_ = false;
+
         std::map<std::uint64_t, std::pair<std::uint64_t, std::uint64_t>> Zmstar_to_generator_{};
     };
 }
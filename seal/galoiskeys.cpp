@@ -2,8 +2,13 @@
 // Licensed under the MIT license.
 
 #include "seal/galoiskeys.h"
+#include "seal/util/streambuf.h"
+#include "seal/util/seededkeys.h"
 #include "seal/util/common.h"
+#include "seal/util/uintarithsmallmod.h"
 #include <stdexcept>
+#include <cstring>
+#include <algorithm>
 
 using namespace std;
 using namespace seal::util;
@@ -38,6 +43,11 @@ namespace seal
             }
         }
 
+        seeds_ = assign.seeds_;
+
+        // The copied keys own their data
+        mapping_.reset();
+
         return *this;
     }
 
@@ -48,7 +58,7 @@ namespace seal
         {
             return false;
         }
-        if (parms_id_ != context->first_parms_id())
+        if (!context->context_data(parms_id_))
         {
             return false;
         }
@@ -68,7 +78,32 @@ namespace seal
         return true;
     }
 
-    void GaloisKeys::save(std::ostream &stream) const
+    vector<uint64_t> GaloisKeys::galois_elts() const
+    {
+        vector<uint64_t> result;
+        for (size_t index = 0; index < keys_.size(); index++)
+        {
+            if (!keys_[index].empty())
+            {
+                result.push_back((static_cast<uint64_t>(index) << 1) + 1);
+            }
+        }
+        return result;
+    }
+
+    bool GaloisKeys::has_key_for_steps(int steps) const
+    {
+        // Every key component stores the degree of the polynomial modulus
+        auto first_key = find_if(keys_.begin(), keys_.end(),
+            [](const vector<Ciphertext> &key) { return !key.empty(); });
+        if (first_key == keys_.end())
+        {
+            return false;
+        }
+        return has_key(steps_to_galois_elt(steps, first_key->front().poly_modulus_degree()));
+    }
+
+    void GaloisKeys::save(std::ostream &stream, compr_mode_type compr_mode) const
     {
         auto old_except_mask = stream.exceptions();
         try
@@ -102,7 +137,7 @@ namespace seal
                 for (size_t j = 0; j < keys_dim2; j++)
                 {
                     // Save the key
-                    keys_[index][j].save(stream);
+                    keys_[index][j].save(stream, compr_mode);
                 }
             }
         }
@@ -116,6 +151,11 @@ namespace seal
     }
 
     void GaloisKeys::unsafe_load(std::istream &stream)
+    {
+        load_internal(stream, nullptr);
+    }
+
+    void GaloisKeys::load_internal(std::istream &stream, shared_ptr<SEALContext> context)
     {
         auto old_except_mask = stream.exceptions();
         try
@@ -123,12 +163,26 @@ namespace seal
             // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
             stream.exceptions(ios_base::badbit | ios_base::failbit);
 
-            // Clear current keys
+            // Clear current keys and release any mapping they point to
             keys_.clear();
+            seeds_.clear();
+            mapping_.reset();
 
-            // Read the parms_id
-            stream.read(reinterpret_cast<char*>(&parms_id_),
-                sizeof(parms_id_type));
+            // Keys saved without seeds start directly with the parms_id
+            stream.read(reinterpret_cast<char*>(&parms_id_[0]), sizeof(uint64_t));
+            if (parms_id_[0] == seeded_keys_magic)
+            {
+                if (!context)
+                {
+                    throw invalid_argument("seeded GaloisKeys can only be loaded with a context");
+                }
+                load_seeded_kswitch_keys(context, stream, parms_id_,
+                    decomposition_bit_count_, keys_, seeds_, pool_);
+                stream.exceptions(old_except_mask);
+                return;
+            }
+            stream.read(reinterpret_cast<char*>(&parms_id_[1]),
+                sizeof(parms_id_type) - sizeof(uint64_t));
 
             // Read the decomposition_bit_count
             int32_t decomposition_bit_count32 = 0;
@@ -169,4 +223,208 @@ namespace seal
 
         stream.exceptions(old_except_mask);
     }
+
+    size_t GaloisKeys::save_size(compr_mode_type compr_mode) const
+    {
+        // parms_id, decomposition bit count, and size of keys_
+        size_t result = sizeof(parms_id_type) + sizeof(int32_t) + sizeof(uint64_t);
+        for (auto &a : keys_)
+        {
+            // Size of the second dimension
+            result = add_safe(result, sizeof(uint64_t));
+            for (auto &b : a)
+            {
+                result = add_safe(result, b.save_size(compr_mode));
+            }
+        }
+
+        return result;
+    }
+
+    size_t GaloisKeys::save(void *destination, size_t size,
+        compr_mode_type compr_mode) const
+    {
+        ArrayPutBuffer apbuf(destination, size);
+        ostream stream(&apbuf);
+        save(stream, compr_mode);
+        return apbuf.size();
+    }
+
+    size_t GaloisKeys::unsafe_load(const void *source, size_t size)
+    {
+        return load_internal(source, size, nullptr);
+    }
+
+    size_t GaloisKeys::load_internal(const void *source, size_t size,
+        shared_ptr<SEALContext> context)
+    {
+        ArrayGetBuffer agbuf(source, size);
+        istream stream(&agbuf);
+        load_internal(stream, move(context));
+        return agbuf.size();
+    }
+
+    bool GaloisKeys::has_seeds() const noexcept
+    {
+        if (seeds_.size() != keys_.size())
+        {
+            return false;
+        }
+        for (size_t index = 0; index < keys_.size(); index++)
+        {
+            if (seeds_[index].size() != keys_[index].size())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void GaloisKeys::save_seeded(ostream &stream, compr_mode_type compr_mode) const
+    {
+        if (!has_seeds())
+        {
+            throw logic_error("GaloisKeys does not have seeds");
+        }
+        save_seeded_kswitch_keys(parms_id_, decomposition_bit_count_, keys_, seeds_,
+            stream, compr_mode);
+    }
+
+    bool GaloisKeys::is_metadata_valid_for(shared_ptr<SEALContext> context) const noexcept
+    {
+        // Verify parameters
+        if (!context || !context->parameters_set())
+        {
+            return false;
+        }
+        if (!context->context_data(parms_id_))
+        {
+            return false;
+        }
+
+        auto &parms = context->context_data(parms_id_)->parms();
+        size_t coeff_mod_count = parms.coeff_modulus().size();
+        size_t poly_modulus_degree = parms.poly_modulus_degree();
+        for (auto &a : keys_)
+        {
+            for (auto &b : a)
+            {
+                if (b.parms_id() != parms_id_ || !b.is_ntt_form() ||
+                    b.coeff_mod_count() != coeff_mod_count ||
+                    b.poly_modulus_degree() != poly_modulus_degree)
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    void GaloisKeys::save_mappable(std::ostream &stream) const
+    {
+        auto old_except_mask = stream.exceptions();
+        try
+        {
+            // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+            stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+            // Save the format identifier and version
+            stream.write(reinterpret_cast<const char*>(&mapped_keys_magic), 
+                sizeof(uint64_t));
+            stream.write(reinterpret_cast<const char*>(&mapped_keys_version),
+                sizeof(uint64_t));
+
+            // Save the parms_id
+            stream.write(reinterpret_cast<const char*>(&parms_id_),
+                sizeof(parms_id_type));
+
+            // Save the decomposition bit count padded to 8 bytes
+            int64_t decomposition_bit_count64 = decomposition_bit_count_;
+            stream.write(reinterpret_cast<const char*>(&decomposition_bit_count64),
+                sizeof(int64_t));
+
+            // Save the size of keys_
+            uint64_t keys_dim1 = static_cast<uint64_t>(keys_.size());
+            stream.write(reinterpret_cast<const char*>(&keys_dim1), sizeof(uint64_t));
+            for (size_t index = 0; index < keys_dim1; index++)
+            {
+                uint64_t keys_dim2 = static_cast<uint64_t>(keys_[index].size());
+                stream.write(reinterpret_cast<const char*>(&keys_dim2), sizeof(uint64_t));
+                for (size_t j = 0; j < keys_dim2; j++)
+                {
+                    keys_[index][j].save_mappable(stream);
+                }
+            }
+        }
+        catch (const exception &)
+        {
+            stream.exceptions(old_except_mask);
+            throw;
+        }
+
+        stream.exceptions(old_except_mask);
+    }
+
+    void GaloisKeys::unsafe_load_mapped(const std::string &path)
+    {
+        auto mapping = make_shared<MappedFile>(path);
+        SEAL_BYTE *ptr = mapping->data();
+        const SEAL_BYTE *end = ptr + mapping->size();
+        auto read_uint64 = [&ptr, end]() -> uint64_t {
+            if (static_cast<size_t>(end - ptr) < sizeof(uint64_t))
+            {
+                throw invalid_argument("mapped GaloisKeys data is invalid");
+            }
+            uint64_t value;
+            memcpy(&value, ptr, sizeof(uint64_t));
+            ptr += sizeof(uint64_t);
+            return value;
+        };
+
+        // Check the format identifier and version
+        if (read_uint64() != mapped_keys_magic || 
+            read_uint64() != mapped_keys_version)
+        {
+            throw invalid_argument("file is not a mapped GaloisKeys file");
+        }
+
+        // Read the parms_id
+        parms_id_type parms_id{};
+        for (auto &word : parms_id)
+        {
+            word = read_uint64();
+        }
+
+        // Read the decomposition bit count
+        int64_t decomposition_bit_count64 = 
+            static_cast<int64_t>(read_uint64());
+
+        // Read in the size of keys_
+        uint64_t keys_dim1 = read_uint64();
+
+        // Point new keys to the mapped data
+        vector<vector<Ciphertext>> new_keys;
+        new_keys.reserve(safe_cast<size_t>(keys_dim1));
+        for (size_t index = 0; index < keys_dim1; index++)
+        {
+            uint64_t keys_dim2 = read_uint64();
+            new_keys.emplace_back();
+            new_keys.back().reserve(safe_cast<size_t>(keys_dim2));
+            for (size_t j = 0; j < keys_dim2; j++)
+            {
+                Ciphertext new_key(pool_);
+                new_key.unsafe_map(ptr, end);
+                new_keys.back().emplace_back(move(new_key));
+            }
+        }
+
+        // Set values; the old keys must go before the old mapping
+        keys_.swap(new_keys);
+        new_keys.clear();
+        seeds_.clear();
+        parms_id_ = parms_id;
+        decomposition_bit_count_ = safe_cast<int>(decomposition_bit_count64);
+        mapping_ = move(mapping);
+    }
 }
@@ -9,6 +9,8 @@
 #include "seal/ciphertext.h"
 #include "seal/memorymanager.h"
 #include "seal/encryptionparams.h"
+#include "seal/randomgen.h"
+#include "seal/util/mappedfile.h"
 
 namespace seal
 {
@@ -59,7 +61,12 @@ namespace seal
 
         @param[in] copy The GaloisKeys to copy from
         */
-        GaloisKeys(const GaloisKeys &copy) = default;
+        GaloisKeys(const GaloisKeys &copy) : pool_(copy.pool_)
+        {
+            // Copies always own their data, even if copy is memory-mapped; it
+            // is allocated from the same pool as the data of copy
+            operator =(copy);
+        }
 
         /**
         Creates a new GaloisKeys instance by moving a given instance.
@@ -152,6 +159,26 @@ namespace seal
             return (index < keys_.size()) && !keys_[index].empty();
         }
 
+        /**
+        Returns the Galois elements for which a Galois key exists, in increasing
+        order.
+        */
+        std::vector<std::uint64_t> galois_elts() const;
+
+        /**
+        Returns whether a Galois key exists that rotates by the given number of
+        steps directly, i.e. without composing several rotations. Negative step
+        counts correspond to rotations to the right and positive step counts
+        correspond to rotations to the left. A step count of zero corresponds to
+        a column rotation in the BFV scheme and complex conjugation in the CKKS
+        scheme. Since the degree of the polynomial modulus is read from the keys,
+        this function returns false when the GaloisKeys is empty.
+
+        @param[in] steps The rotation step count
+        @throws std::invalid_argument if steps is too large for the keys
+        */
+        bool has_key_for_steps(int steps) const;
+
         /**
         Returns a reference to parms_id.
 
@@ -188,9 +215,12 @@ namespace seal
         flag set.
 
         @param[in] stream The stream to save the GaloisKeys to
+        @param[in] compr_mode The format to save the key ciphertexts in
+        @throws std::invalid_argument if compr_mode is not supported
         @throws std::exception if the GaloisKeys could not be written to stream
         */
-        void save(std::ostream &stream) const;
+        void save(std::ostream &stream, 
+            compr_mode_type compr_mode = compr_mode_type::none) const;
 
         /**
         Loads a GaloisKeys from an input stream overwriting the current GaloisKeys.
@@ -200,12 +230,15 @@ namespace seal
 
         @param[in] stream The stream to load the GaloisKeys from
         @throws std::exception if a valid GaloisKeys could not be read from stream
+        @throws std::invalid_argument if the GaloisKeys was saved with save_seeded
         */
         void unsafe_load(std::istream &stream);
 
         /**
         Loads a GaloisKeys from an input stream overwriting the current GaloisKeys.
         The loaded GaloisKeys is verified to be valid for the given SEALContext.
+        GaloisKeys saved with save_seeded are accepted too, in which case the uniform
+        polynomials are expanded from their seeds.
 
         @param[in] context The SEALContext
         @param[in] stream The stream to load the GaloisKeys from
@@ -217,13 +250,164 @@ namespace seal
         */
         inline void load(std::shared_ptr<SEALContext> context, std::istream &stream)
         {
-            unsafe_load(stream);
+            load_internal(stream, context);
             if (!is_valid_for(std::move(context)))
             {
                 throw std::invalid_argument("GaloisKeys data is invalid");
             }
         }
 
+        /**
+        Returns the exact number of bytes save writes for the GaloisKeys in the
+        given format.
+
+        @param[in] compr_mode The format to save the key ciphertexts in
+        @throws std::invalid_argument if compr_mode is not supported
+        */
+        std::size_t save_size(
+            compr_mode_type compr_mode = compr_mode_type::none) const;
+
+        /**
+        Saves the GaloisKeys directly into a caller-owned buffer, which must have 
+        room for at least save_size(compr_mode) bytes. Returns the number of 
+        bytes written.
+
+        @param[out] destination The buffer to save the GaloisKeys to
+        @param[in] size The size of the buffer in bytes
+        @param[in] compr_mode The format to save the key ciphertexts in
+        @throws std::invalid_argument if destination is null and size is non-zero
+        @throws std::invalid_argument if compr_mode is not supported
+        @throws std::exception if the GaloisKeys does not fit in the buffer
+        */
+        std::size_t save(void *destination, std::size_t size,
+            compr_mode_type compr_mode = compr_mode_type::none) const;
+
+        /**
+        Loads a GaloisKeys directly from a caller-owned buffer overwriting the 
+        current GaloisKeys. Returns the number of bytes read. No checking of the 
+        validity of the GaloisKeys data against encryption parameters is performed.
+        This function should not be used unless the GaloisKeys comes from a fully 
+        trusted source.
+
+        @param[in] source The buffer to load the GaloisKeys from
+        @param[in] size The size of the buffer in bytes
+        @throws std::invalid_argument if source is null and size is non-zero
+        @throws std::exception if a valid GaloisKeys could not be read from source
+        */
+        std::size_t unsafe_load(const void *source, std::size_t size);
+
+        /**
+        Loads a GaloisKeys directly from a caller-owned buffer overwriting the 
+        current GaloisKeys. Returns the number of bytes read. The loaded GaloisKeys is 
+        verified to be valid for the given SEALContext. GaloisKeys saved with 
+        save_seeded are accepted too.
+
+        @param[in] context The SEALContext
+        @param[in] source The buffer to load the GaloisKeys from
+        @param[in] size The size of the buffer in bytes
+        @throws std::invalid_argument if the context is not set or encryption
+        parameters are not valid
+        @throws std::invalid_argument if source is null and size is non-zero
+        @throws std::exception if a valid GaloisKeys could not be read from source
+        @throws std::invalid_argument if the loaded GaloisKeys is invalid for the
+        context
+        */
+        inline std::size_t load(std::shared_ptr<SEALContext> context,
+            const void *source, std::size_t size)
+        {
+            std::size_t in_size = load_internal(source, size, context);
+            if (!is_valid_for(std::move(context)))
+            {
+                throw std::invalid_argument("GaloisKeys data is invalid");
+            }
+            return in_size;
+        }
+
+        /**
+        Returns whether every key has the seeds its uniform polynomials were
+        sampled from, so that the GaloisKeys can be saved with save_seeded. This is the
+        case for keys created by KeyGenerator and for keys loaded from data saved
+        with save_seeded.
+        */
+        bool has_seeds() const noexcept;
+
+        /**
+        Saves the GaloisKeys instance to an output stream in a format that stores the 
+        seed of each key component instead of its uniform polynomials, which
+        makes the output about half the size of that of save. Loading the output
+        requires a SEALContext, since the polynomials are expanded from the seeds
+        when loaded. The output stream must have the "binary" flag set. The data
+        of the keys must not have been modified since they were generated.
+
+        @param[in] stream The stream to save the GaloisKeys to
+        @param[in] compr_mode The format to save the remaining key polynomials in
+        @throws std::logic_error if the GaloisKeys does not have seeds
+        @throws std::invalid_argument if compr_mode is not supported
+        @throws std::exception if the GaloisKeys could not be written to stream
+        */
+        void save_seeded(std::ostream &stream,
+            compr_mode_type compr_mode = compr_mode_type::none) const;
+
+        /**
+        Saves the GaloisKeys instance to an output stream in a format that can be
+        memory-mapped with load_mapped. Every field is 8-byte aligned so that the
+        mapped key data can be used in place. The output stream must have the 
+        "binary" flag set.
+
+        @param[in] stream The stream to save the GaloisKeys to
+        @throws std::exception if the GaloisKeys could not be written to stream
+        */
+        void save_mappable(std::ostream &stream) const;
+
+        /**
+        Maps a file written by save_mappable into memory, overwriting the current
+        GaloisKeys. The keys point directly to the mapped data, so nothing is copied
+        and each key is faulted in from the page cache only when first used; 
+        processes mapping the same file share the same physical pages. The mapping
+        lives as long as this GaloisKeys instance, while copies of it own their data.
+        No checking of the validity of the GaloisKeys data against encryption 
+        parameters is performed. This function should not be used unless the 
+        file comes from a fully trusted source.
+
+        @param[in] path The path of the file to map
+        @throws std::runtime_error if the file could not be mapped
+        @throws std::invalid_argument if the file is not a valid mapped GaloisKeys file
+        */
+        void unsafe_load_mapped(const std::string &path);
+
+        /**
+        Maps a file written by save_mappable into memory, overwriting the current
+        GaloisKeys. The metadata of every key is verified to be valid for the given
+        SEALContext. Unlike load, the key coefficients are not scanned since that
+        would defeat the purpose of mapping the file lazily.
+
+        @param[in] context The SEALContext
+        @param[in] path The path of the file to map
+        @throws std::invalid_argument if the context is not set or encryption
+        parameters are not valid
+        @throws std::runtime_error if the file could not be mapped
+        @throws std::invalid_argument if the file is not a valid mapped GaloisKeys file
+        @throws std::invalid_argument if the loaded GaloisKeys is invalid for the
+        context
+        */
+        inline void load_mapped(std::shared_ptr<SEALContext> context,
+            const std::string &path)
+        {
+            unsafe_load_mapped(path);
+            if (!is_metadata_valid_for(std::move(context)))
+            {
+                throw std::invalid_argument("GaloisKeys data is invalid");
+            }
+        }
+
+        /**
+        Returns whether the GaloisKeys data is backed by a memory-mapped file.
+        */
+        inline bool is_mapped() const noexcept
+        {
+            return static_cast<bool>(mapping_);
+        }
+
         /**
         Returns the currently used MemoryPoolHandle.
         */
@@ -233,6 +417,13 @@ namespace seal
         }
 
     private:
+        bool is_metadata_valid_for(std::shared_ptr<SEALContext> context) const noexcept;
+
+        void load_internal(std::istream &stream, std::shared_ptr<SEALContext> context);
+
+        std::size_t load_internal(const void *source, std::size_t size,
+            std::shared_ptr<SEALContext> context);
+
         MemoryPoolHandle pool_ = MemoryManager::GetPool();
 
         parms_id_type parms_id_ = parms_id_zero;
@@ -243,5 +434,15 @@ namespace seal
         std::vector<std::vector<Ciphertext>> keys_{};
 
         int decomposition_bit_count_ = 0;
+
+        /**
+        The seeds of the uniform polynomials of the keys, if known.
+        */
+        std::vector<std::vector<prng_seed_type>> seeds_{};
+
+        /**
+        The file mapping the keys point to, if any.
+        */
+        std::shared_ptr<util::MappedFile> mapping_{ nullptr };
     };
 }
@@ -131,6 +131,33 @@ namespace seal
         {
         }
 
+        /**
+        Creates a new IntArray that aliases an existing array of given size. No
+        memory is allocated and the IntArray does not take ownership of the data,
+        so the caller must keep the data alive for the lifetime of the IntArray.
+        Any later reallocation (e.g. through reserve, or resize beyond the aliased
+        size) moves the data into memory allocated from the given pool.
+
+        @param[in] data A pointer to the data to alias
+        @param[in] size The number of elements pointed to by data
+        @param[in] pool The MemoryPoolHandle used for any later reallocation
+        @throws std::invalid_argument if data is null and size is non-zero
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        inline static IntArray<T> Aliasing(T *data, size_type size,
+            MemoryPoolHandle pool = MemoryManager::GetPool())
+        {
+            if (!data && size)
+            {
+                throw std::invalid_argument("data cannot be null");
+            }
+            IntArray<T> result(std::move(pool));
+            result.capacity_ = size;
+            result.size_ = size;
+            result.data_ = util::Pointer<T>::Aliasing(data);
+            return result;
+        }
+
         /**
         Returns a pointer to the beginning of the array data.
         */
@@ -288,6 +315,14 @@ namespace seal
             return pool_;
         }
 
+        /**
+        Returns whether the IntArray aliases memory it does not own.
+        */
+        inline bool is_alias() const noexcept
+        {
+            return data_.is_alias();
+        }
+
         /**
         Releases any allocated memory to the memory pool and sets the size 
         and capacity of the array to zero.
@@ -441,6 +476,15 @@ namespace seal
             stream.exceptions(old_except_mask);
         }
 
+        /**
+        Returns the number of bytes save writes for the IntArray.
+        */
+        inline std::size_t save_size() const
+        {
+            return util::add_safe(sizeof(std::uint64_t),
+                util::mul_safe(size_, util::safe_cast<size_type>(sizeof(T))));
+        }
+
         /**
         Loads a IntArray from an input stream overwriting the current IntArray.
 
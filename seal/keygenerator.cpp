@@ -12,6 +12,7 @@
 #include "seal/util/clipnormal.h"
 #include "seal/util/polycore.h"
 #include "seal/util/smallntt.h"
+#include "seal/util/seededkeys.h"
 
 using namespace std;
 using namespace seal::util;
@@ -35,9 +36,36 @@ namespace seal
         sk_generated_ = false;
         pk_generated_ = false;
 
-        // Generate the secret and public key
-        generate_sk();
-        generate_pk();
+        // Generate the secret and public key from seeds drawn from the
+        // random generator of the encryption parameters
+        shared_ptr<UniformRandomGenerator> random(
+            context_->context_data()->parms().random_generator()->create());
+        generate_sk(ChaCha20PRNG::draw_seed(*random));
+        generate_pk(ChaCha20PRNG::draw_seed(*random));
+    }
+
+    KeyGenerator::KeyGenerator(shared_ptr<SEALContext> context,
+        const prng_seed_type &secret_seed) : context_(move(context))
+    {
+        // Verify parameters
+        if (!context_)
+        {
+            throw invalid_argument("invalid context");
+        }
+        if (!context_->parameters_set())
+        {
+            throw invalid_argument("encryption parameters are not set correctly");
+        }
+
+        // Secret key and public key have not been generated
+        sk_generated_ = false;
+        pk_generated_ = false;
+
+        // The first stream of the seed gives the secret key; the seed of the
+        // public uniform polynomial is drawn from the second one
+        generate_sk(secret_seed);
+        ChaCha20PRNG public_seed_random(secret_seed, 1);
+        generate_pk(ChaCha20PRNG::draw_seed(public_seed_random));
     }
 
     KeyGenerator::KeyGenerator(shared_ptr<SEALContext> context,
@@ -62,7 +90,9 @@ namespace seal
         sk_generated_ = true;
 
         // Generate the public key
-        generate_pk();
+        shared_ptr<UniformRandomGenerator> random(
+            context_->context_data()->parms().random_generator()->create());
+        generate_pk(ChaCha20PRNG::draw_seed(*random));
     }
 
     KeyGenerator::KeyGenerator(shared_ptr<SEALContext> context, 
@@ -109,7 +139,7 @@ namespace seal
         pk_generated_ = true;
     }
 
-    void KeyGenerator::generate_sk()
+    void KeyGenerator::generate_sk(const prng_seed_type &seed)
     {
         // Extract encryption parameters.
         auto &context_data = *context_->context_data();
@@ -121,20 +151,11 @@ namespace seal
         // Initialize secret key.
         secret_key_ = SecretKey();
         sk_generated_ = false;
-        secret_key_.data().resize(mul_safe(coeff_count, coeff_mod_count));
 
-        shared_ptr<UniformRandomGenerator> random(parms.random_generator()->create());
-
-        // Generate secret key
-        uint64_t *secret_key = secret_key_.data().data();
-        set_poly_coeffs_zero_one_negone(context_data, secret_key, random);
-
-        auto &small_ntt_tables = context_data.small_ntt_tables();
-        for (size_t i = 0; i < coeff_mod_count; i++)
-        {
-            // Transform the secret s into NTT representation. 
-            ntt_negacyclic_harvey(secret_key + (i * coeff_count), small_ntt_tables[i]);
-        }
+        // Generate secret key in NTT form
+        expand_secret_key_seed(seed, *context_, secret_key_.data());
+        secret_key_.seed_ = seed;
+        secret_key_.has_seed_ = true;
 
         // Set the secret_key_array to have size 1 (first power of secret) 
         secret_key_array_ = allocate_poly(coeff_count, coeff_mod_count, pool_);
@@ -149,7 +170,7 @@ namespace seal
         sk_generated_ = true;
     }
 
-    void KeyGenerator::generate_pk()
+    void KeyGenerator::generate_pk(const prng_seed_type &public_seed)
     {
         if (!sk_generated_)
         {
@@ -182,10 +203,12 @@ namespace seal
         // Generate public key: (pk[0],pk[1]) = ([-(as+e)]_q, a)
         uint64_t *secret_key = secret_key_.data().data();
 
-        // Sample a uniformly at random
+        // Sample a uniformly at random from its seed
         // Set pk[1] = a (we sample the NTT form directly)
         uint64_t *public_key_1 = public_key_.data().data(1);
-        set_poly_coeffs_uniform(context_data, public_key_1, random);
+        expand_public_key_seed(public_seed, *context_, public_key_.data());
+        public_key_.seed_ = public_seed;
+        public_key_.has_seed_ = true;
 
         // calculate a*s + e (mod q) and store in pk[0]
         auto &small_ntt_tables = context_data.small_ntt_tables();
@@ -229,6 +252,33 @@ namespace seal
     }
 
     RelinKeys KeyGenerator::relin_keys(int decomposition_bit_count, size_t count)
+    {
+        return relin_keys_internal(decomposition_bit_count, count,
+            context_->first_parms_id(), nullptr);
+    }
+
+    RelinKeys KeyGenerator::relin_keys(int decomposition_bit_count, size_t count,
+        ThreadPool &thread_pool)
+    {
+        return relin_keys_internal(decomposition_bit_count, count,
+            context_->first_parms_id(), &thread_pool);
+    }
+
+    RelinKeys KeyGenerator::relin_keys(int decomposition_bit_count, size_t count,
+        parms_id_type parms_id)
+    {
+        return relin_keys_internal(decomposition_bit_count, count, parms_id, nullptr);
+    }
+
+    RelinKeys KeyGenerator::relin_keys(int decomposition_bit_count, size_t count,
+        parms_id_type parms_id, ThreadPool &thread_pool)
+    {
+        return relin_keys_internal(decomposition_bit_count, count, parms_id,
+            &thread_pool);
+    }
+
+    RelinKeys KeyGenerator::relin_keys_internal(int decomposition_bit_count,
+        size_t count, parms_id_type parms_id, ThreadPool *thread_pool)
     {
         // Check to see if secret key and public key have been generated
         if (!sk_generated_)
@@ -250,13 +300,19 @@ namespace seal
             throw invalid_argument("decomposition_bit_count is not in the valid range");
         }
 
-        // Extract encryption parameters.
-        auto &context_data = *context_->context_data();
+        // Extract encryption parameters at the level of the keys.
+        auto context_data_ptr = context_->context_data(parms_id);
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("parms_id is not valid for encryption parameters");
+        }
+        auto &first_context_data = *context_->context_data();
+        auto &context_data = *context_data_ptr;
         auto &parms = context_data.parms();
         auto &coeff_modulus = parms.coeff_modulus();
         size_t coeff_count = parms.poly_modulus_degree();
         size_t coeff_mod_count = coeff_modulus.size();
-        auto &small_ntt_tables = context_data.small_ntt_tables();
+        size_t first_coeff_mod_count = first_context_data.parms().coeff_modulus().size();
 
         // Size check
         if (!product_fits_in(coeff_count, coeff_mod_count))
@@ -295,68 +351,33 @@ namespace seal
             }
         }
 
-        shared_ptr<UniformRandomGenerator> random(parms.random_generator()->create());
-
-        // Create relinearization keys.
-        auto noise(allocate_poly(coeff_count, coeff_mod_count, pool_));
-        auto temp(allocate_uint(coeff_count, pool_));
-
         // Make sure we have enough secret keys computed
-        compute_secret_key_array(context_data, count + 1);
+        // The powers are computed at the first level; the RNS components of
+        // every other level are a prefix of those
+        compute_secret_key_array(first_context_data, count + 1);
+
+        // Every key component gets the seed of its uniform polynomials
+        relin_keys.seeds_.assign(count, vector<prng_seed_type>(coeff_mod_count));
 
+        // Create relinearization keys. The keys for different powers of the
+        // secret key and different RNS components are independent.
         // assume the secret key is already transformed into NTT form. 
-        for (size_t k = 0; k < count; k++)
-        {
-            for (size_t l = 0; l < coeff_mod_count; l++)
-            {
-                // populate evaluate_keys_[k]
-                for (size_t i = 0; i < decomposition_factors[l].size(); i++)
-                {
-                    // generate NTT(a_i) and store in relin_keys_[k][l].second[i]
-                    uint64_t *eval_keys_first = relin_keys.data()[k][l].data(2 * i);
-                    uint64_t *eval_keys_second = relin_keys.data()[k][l].data(2 * i + 1);
-
-                    // We sample a_i directly in NTT form
-                    set_poly_coeffs_uniform(context_data, eval_keys_second, random);
-
-                    for (size_t j = 0; j < coeff_mod_count; j++)
-                    {
-                        // calculate a_i*s and store in relin_keys_[k].first[i]
-                        dyadic_product_coeffmod(eval_keys_second + (j * coeff_count), 
-                            secret_key_.data().data() + (j * coeff_count), 
-                            coeff_count, coeff_modulus[j], eval_keys_first + (j * coeff_count));
-                    }
-
-                    // generate NTT(e_i) 
-                    set_poly_coeffs_normal(context_data, noise.get(), random);
-                    for (size_t j = 0; j < coeff_mod_count; j++)
-                    {
-                        ntt_negacyclic_harvey(noise.get() + (j * coeff_count), small_ntt_tables[j]);
-
-                        // add e_i into relin_keys_[k].first[i]
-                        add_poly_poly_coeffmod(
-                            noise.get() + (j * coeff_count), eval_keys_first + (j * coeff_count), 
-                            coeff_count, coeff_modulus[j], eval_keys_first + (j * coeff_count));
-
-                        // negate value in relin_keys_[k].first[i]
-                        negate_poly_coeffmod(
-                            eval_keys_first + (j * coeff_count), coeff_count, coeff_modulus[j],
-                            eval_keys_first + (j * coeff_count));
-
-                        // multiply w^i * s^(k+2)
-                        uint64_t decomposition_factor_mod = decomposition_factors[l][i] & 
-                            static_cast<uint64_t>(-static_cast<int64_t>(l == j));
-                        multiply_poly_scalar_coeffmod(
-                            secret_key_array_.get() + (k + 1) * coeff_count * coeff_mod_count + (j * coeff_count), 
-                            coeff_count, decomposition_factor_mod, coeff_modulus[j], temp.get());
-
-                        // add w^i . s^(k+2) into relin_keys_[k].first[i]
-                        add_poly_poly_coeffmod(eval_keys_first + (j * coeff_count), temp.get(), coeff_count, 
-                            coeff_modulus[j], eval_keys_first + (j * coeff_count));
-                    }
-                }
-            }
-        }
+        parallel_for_random(count * coeff_mod_count, thread_pool,
+            [&](size_t index, shared_ptr<UniformRandomGenerator> random)
+        {
+            size_t k = index / coeff_mod_count;
+            size_t l = index % coeff_mod_count;
+
+            // The l-th RNS component of s^(k+2)
+            const uint64_t *secret_key_power = secret_key_array_.get() + 
+                (k + 1) * coeff_count * first_coeff_mod_count + (l * coeff_count);
+            // The seed of the uniform polynomials is public, while the noise is
+            // sampled from the remainder of the stream
+            relin_keys.seeds_[k][l] = ChaCha20PRNG::draw_seed(*random);
+            generate_kswitch_component(context_data, decomposition_factors[l], l,
+                secret_key_power, relin_keys.seeds_[k][l], move(random),
+                relin_keys.data()[k][l]);
+        });
 
         // Set decomposition_bit_count
         relin_keys.decomposition_bit_count_ = decomposition_bit_count;
@@ -370,159 +391,76 @@ namespace seal
     GaloisKeys KeyGenerator::galois_keys(int decomposition_bit_count, 
         const vector<uint64_t> &galois_elts)
     {
-        // Check to see if secret key and public key have been generated
-        if (!sk_generated_)
-        {
-            throw logic_error("cannot generate galois keys for unspecified secret key");
-        }
-
-        // Check that decomposition_bit_count is in correct interval
-        if (decomposition_bit_count < SEAL_DBC_MIN || 
-            decomposition_bit_count > SEAL_DBC_MAX)
-        {
-            throw invalid_argument("decomposition_bit_count is not on the valid range");
-        }
-
-        // Extract encryption parameters.
-        auto &context_data = *context_->context_data();
-        auto &parms = context_data.parms();
-        auto &coeff_modulus = parms.coeff_modulus();
-        size_t coeff_count = parms.poly_modulus_degree();
-        size_t coeff_mod_count = coeff_modulus.size();
-        int coeff_count_power = get_power_of_two(coeff_count);
-        auto &small_ntt_tables = context_data.small_ntt_tables();
-
-        // Size check
-        if (!product_fits_in(coeff_count, coeff_mod_count, size_t(2)))
-        {
-            throw logic_error("invalid parameters");
-        }
-
-        // Create the GaloisKeys object to return
-        GaloisKeys galois_keys;
-
-        // The max number of keys is equal to number of coefficients
-        galois_keys.data().resize(coeff_count);
-
-        // Initialize decomposition_factors
-        vector<vector<uint64_t>> decomposition_factors;
-        populate_decomposition_factors(context_data, decomposition_bit_count,
-            decomposition_factors);
-
-        for (uint64_t galois_elt : galois_elts)
-        {
-            // Verify coprime conditions.
-            if (!(galois_elt & 1) || (galois_elt >= 2 * coeff_count))
-            {
-                throw invalid_argument("galois element is not valid");
-            }
-
-            // Do we already have the key?
-            if (galois_keys.has_key(galois_elt))
-            {
-                continue;
-            }
-
-            // Rotate secret key for each coeff_modulus
-            auto rotated_secret_key(allocate_poly(coeff_count, coeff_mod_count, pool_));
-            for (size_t i = 0; i < coeff_mod_count; i++)
-            {
-                apply_galois_ntt(secret_key_.data().data() + (i * coeff_count),
-                    coeff_count_power, galois_elt,
-                    rotated_secret_key.get() + (i * coeff_count));
-            }
-
-            // Initialize galois key
-            // This is the location in the galois_keys vector
-            uint64_t index = (galois_elt - 1) >> 1;
-            galois_keys.data()[index].reserve(coeff_mod_count);
+        return galois_keys_internal(decomposition_bit_count, galois_elts,
+            context_->first_parms_id(), nullptr);
+    }
 
-            for (size_t i = 0; i < coeff_mod_count; i++)
-            {
-                galois_keys.data()[index].emplace_back(
-                    context_, parms.parms_id(),
-                    2 * decomposition_factors[i].size(),
-                    galois_keys.pool());
+    GaloisKeys KeyGenerator::galois_keys(int decomposition_bit_count, 
+        const vector<uint64_t> &galois_elts, ThreadPool &thread_pool)
+    {
+        return galois_keys_internal(decomposition_bit_count, galois_elts,
+            context_->first_parms_id(), &thread_pool);
+    }
 
-                // Resize to right size too (above only allocated)
-                // This is slightly odd use of Ciphertext as a container
-                galois_keys.data()[index].back().resize(
-                    2 * decomposition_factors[i].size());
+    GaloisKeys KeyGenerator::galois_keys(int decomposition_bit_count, 
+        const vector<uint64_t> &galois_elts, parms_id_type parms_id)
+    {
+        return galois_keys_internal(decomposition_bit_count, galois_elts,
+            parms_id, nullptr);
+    }
 
-                // The Galois keys are in NTT form
-                galois_keys.data()[index].back().is_ntt_form() = true;
-            }
+    GaloisKeys KeyGenerator::galois_keys(int decomposition_bit_count, 
+        const vector<uint64_t> &galois_elts, parms_id_type parms_id,
+        ThreadPool &thread_pool)
+    {
+        return galois_keys_internal(decomposition_bit_count, galois_elts,
+            parms_id, &thread_pool);
+    }
 
-            shared_ptr<UniformRandomGenerator> random(parms.random_generator()->create());
+    GaloisKeys KeyGenerator::galois_keys(int decomposition_bit_count, 
+        const vector<int> &steps)
+    {
+        return galois_keys_internal(decomposition_bit_count,
+            steps_to_galois_elts(steps), context_->first_parms_id(), nullptr);
+    }
 
-            // Create Galois keys.
-            auto noise(allocate_poly(coeff_count, coeff_mod_count, pool_));
-            auto temp(allocate_uint(coeff_count, pool_));
+    GaloisKeys KeyGenerator::galois_keys(int decomposition_bit_count, 
+        const vector<int> &steps, ThreadPool &thread_pool)
+    {
+        return galois_keys_internal(decomposition_bit_count,
+            steps_to_galois_elts(steps), context_->first_parms_id(), &thread_pool);
+    }
 
-            for (size_t l = 0; l < coeff_mod_count; l++)
-            {
-                // populate galois_keys_[k]
-                for (size_t i = 0; i < decomposition_factors[l].size(); i++)
-                {
-                    // generate NTT(a_i) and store in galois_keys_[k][l].second[i]
-                    uint64_t *eval_keys_first = galois_keys.data()[index][l].data(2 * i);
-                    uint64_t *eval_keys_second = galois_keys.data()[index][l].data(2 * i + 1);
-
-                    // We sample a_i in NTT form directly
-                    set_poly_coeffs_uniform(context_data, eval_keys_second, random);
-                    for (size_t j = 0; j < coeff_mod_count; j++)
-                    {
-                        // calculate a_i*s and store in galois_keys_[k].first[i]
-                        dyadic_product_coeffmod(eval_keys_second + (j * coeff_count), 
-                            secret_key_.data().data() + (j * coeff_count), 
-                            coeff_count, coeff_modulus[j], 
-                            eval_keys_first + (j * coeff_count));
-                    }
-
-                    // generate NTT(e_i) 
-                    set_poly_coeffs_normal(context_data, noise.get(), random);
-                    for (size_t j = 0; j < coeff_mod_count; j++)
-                    {
-                        ntt_negacyclic_harvey(
-                            noise.get() + (j * coeff_count), small_ntt_tables[j]);
-
-                        // add NTT(e_i) into galois_keys_[k].first[i]
-                        add_poly_poly_coeffmod(noise.get() + (j * coeff_count), 
-                            eval_keys_first + (j * coeff_count), 
-                            coeff_count, coeff_modulus[j],
-                            eval_keys_first + (j * coeff_count));
-
-                        // negate value in galois_keys_[k].first[i]
-                        negate_poly_coeffmod(
-                            eval_keys_first + (j * coeff_count), coeff_count, 
-                            coeff_modulus[j], eval_keys_first + (j * coeff_count));
-
-                        // multiply w^i * rotated_secret_key
-                        uint64_t decomposition_factor_mod = decomposition_factors[l][i] & 
-                            static_cast<uint64_t>(-static_cast<int64_t>(l == j));
-                        multiply_poly_scalar_coeffmod(rotated_secret_key.get() + (j * coeff_count), 
-                            coeff_count, decomposition_factor_mod, 
-                            coeff_modulus[j], temp.get());
-
-                        // add w^i * rotated_secret_key into galois_keys_[k].first[i]
-                        add_poly_poly_coeffmod(eval_keys_first + (j * coeff_count), temp.get(), 
-                            coeff_count, coeff_modulus[j], eval_keys_first + (j * coeff_count));
-                    }
-                }
-            }
-        }
+    GaloisKeys KeyGenerator::galois_keys(int decomposition_bit_count, 
+        const vector<int> &steps, parms_id_type parms_id)
+    {
+        return galois_keys_internal(decomposition_bit_count,
+            steps_to_galois_elts(steps), parms_id, nullptr);
+    }
 
-        // Set decomposition_bit_count
-        galois_keys.decomposition_bit_count_ = decomposition_bit_count;
+    GaloisKeys KeyGenerator::galois_keys(int decomposition_bit_count, 
+        const vector<int> &steps, parms_id_type parms_id, ThreadPool &thread_pool)
+    {
+        return galois_keys_internal(decomposition_bit_count,
+            steps_to_galois_elts(steps), parms_id, &thread_pool);
+    }
 
-        // Set the parms_id
-        galois_keys.parms_id_ = parms.parms_id();
+    GaloisKeys KeyGenerator::galois_keys(int decomposition_bit_count)
+    {
+        return galois_keys_internal(decomposition_bit_count, logn_galois_elts(),
+            context_->first_parms_id(), nullptr);
+    }
 
-        return galois_keys;
+    GaloisKeys KeyGenerator::galois_keys(int decomposition_bit_count,
+        ThreadPool &thread_pool)
+    {
+        return galois_keys_internal(decomposition_bit_count, logn_galois_elts(),
+            context_->first_parms_id(), &thread_pool);
     }
 
-    GaloisKeys KeyGenerator::galois_keys(int decomposition_bit_count, 
-        const vector<int> &steps)
+    GaloisKeys KeyGenerator::galois_keys_internal(int decomposition_bit_count, 
+        const vector<uint64_t> &galois_elts, parms_id_type parms_id,
+        ThreadPool *thread_pool)
     {
         // Check to see if secret key and public key have been generated
         if (!sk_generated_)
@@ -537,38 +475,38 @@ namespace seal
             throw invalid_argument("decomposition_bit_count is not on the valid range");
         }
 
-        // Extract encryption parameters.
+        // Create the GaloisKeys object to return
+        GaloisKeys galois_keys;
+
+        // Set decomposition_bit_count
+        galois_keys.decomposition_bit_count_ = decomposition_bit_count;
+
+        // Set the parms_id; generate_galois_keys verifies it
+        galois_keys.parms_id_ = parms_id;
+
+        generate_galois_keys(galois_elts, galois_keys, thread_pool);
+
+        return galois_keys;
+    }
+
+    vector<uint64_t> KeyGenerator::steps_to_galois_elts(const vector<int> &steps) const
+    {
         auto &context_data = *context_->context_data();
         if (!context_data.qualifiers().using_batching)
         {
             throw logic_error("encryption parameters do not support batching");
         }
 
-        auto &parms = context_data.parms();
-        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_count = context_data.parms().poly_modulus_degree();
 
         vector<uint64_t> galois_elts;
         transform(steps.begin(), steps.end(), back_inserter(galois_elts),
             [&](auto s) { return steps_to_galois_elt(s, coeff_count); });
-
-        return galois_keys(decomposition_bit_count, galois_elts);
+        return galois_elts;
     }
 
-    GaloisKeys KeyGenerator::galois_keys(int decomposition_bit_count)
+    vector<uint64_t> KeyGenerator::logn_galois_elts() const
     {
-        // Check to see if secret key and public key have been generated
-        if (!sk_generated_)
-        {
-            throw logic_error("cannot generate galois keys for unspecified secret key");
-        }
-
-        // Check that decomposition_bit_count is in correct interval
-        if (decomposition_bit_count < SEAL_DBC_MIN || 
-            decomposition_bit_count > SEAL_DBC_MAX)
-        {
-            throw invalid_argument("decomposition_bit_count is not in the valid range");
-        }
-
         size_t coeff_count = context_->context_data()->parms().poly_modulus_degree();
         uint64_t m = coeff_count << 1;
         int logn = get_power_of_two(static_cast<uint64_t>(coeff_count));
@@ -594,45 +532,212 @@ namespace seal
             neg_two_power_of_three &= (m - 1);
         }
 
-        return galois_keys(decomposition_bit_count, logn_galois_keys);
+        return logn_galois_keys;
     }
 
-    void KeyGenerator::set_poly_coeffs_zero_one_negone(
-        const SEALContext::ContextData &context_data, 
-        uint64_t *poly, shared_ptr<UniformRandomGenerator> random) const
+    void KeyGenerator::generate_galois_keys(const vector<uint64_t> &galois_elts,
+        GaloisKeys &galois_keys, ThreadPool *thread_pool)
+    {
+        // Check to see if secret key and public key have been generated
+        if (!sk_generated_)
+        {
+            throw logic_error("cannot generate galois keys for unspecified secret key");
+        }
+
+        // Extract encryption parameters at the level of the keys.
+        auto context_data_ptr = context_->context_data(galois_keys.parms_id());
+        if (!context_data_ptr)
+        {
+            throw invalid_argument("galois_keys is not valid for encryption parameters");
+        }
+        auto &context_data = *context_data_ptr;
+        auto &parms = context_data.parms();
+        size_t coeff_count = parms.poly_modulus_degree();
+        size_t coeff_mod_count = parms.coeff_modulus().size();
+
+        // Size check
+        if (!product_fits_in(coeff_count, coeff_mod_count, size_t(2)))
+        {
+            throw logic_error("invalid parameters");
+        }
+
+        // Verify the keys that are extended
+        int decomposition_bit_count = galois_keys.decomposition_bit_count();
+        if (decomposition_bit_count < SEAL_DBC_MIN ||
+            decomposition_bit_count > SEAL_DBC_MAX ||
+            galois_keys.data().size() > coeff_count)
+        {
+            throw invalid_argument("galois_keys is not valid for encryption parameters");
+        }
+
+        // Collect the Galois elements that do not have a key yet
+        vector<uint64_t> new_galois_elts;
+        for (uint64_t galois_elt : galois_elts)
+        {
+            // Verify coprime conditions.
+            if (!(galois_elt & 1) || (galois_elt >= 2 * coeff_count))
+            {
+                throw invalid_argument("galois element is not valid");
+            }
+
+            // Do we already have the key?
+            if (!galois_keys.has_key(galois_elt))
+            {
+                new_galois_elts.push_back(galois_elt);
+            }
+        }
+        sort(new_galois_elts.begin(), new_galois_elts.end());
+        new_galois_elts.erase(unique(new_galois_elts.begin(), new_galois_elts.end()),
+            new_galois_elts.end());
+
+        // Initialize decomposition_factors
+        vector<vector<uint64_t>> decomposition_factors;
+        populate_decomposition_factors(context_data, decomposition_bit_count,
+            decomposition_factors);
+
+        // Initialize the new Galois keys. They are stored in galois_keys only once
+        // all of them have been generated.
+        vector<vector<Ciphertext>> new_keys(new_galois_elts.size());
+        vector<vector<prng_seed_type>> new_seeds(new_galois_elts.size(),
+            vector<prng_seed_type>(coeff_mod_count));
+        for (auto &new_key : new_keys)
+        {
+            new_key.reserve(coeff_mod_count);
+            for (size_t i = 0; i < coeff_mod_count; i++)
+            {
+                new_key.emplace_back(
+                    context_, parms.parms_id(),
+                    2 * decomposition_factors[i].size(),
+                    galois_keys.pool());
+
+                // Resize to right size too (above only allocated)
+                // This is slightly odd use of Ciphertext as a container
+                new_key.back().resize(2 * decomposition_factors[i].size());
+
+                // The Galois keys are in NTT form
+                new_key.back().is_ntt_form() = true;
+            }
+        }
+
+        // Create Galois keys. The keys for different Galois elements and
+        // different RNS components are independent.
+        parallel_for_random(new_keys.size() * coeff_mod_count, thread_pool,
+            [&](size_t index, shared_ptr<UniformRandomGenerator> random)
+        {
+            size_t key_index = index / coeff_mod_count;
+            size_t l = index % coeff_mod_count;
+
+            // Only the l-th RNS component of the rotated secret key is needed
+            auto rotated_secret_key(allocate_uint(coeff_count, pool_));
+            apply_galois_ntt(secret_key_.data().data() + (l * coeff_count),
+                coeff_count,
+                context_->galois_tool()->permutation_ntt(new_galois_elts[key_index]),
+                rotated_secret_key.get());
+            new_seeds[key_index][l] = ChaCha20PRNG::draw_seed(*random);
+            generate_kswitch_component(context_data, decomposition_factors[l], l,
+                rotated_secret_key.get(), new_seeds[key_index][l], move(random),
+                new_keys[key_index][l]);
+        });
+
+        // The max number of keys is equal to number of coefficients
+        galois_keys.data().resize(coeff_count);
+        galois_keys.seeds_.resize(coeff_count);
+        for (size_t key_index = 0; key_index < new_keys.size(); key_index++)
+        {
+            // This is the location in the galois_keys vector
+            uint64_t index = (new_galois_elts[key_index] - 1) >> 1;
+            galois_keys.data()[index] = move(new_keys[key_index]);
+            galois_keys.seeds_[index] = move(new_seeds[key_index]);
+        }
+    }
+
+    void KeyGenerator::generate_kswitch_component(
+        const SEALContext::ContextData &context_data,
+        const vector<uint64_t> &decomposition_factors, size_t coeff_mod_index,
+        const uint64_t *new_key_mod, const prng_seed_type &seed,
+        shared_ptr<UniformRandomGenerator> random, Ciphertext &destination) const
     {
         // Extract encryption parameters.
         auto &parms = context_data.parms();
         auto &coeff_modulus = parms.coeff_modulus();
         size_t coeff_count = parms.poly_modulus_degree();
         size_t coeff_mod_count = coeff_modulus.size();
+        auto &small_ntt_tables = context_data.small_ntt_tables();
 
-        RandomToStandardAdapter engine(random);
-        uniform_int_distribution<int> dist(-1, 1);
+        auto noise(allocate_poly(coeff_count, coeff_mod_count, pool_));
+        auto temp(allocate_uint(coeff_count, pool_));
 
-        for (size_t i = 0; i < coeff_count; i++)
+        // We sample all a_i in NTT form directly from the seed, so that they
+        // can be stored as the seed only
+        expand_kswitch_seed(seed, *context_, destination);
+
+        for (size_t i = 0; i < decomposition_factors.size(); i++)
         {
-            int rand_index = dist(engine);
-            if (rand_index == 1)
+            // NTT(a_i) is stored in destination.second[i]
+            uint64_t *eval_keys_first = destination.data(2 * i);
+            uint64_t *eval_keys_second = destination.data(2 * i + 1);
+
+            for (size_t j = 0; j < coeff_mod_count; j++)
             {
-                for (size_t j = 0; j < coeff_mod_count; j++)
-                {
-                    poly[i + (j * coeff_count)] = 1;
-                }
+                // calculate a_i*s and store in destination.first[i]
+                dyadic_product_coeffmod(eval_keys_second + (j * coeff_count), 
+                    secret_key_.data().data() + (j * coeff_count), 
+                    coeff_count, coeff_modulus[j], 
+                    eval_keys_first + (j * coeff_count));
             }
-            else if (rand_index == -1)
+
+            // generate NTT(e_i) 
+            set_poly_coeffs_normal(context_data, noise.get(), random);
+            for (size_t j = 0; j < coeff_mod_count; j++)
             {
-                for (size_t j = 0; j < coeff_mod_count; j++)
-                {
-                    poly[i + (j * coeff_count)] = coeff_modulus[j].value() - 1;
-                }
+                ntt_negacyclic_harvey(
+                    noise.get() + (j * coeff_count), small_ntt_tables[j]);
+
+                // add NTT(e_i) into destination.first[i]
+                add_poly_poly_coeffmod(noise.get() + (j * coeff_count), 
+                    eval_keys_first + (j * coeff_count), 
+                    coeff_count, coeff_modulus[j],
+                    eval_keys_first + (j * coeff_count));
+
+                // negate value in destination.first[i]
+                negate_poly_coeffmod(
+                    eval_keys_first + (j * coeff_count), coeff_count, 
+                    coeff_modulus[j], eval_keys_first + (j * coeff_count));
             }
-            else
+
+            // w^i * new_key is zero modulo all other RNS components, so it only
+            // needs to be added to the coeff_mod_index-th one
+            uint64_t *eval_keys_first_mod = eval_keys_first + 
+                (coeff_mod_index * coeff_count);
+            multiply_poly_scalar_coeffmod(new_key_mod, coeff_count,
+                decomposition_factors[i], coeff_modulus[coeff_mod_index], temp.get());
+            add_poly_poly_coeffmod(eval_keys_first_mod, temp.get(), coeff_count,
+                coeff_modulus[coeff_mod_index], eval_keys_first_mod);
+        }
+    }
+
+    void KeyGenerator::parallel_for_random(size_t count, ThreadPool *thread_pool,
+        const function<void(size_t, shared_ptr<UniformRandomGenerator>)> &task) const
+    {
+        // Every call gets the stream of its own index, so the random numbers a
+        // call uses do not depend on the order in which the calls run
+        auto &parms = context_->context_data()->parms();
+        prng_seed_type seed = ChaCha20PRNG::draw_seed(
+            *parms.random_generator()->create());
+        auto run_task = [&](size_t index)
+        {
+            task(index, make_shared<ChaCha20PRNG>(seed, static_cast<uint64_t>(index)));
+        };
+
+        if (thread_pool)
+        {
+            thread_pool->parallel_for(count, run_task);
+        }
+        else
+        {
+            for (size_t index = 0; index < count; index++)
             {
-                for (size_t j = 0; j < coeff_mod_count; j++)
-                {
-                    poly[i + (j * coeff_count)] = 0;
-                }
+                run_task(index);
             }
         }
     }
@@ -685,31 +790,6 @@ namespace seal
         }
     }
 
-    void KeyGenerator::set_poly_coeffs_uniform(
-        const SEALContext::ContextData &context_data,
-        uint64_t *poly, shared_ptr<UniformRandomGenerator> random) const
-    {
-        // Extract encryption parameters.
-        auto &parms = context_data.parms();
-        auto &coeff_modulus = parms.coeff_modulus();
-        size_t coeff_count = parms.poly_modulus_degree();
-        size_t coeff_mod_count = coeff_modulus.size();
-
-        // Set up source of randomness which produces random things of size 32 bit
-        RandomToStandardAdapter engine(random);
-
-        for (size_t j = 0; j < coeff_mod_count; j++)
-        {
-            uint64_t current_modulus = coeff_modulus[j].value();
-            for (size_t i = 0; i < coeff_count; i++, poly++)
-            {
-                uint64_t new_coeff = (static_cast<uint64_t>(engine()) << 32) + 
-                    static_cast<uint64_t>(engine());
-                *poly = new_coeff % current_modulus; 
-            }
-        }
-    }
-
     const SecretKey &KeyGenerator::secret_key() const
     {
         if (!sk_generated_)
@@ -848,18 +928,5 @@ namespace seal
                 current_smallmod >>= decomposition_bit_count;
             }
         }
-
-        // We need to ensure that the total number of decomposition factors does not 
-        // exceed 63 for lazy reduction in relinearization to work
-        size_t total_ev_factor_count = 0;
-        for (size_t i = 0; i < coeff_mod_count; i++)
-        {
-            total_ev_factor_count = 
-                add_safe(total_ev_factor_count, decomposition_factors[i].size());
-        }
-        if (total_ev_factor_count > 63)
-        {
-            throw invalid_argument("decomposition_bit_count is too small");
-        }
     }
 }
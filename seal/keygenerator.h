@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <random>
+#include <functional>
 #include "seal/context.h"
 #include "seal/util/smallntt.h"
 #include "seal/memorymanager.h"
@@ -13,6 +14,7 @@
 #include "seal/relinkeys.h"
 #include "seal/galoiskeys.h"
 #include "seal/randomgen.h"
+#include "seal/threadpool.h"
 
 namespace seal
 {
@@ -39,6 +41,23 @@ namespace seal
         */
         KeyGenerator(std::shared_ptr<SEALContext> context);
 
+        /**
+        Creates a KeyGenerator initialized with the specified SEALContext, and
+        derives the secret key deterministically from the given 256-bit seed, so
+        that the same seed always gives the same secret key. The seed must be kept
+        as secret as the secret key itself. The seed of the uniform polynomial of
+        the public key is derived from it as well, while the noise of the public
+        key is sampled fresh. The secret key can be saved as the seed alone with
+        SecretKey::save_seeded.
+
+        @param[in] context The SEALContext
+        @param[in] secret_seed The seed to derive the secret key from
+        @throws std::invalid_argument if the context is not set or encryption
+        parameters are not valid
+        */
+        KeyGenerator(std::shared_ptr<SEALContext> context,
+            const prng_seed_type &secret_seed);
+
         /**
         Creates an KeyGenerator instance initialized with the specified SEALContext 
         and specified previously secret key. This can e.g. be used to increase 
@@ -92,6 +111,57 @@ namespace seal
         */
         RelinKeys relin_keys(int decomposition_bit_count, std::size_t count = 1);
 
+        /**
+        Generates and returns the specified number of relinearization keys,
+        generating the parts of the keys for different keys and RNS components
+        concurrently on the given ThreadPool. Each part is generated with its own
+        random number generator derived from a single generator created by the
+        random number generator factory of the encryption parameters.
+
+        @param[in] decomposition_bit_count The decomposition bit count
+        @param[in] count The number of relinearization keys to generate
+        @param[in] thread_pool The ThreadPool to generate the keys on
+        @throws std::invalid_argument if decomposition_bit_count is not within [1, 60]
+        @throws std::invalid_argument if count is zero or too large
+        */
+        RelinKeys relin_keys(int decomposition_bit_count, std::size_t count,
+            ThreadPool &thread_pool);
+
+        /**
+        Generates and returns the specified number of relinearization keys for the
+        level of the modulus switching chain given by parms_id. The keys only have
+        components for the primes of that level, so they are smaller and faster
+        to use than keys for the first level. They can be used to relinearize
+        ciphertexts at the given level and at every level below it.
+
+        @param[in] decomposition_bit_count The decomposition bit count
+        @param[in] count The number of relinearization keys to generate
+        @param[in] parms_id The parms_id of the level to generate the keys for
+        @throws std::invalid_argument if decomposition_bit_count is not within [1, 60]
+        @throws std::invalid_argument if count is zero or too large
+        @throws std::invalid_argument if parms_id is not valid for the encryption
+        parameters
+        */
+        RelinKeys relin_keys(int decomposition_bit_count, std::size_t count,
+            parms_id_type parms_id);
+
+        /**
+        Generates and returns the specified number of relinearization keys for the
+        level of the modulus switching chain given by parms_id, generating the
+        parts of the keys concurrently on the given ThreadPool.
+
+        @param[in] decomposition_bit_count The decomposition bit count
+        @param[in] count The number of relinearization keys to generate
+        @param[in] parms_id The parms_id of the level to generate the keys for
+        @param[in] thread_pool The ThreadPool to generate the keys on
+        @throws std::invalid_argument if decomposition_bit_count is not within [1, 60]
+        @throws std::invalid_argument if count is zero or too large
+        @throws std::invalid_argument if parms_id is not valid for the encryption
+        parameters
+        */
+        RelinKeys relin_keys(int decomposition_bit_count, std::size_t count,
+            parms_id_type parms_id, ThreadPool &thread_pool);
+
         /**
         Generates and returns Galois keys. This function creates specific Galois 
         keys that can be used to apply specific Galois automorphisms on encrypted 
@@ -115,6 +185,59 @@ namespace seal
         GaloisKeys galois_keys(int decomposition_bit_count,
             const std::vector<std::uint64_t> &galois_elts);
 
+        /**
+        Generates and returns Galois keys for the given Galois elements, generating
+        the parts of the keys for different Galois elements and RNS components
+        concurrently on the given ThreadPool. Each part is generated with its own
+        random number generator derived from a single generator created by the
+        random number generator factory of the encryption parameters.
+
+        @param[in] decomposition_bit_count The decomposition bit count
+        @param[in] galois_elts The Galois elements for which to generate keys
+        @param[in] thread_pool The ThreadPool to generate the keys on
+        @throws std::invalid_argument if decomposition_bit_count is not within [1, 60]
+        @throws std::invalid_argument if the Galois elements are not valid
+        */
+        GaloisKeys galois_keys(int decomposition_bit_count,
+            const std::vector<std::uint64_t> &galois_elts, ThreadPool &thread_pool);
+
+        /**
+        Generates and returns Galois keys for the given Galois elements at the
+        level of the modulus switching chain given by parms_id. The keys only have
+        components for the primes of that level, so they are smaller and faster
+        to use than keys for the first level. They can be used for ciphertexts at
+        the given level and at every level below it. Keys added later with
+        extend_galois_keys are generated for the same level.
+
+        @param[in] decomposition_bit_count The decomposition bit count
+        @param[in] galois_elts The Galois elements for which to generate keys
+        @param[in] parms_id The parms_id of the level to generate the keys for
+        @throws std::invalid_argument if decomposition_bit_count is not within [1, 60]
+        @throws std::invalid_argument if the Galois elements are not valid
+        @throws std::invalid_argument if parms_id is not valid for the encryption
+        parameters
+        */
+        GaloisKeys galois_keys(int decomposition_bit_count,
+            const std::vector<std::uint64_t> &galois_elts, parms_id_type parms_id);
+
+        /**
+        Generates and returns Galois keys for the given Galois elements at the
+        level of the modulus switching chain given by parms_id, generating the
+        parts of the keys concurrently on the given ThreadPool.
+
+        @param[in] decomposition_bit_count The decomposition bit count
+        @param[in] galois_elts The Galois elements for which to generate keys
+        @param[in] parms_id The parms_id of the level to generate the keys for
+        @param[in] thread_pool The ThreadPool to generate the keys on
+        @throws std::invalid_argument if decomposition_bit_count is not within [1, 60]
+        @throws std::invalid_argument if the Galois elements are not valid
+        @throws std::invalid_argument if parms_id is not valid for the encryption
+        parameters
+        */
+        GaloisKeys galois_keys(int decomposition_bit_count,
+            const std::vector<std::uint64_t> &galois_elts, parms_id_type parms_id,
+            ThreadPool &thread_pool);
+
         /**
         Generates and returns Galois keys. This function creates specific Galois 
         keys that can be used to apply specific Galois automorphisms on encrypted 
@@ -134,6 +257,60 @@ namespace seal
         GaloisKeys galois_keys(int decomposition_bit_count,
             const std::vector<int> &steps);
 
+        /**
+        Generates and returns Galois keys for the given rotation step counts,
+        generating the parts of the keys for different step counts and RNS
+        components concurrently on the given ThreadPool.
+
+        @param[in] decomposition_bit_count The decomposition bit count
+        @param[in] steps The rotation step counts for which to generate keys
+        @param[in] thread_pool The ThreadPool to generate the keys on
+        @throws std::logic_error if the encryption parameters do not support batching
+        and scheme is scheme_type::BFV
+        @throws std::invalid_argument if decomposition_bit_count is not within [1, 60]
+        @throws std::invalid_argument if the step counts are not valid
+        */
+        GaloisKeys galois_keys(int decomposition_bit_count,
+            const std::vector<int> &steps, ThreadPool &thread_pool);
+
+        /**
+        Generates and returns Galois keys for the given rotation step counts at the
+        level of the modulus switching chain given by parms_id. The keys can be
+        used for ciphertexts at the given level and at every level below it.
+
+        @param[in] decomposition_bit_count The decomposition bit count
+        @param[in] steps The rotation step counts for which to generate keys
+        @param[in] parms_id The parms_id of the level to generate the keys for
+        @throws std::logic_error if the encryption parameters do not support batching
+        and scheme is scheme_type::BFV
+        @throws std::invalid_argument if decomposition_bit_count is not within [1, 60]
+        @throws std::invalid_argument if the step counts are not valid
+        @throws std::invalid_argument if parms_id is not valid for the encryption
+        parameters
+        */
+        GaloisKeys galois_keys(int decomposition_bit_count,
+            const std::vector<int> &steps, parms_id_type parms_id);
+
+        /**
+        Generates and returns Galois keys for the given rotation step counts at the
+        level of the modulus switching chain given by parms_id, generating the
+        parts of the keys concurrently on the given ThreadPool.
+
+        @param[in] decomposition_bit_count The decomposition bit count
+        @param[in] steps The rotation step counts for which to generate keys
+        @param[in] parms_id The parms_id of the level to generate the keys for
+        @param[in] thread_pool The ThreadPool to generate the keys on
+        @throws std::logic_error if the encryption parameters do not support batching
+        and scheme is scheme_type::BFV
+        @throws std::invalid_argument if decomposition_bit_count is not within [1, 60]
+        @throws std::invalid_argument if the step counts are not valid
+        @throws std::invalid_argument if parms_id is not valid for the encryption
+        parameters
+        */
+        GaloisKeys galois_keys(int decomposition_bit_count,
+            const std::vector<int> &steps, parms_id_type parms_id,
+            ThreadPool &thread_pool);
+
         /**
         Generates and returns Galois keys. This function creates logarithmically 
         many (in degree of the polynomial modulus) Galois keys that is sufficient 
@@ -145,6 +322,119 @@ namespace seal
         */
         GaloisKeys galois_keys(int decomposition_bit_count);
 
+        /**
+        Generates and returns the logarithmically many Galois keys that are
+        sufficient to apply any Galois automorphism, generating the parts of the
+        keys for different Galois elements and RNS components concurrently on the
+        given ThreadPool.
+
+        @param[in] decomposition_bit_count The decomposition bit count
+        @param[in] thread_pool The ThreadPool to generate the keys on
+        @throws std::invalid_argument if decomposition_bit_count is not within [1, 60]
+        */
+        GaloisKeys galois_keys(int decomposition_bit_count, ThreadPool &thread_pool);
+
+        /**
+        Generates Galois keys for the given Galois elements and adds them to an
+        existing set of Galois keys. Keys that galois_keys already contains are
+        left unchanged. Starting from an empty set, e.g. one returned by
+        galois_keys(decomposition_bit_count, std::vector<std::uint64_t>{}), this
+        makes it possible to generate keys only for the automorphisms a workload
+        actually uses, when it first needs them. Evaluator uses such a key directly
+        instead of composing the automorphism from several key switchings. The new
+        keys use the decomposition bit count and the level of galois_keys. If an
+        exception is thrown, galois_keys is not modified.
+
+        GaloisKeys is not thread-safe, so galois_keys must not be used by other
+        threads while it is being extended.
+
+        @param[in] galois_elts The Galois elements for which to generate keys
+        @param[out] galois_keys The Galois keys to extend
+        @throws std::invalid_argument if galois_keys is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if the Galois elements are not valid
+        */
+        inline void extend_galois_keys(const std::vector<std::uint64_t> &galois_elts,
+            GaloisKeys &galois_keys)
+        {
+            generate_galois_keys(galois_elts, galois_keys, nullptr);
+        }
+
+        /**
+        Generates Galois keys for the given Galois elements and adds them to an
+        existing set of Galois keys, generating the keys concurrently on the given
+        ThreadPool. Keys that galois_keys already contains are left unchanged. The
+        new keys use the decomposition bit count of galois_keys. If an exception
+        is thrown, galois_keys is not modified.
+
+        GaloisKeys is not thread-safe, so galois_keys must not be used by other
+        threads while it is being extended.
+
+        @param[in] galois_elts The Galois elements for which to generate keys
+        @param[out] galois_keys The Galois keys to extend
+        @param[in] thread_pool The ThreadPool to generate the keys on
+        @throws std::invalid_argument if galois_keys is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if the Galois elements are not valid
+        */
+        inline void extend_galois_keys(const std::vector<std::uint64_t> &galois_elts,
+            GaloisKeys &galois_keys, ThreadPool &thread_pool)
+        {
+            generate_galois_keys(galois_elts, galois_keys, &thread_pool);
+        }
+
+        /**
+        Generates Galois keys for the given rotation step counts and adds them to
+        an existing set of Galois keys. Negative step counts correspond to rotations
+        to the right and positive step counts correspond to rotations to the left.
+        A step count of zero can be used to indicate a column rotation in the BFV
+        scheme and complex conjugation in the CKKS scheme. Keys that galois_keys
+        already contains are left unchanged. The new keys use the decomposition bit
+        count of galois_keys. If an exception is thrown, galois_keys is not modified.
+
+        GaloisKeys is not thread-safe, so galois_keys must not be used by other
+        threads while it is being extended.
+
+        @param[in] steps The rotation step counts for which to generate keys
+        @param[out] galois_keys The Galois keys to extend
+        @throws std::logic_error if the encryption parameters do not support batching
+        and scheme is scheme_type::BFV
+        @throws std::invalid_argument if galois_keys is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if the step counts are not valid
+        */
+        inline void extend_galois_keys(const std::vector<int> &steps,
+            GaloisKeys &galois_keys)
+        {
+            generate_galois_keys(steps_to_galois_elts(steps), galois_keys, nullptr);
+        }
+
+        /**
+        Generates Galois keys for the given rotation step counts and adds them to
+        an existing set of Galois keys, generating the keys concurrently on the
+        given ThreadPool. Keys that galois_keys already contains are left unchanged.
+        The new keys use the decomposition bit count of galois_keys. If an exception
+        is thrown, galois_keys is not modified.
+
+        GaloisKeys is not thread-safe, so galois_keys must not be used by other
+        threads while it is being extended.
+
+        @param[in] steps The rotation step counts for which to generate keys
+        @param[out] galois_keys The Galois keys to extend
+        @param[in] thread_pool The ThreadPool to generate the keys on
+        @throws std::logic_error if the encryption parameters do not support batching
+        and scheme is scheme_type::BFV
+        @throws std::invalid_argument if galois_keys is not valid for the encryption
+        parameters
+        @throws std::invalid_argument if the step counts are not valid
+        */
+        inline void extend_galois_keys(const std::vector<int> &steps,
+            GaloisKeys &galois_keys, ThreadPool &thread_pool)
+        {
+            generate_galois_keys(steps_to_galois_elts(steps), galois_keys,
+                &thread_pool);
+        }
+
     private:
         KeyGenerator(const KeyGenerator &copy) = delete;
 
@@ -154,18 +444,10 @@ namespace seal
 
         KeyGenerator &operator =(KeyGenerator &&assign) = delete;
 
-        void set_poly_coeffs_zero_one_negone(
-            const SEALContext::ContextData &context_data, std::uint64_t *poly, 
-            std::shared_ptr<UniformRandomGenerator> random) const;
-
         void set_poly_coeffs_normal(
             const SEALContext::ContextData &context_data, std::uint64_t *poly, 
             std::shared_ptr<UniformRandomGenerator> random) const;
 
-        void set_poly_coeffs_uniform(
-            const SEALContext::ContextData &context_data, std::uint64_t *poly,
-            std::shared_ptr<UniformRandomGenerator> random) const;
-
         void compute_secret_key_array(
             const SEALContext::ContextData &context_data,
             std::size_t max_power);
@@ -175,15 +457,54 @@ namespace seal
             int decomposition_bit_count,
             std::vector<std::vector<std::uint64_t>> &decomposition_factors) const;
 
+        RelinKeys relin_keys_internal(int decomposition_bit_count, std::size_t count,
+            parms_id_type parms_id, ThreadPool *thread_pool);
+
+        GaloisKeys galois_keys_internal(int decomposition_bit_count,
+            const std::vector<std::uint64_t> &galois_elts, parms_id_type parms_id,
+            ThreadPool *thread_pool);
+
+        std::vector<std::uint64_t> steps_to_galois_elts(
+            const std::vector<int> &steps) const;
+
+        std::vector<std::uint64_t> logn_galois_elts() const;
+
+        void generate_galois_keys(const std::vector<std::uint64_t> &galois_elts,
+            GaloisKeys &galois_keys, ThreadPool *thread_pool);
+
+        /**
+        Fills the part of a key switching key that corresponds to the RNS component
+        of index coeff_mod_index. For each decomposition factor w^i it stores the
+        pair (-(a_i*s + e_i) + w^i * new_key, a_i) in NTT form, where new_key_mod
+        is the RNS component of new_key in NTT form. The a_i are expanded from the
+        given seed and the e_i are sampled from the given generator.
+        */
+        void generate_kswitch_component(const SEALContext::ContextData &context_data,
+            const std::vector<std::uint64_t> &decomposition_factors,
+            std::size_t coeff_mod_index, const std::uint64_t *new_key_mod,
+            const prng_seed_type &seed, std::shared_ptr<UniformRandomGenerator> random,
+            Ciphertext &destination) const;
+
+        /**
+        Runs task(index, random) for every index in [0, count), optionally on a
+        ThreadPool. Each call gets its own ChaCha20PRNG stream derived from one
+        seed drawn from the random number generator of the encryption parameters,
+        so the result does not depend on how the calls are scheduled.
+        */
+        void parallel_for_random(std::size_t count, ThreadPool *thread_pool,
+            const std::function<void(std::size_t,
+                std::shared_ptr<UniformRandomGenerator>)> &task) const;
+
         /**
-        Generates new secret key.
+        Generates new secret key from the given seed.
         */
-        void generate_sk();
+        void generate_sk(const prng_seed_type &seed);
 
         /**
-        Generates new public key matching to existing secret key.
+        Generates new public key matching to existing secret key, with the
+        uniform polynomial sampled from the given seed.
         */
-        void generate_pk();
+        void generate_pk(const prng_seed_type &public_seed);
 
         /**
         We use a fresh memory pool with `clear_on_destruction' enabled
@@ -3,6 +3,8 @@
 
 #include "seal/plaintext.h"
 #include "seal/util/common.h"
+#include "seal/util/bitpack.h"
+#include "seal/util/streambuf.h"
 
 using namespace std;
 using namespace seal::util;
@@ -11,6 +13,11 @@ namespace seal
 {
     namespace
     {
+        // A plaintext does not know its polynomial modulus degree, so bit-packed
+        // blocks are small enough to never span two RNS components in NTT form 
+        // with practical parameters
+        constexpr size_t bit_packed_chunk_size = 1024;
+
         bool is_dec_char(char c)
         {
             return c >= '0' && c <= '9';
@@ -268,7 +275,7 @@ namespace seal
         return true;
     }
 
-    void Plaintext::save(ostream &stream) const
+    void Plaintext::save(ostream &stream, compr_mode_type compr_mode) const
     {
         auto old_except_mask = stream.exceptions();
         try
@@ -276,9 +283,30 @@ namespace seal
             // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
             stream.exceptions(ios_base::badbit | ios_base::failbit);
 
+            bool bit_packed = (compr_mode == compr_mode_type::bit_packed);
+            if (bit_packed)
+            {
+                stream.write(reinterpret_cast<const char*>(&bit_packed_magic),
+                    sizeof(uint64_t));
+                stream.write(reinterpret_cast<const char*>(&bit_packed_version),
+                    sizeof(uint64_t));
+            }
+            else if (compr_mode != compr_mode_type::none)
+            {
+                throw invalid_argument("unsupported compression mode");
+            }
+
             stream.write(reinterpret_cast<const char*>(&parms_id_), sizeof(parms_id_type));
             stream.write(reinterpret_cast<const char*>(&scale_), sizeof(double));
-            data_.save(stream);
+            if (bit_packed)
+            {
+                save_bit_packed(data_.cbegin(), data_.size(), 
+                    bit_packed_chunk_size, stream);
+            }
+            else
+            {
+                data_.save(stream);
+            }
         }
         catch (const exception &)
         {
@@ -290,6 +318,11 @@ namespace seal
     }
 
     void Plaintext::unsafe_load(istream &stream)
+    {
+        unsafe_load_internal(stream, nullptr);
+    }
+
+    void Plaintext::unsafe_load_internal(istream &stream, const uint64_t *first_word)
     {
         auto old_except_mask = stream.exceptions();
         try
@@ -297,15 +330,46 @@ namespace seal
             // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
             stream.exceptions(ios_base::badbit | ios_base::failbit);
 
+            // Data saved without compression starts directly with the parms_id
             parms_id_type parms_id{};
-            stream.read(reinterpret_cast<char*>(&parms_id), sizeof(parms_id_type));
+            if (first_word)
+            {
+                parms_id[0] = *first_word;
+            }
+            else
+            {
+                stream.read(reinterpret_cast<char*>(&parms_id[0]), sizeof(uint64_t));
+            }
+            bool bit_packed = (parms_id[0] == bit_packed_magic);
+            if (bit_packed)
+            {
+                uint64_t version = 0;
+                stream.read(reinterpret_cast<char*>(&version), sizeof(uint64_t));
+                if (version != bit_packed_version)
+                {
+                    throw invalid_argument("unsupported format version");
+                }
+                stream.read(reinterpret_cast<char*>(&parms_id), sizeof(parms_id_type));
+            }
+            else
+            {
+                stream.read(reinterpret_cast<char*>(&parms_id[1]), 
+                    sizeof(parms_id_type) - sizeof(uint64_t));
+            }
 
             double scale = 0;
             stream.read(reinterpret_cast<char*>(&scale), sizeof(double));
 
             // Load the data
             IntArray<pt_coeff_type> new_data(data_.pool());
-            new_data.load(stream);
+            if (bit_packed)
+            {
+                load_bit_packed(stream, new_data);
+            }
+            else
+            {
+                new_data.load(stream);
+            }
 
             // Set the parms_id
             parms_id_ = parms_id;
@@ -324,4 +388,39 @@ namespace seal
 
         stream.exceptions(old_except_mask);
     }
+
+    size_t Plaintext::save_size(compr_mode_type compr_mode) const
+    {
+        size_t header_size = sizeof(parms_id_type) + sizeof(double);
+        switch (compr_mode)
+        {
+        case compr_mode_type::none:
+            return add_safe(header_size, data_.save_size());
+
+        case compr_mode_type::bit_packed:
+            return add_safe(2 * sizeof(uint64_t), header_size,
+                bit_packed_save_size(data_.cbegin(), data_.size(),
+                    bit_packed_chunk_size));
+
+        default:
+            throw invalid_argument("unsupported compression mode");
+        }
+    }
+
+    size_t Plaintext::save(void *destination, size_t size,
+        compr_mode_type compr_mode) const
+    {
+        ArrayPutBuffer apbuf(destination, size);
+        ostream stream(&apbuf);
+        save(stream, compr_mode);
+        return apbuf.size();
+    }
+
+    size_t Plaintext::unsafe_load(const void *source, size_t size)
+    {
+        ArrayGetBuffer agbuf(source, size);
+        istream stream(&agbuf);
+        unsafe_load(stream);
+        return agbuf.size();
+    }
 }
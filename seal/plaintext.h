@@ -14,6 +14,7 @@
 #include "seal/memorymanager.h"
 #include "seal/encryptionparams.h"
 #include "seal/intarray.h"
+#include "seal/serialization.h"
 #include "seal/context.h"
 
 namespace seal
@@ -51,6 +52,8 @@ namespace seal
     */
     class Plaintext
     {
+        friend class SecretKey;
+
     public:
         using pt_coeff_type = std::uint64_t;
 
@@ -520,13 +523,17 @@ namespace seal
         and not human-readable. The output stream must have the "binary" flag set.
 
         @param[in] stream The stream to save the plaintext to
+        @param[in] compr_mode The format to save in
+        @throws std::invalid_argument if compr_mode is not supported
         @throws std::exception if the plaintext could not be written to stream
         */
-        void save(std::ostream &stream) const;
+        void save(std::ostream &stream, 
+            compr_mode_type compr_mode = compr_mode_type::none) const;
 
         /**
         Loads a plaintext from an input stream overwriting the current plaintext.
-        No checking of the validity of the plaintext data against encryption
+        The format the plaintext was saved in is detected automatically. No 
+        checking of the validity of the plaintext data against encryption
         parameters is performed. This function should not be used unless the 
         plaintext comes from a fully trusted source.
 
@@ -557,6 +564,71 @@ namespace seal
             }
         }
 
+        /**
+        Returns the exact number of bytes save writes for the plaintext in the
+        given format.
+
+        @param[in] compr_mode The format to save in
+        @throws std::invalid_argument if compr_mode is not supported
+        */
+        std::size_t save_size(
+            compr_mode_type compr_mode = compr_mode_type::none) const;
+
+        /**
+        Saves the plaintext directly into a caller-owned buffer, which must have
+        room for at least save_size(compr_mode) bytes. Returns the number of bytes
+        written.
+
+        @param[out] destination The buffer to save the plaintext to
+        @param[in] size The size of the buffer in bytes
+        @param[in] compr_mode The format to save in
+        @throws std::invalid_argument if destination is null and size is non-zero
+        @throws std::invalid_argument if compr_mode is not supported
+        @throws std::exception if the plaintext does not fit in the buffer
+        */
+        std::size_t save(void *destination, std::size_t size,
+            compr_mode_type compr_mode = compr_mode_type::none) const;
+
+        /**
+        Loads a plaintext directly from a caller-owned buffer overwriting the
+        current plaintext. Returns the number of bytes read. No checking of the
+        validity of the plaintext data against encryption parameters is 
+        performed. This function should not be used unless the plaintext comes 
+        from a fully trusted source.
+
+        @param[in] source The buffer to load the plaintext from
+        @param[in] size The size of the buffer in bytes
+        @throws std::invalid_argument if source is null and size is non-zero
+        @throws std::exception if a valid plaintext could not be read from source
+        */
+        std::size_t unsafe_load(const void *source, std::size_t size);
+
+        /**
+        Loads a plaintext directly from a caller-owned buffer overwriting the
+        current plaintext. Returns the number of bytes read. The loaded plaintext
+        is verified to be valid for the given SEALContext.
+
+        @param[in] context The SEALContext
+        @param[in] source The buffer to load the plaintext from
+        @param[in] size The size of the buffer in bytes
+        @throws std::invalid_argument if the context is not set or encryption
+        parameters are not valid
+        @throws std::invalid_argument if source is null and size is non-zero
+        @throws std::exception if a valid plaintext could not be read from source
+        @throws std::invalid_argument if the loaded plaintext is invalid for the 
+        context
+        */
+        inline std::size_t load(std::shared_ptr<SEALContext> context,
+            const void *source, std::size_t size)
+        {
+            std::size_t in_size = unsafe_load(source, size);
+            if (!is_valid_for(std::move(context)))
+            {
+                throw std::invalid_argument("Plaintext data is invalid");
+            }
+            return in_size;
+        }
+
         /**
         Returns whether the plaintext is in NTT form.
         */
@@ -615,6 +687,15 @@ namespace seal
         }
 
     private:
+        /**
+        Loads the data like unsafe_load, except that the first word of the data
+        has already been read from stream by the caller if first_word is not null.
+        This lets the key classes tell their own formats apart from the plain
+        ones.
+        */
+        void unsafe_load_internal(std::istream &stream,
+            const std::uint64_t *first_word);
+
         parms_id_type parms_id_ = parms_id_zero;
 
         double scale_ = 1.0;
@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <cstring>
+#include "seal/preparedplaintext.h"
+#include "seal/evaluator.h"
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    namespace
+    {
+        // A fast non-cryptographic hash; the cache compares the plaintexts on
+        // lookup, so collisions only cost a comparison.
+        inline uint64_t hash_combine(uint64_t seed, uint64_t value)
+        {
+            value *= 0x9E3779B97F4A7C15ULL;
+            value ^= value >> 32;
+            return (seed ^ value) * 0xFF51AFD7ED558CCDULL;
+        }
+
+        uint64_t hash_key(const Plaintext &plain, const parms_id_type &parms_id)
+        {
+            // Only the significant coefficients are hashed, since Plaintext
+            // comparison ignores trailing zero coefficients.
+            size_t coeff_count = plain.significant_coeff_count();
+            uint64_t hash = hash_combine(0, coeff_count);
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                hash = hash_combine(hash, plain[i]);
+            }
+            for (auto value : plain.parms_id())
+            {
+                hash = hash_combine(hash, value);
+            }
+            for (auto value : parms_id)
+            {
+                hash = hash_combine(hash, value);
+            }
+            uint64_t scale_bits;
+            memcpy(&scale_bits, &plain.scale(), sizeof(scale_bits));
+            return hash_combine(hash, scale_bits);
+        }
+    }
+
+    shared_ptr<const PreparedPlaintext> PreparedPlaintextCache::prepare(
+        Evaluator &evaluator, const Plaintext &plain, parms_id_type parms_id,
+        MemoryPoolHandle pool)
+    {
+        uint64_t key = hash_key(plain, parms_id);
+        auto matches = [&](const CacheEntry &entry) {
+            return entry.parms_id == parms_id &&
+                entry.plain.parms_id() == plain.parms_id() &&
+                entry.plain == plain && entry.plain.scale() == plain.scale();
+        };
+
+        {
+            ReaderLock reader_lock(cache_locker_.acquire_read());
+            auto range = cache_.equal_range(key);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (matches(it->second))
+                {
+                    return it->second.prepared;
+                }
+            }
+        }
+
+        // Prepare outside of the lock
+        auto prepared = make_shared<PreparedPlaintext>(pool);
+        evaluator.prepare_plain(plain, parms_id, *prepared, pool);
+
+        WriterLock writer_lock(cache_locker_.acquire_write());
+
+        // Another thread may have prepared the same plaintext in the meantime
+        auto range = cache_.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (matches(it->second))
+            {
+                return it->second.prepared;
+            }
+        }
+        cache_.emplace(key, CacheEntry{ plain, parms_id, prepared });
+        return prepared;
+    }
+
+    size_t PreparedPlaintextCache::size()
+    {
+        ReaderLock reader_lock(cache_locker_.acquire_read());
+        return cache_.size();
+    }
+
+    void PreparedPlaintextCache::clear()
+    {
+        WriterLock writer_lock(cache_locker_.acquire_write());
+        cache_.clear();
+    }
+}
@@ -0,0 +1,162 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include "seal/plaintext.h"
+#include "seal/encryptionparams.h"
+#include "seal/memorymanager.h"
+#include "seal/util/locks.h"
+
+namespace seal
+{
+    class Evaluator;
+
+    /**
+    Stores a plaintext in the form in which Evaluator consumes it for a given
+    parms_id. For the BFV scheme the plaintext is lifted to all primes of the
+    coefficient modulus and transformed to NTT form for plain multiplication,
+    and additionally kept scaled by Delta=[q/t], both in coefficient and in NTT
+    form, for plain addition and subtraction. For the CKKS scheme the plaintext
+    is switched down to the given parms_id. Evaluator::multiply_plain, add_plain
+    and sub_plain then only need a dyadic product or a polynomial addition.
+
+    A PreparedPlaintext is created with Evaluator::prepare_plain. When the same
+    plaintexts are used with many ciphertexts, PreparedPlaintextCache can be used
+    to prepare each of them only once per level.
+
+    @par Thread Safety
+    In general, reading from PreparedPlaintext is thread-safe as long as no other
+    thread is concurrently mutating it.
+
+    @see Evaluator::prepare_plain for the function that creates PreparedPlaintext.
+    @see PreparedPlaintextCache for a cache of prepared plaintexts.
+    */
+    class PreparedPlaintext
+    {
+        friend class Evaluator;
+
+    public:
+        /**
+        Creates an empty PreparedPlaintext. The data is allocated from the memory
+        pool pointed to by the given MemoryPoolHandle, or the global memory pool
+        by default.
+
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if pool is uninitialized
+        */
+        PreparedPlaintext(MemoryPoolHandle pool = MemoryManager::GetPool()) :
+            multiply_operand_(pool), add_operand_(pool), add_operand_ntt_(pool)
+        {
+        }
+
+        /**
+        Returns a reference to parms_id. The PreparedPlaintext can only be used
+        with ciphertexts at this parms_id.
+        */
+        inline auto &parms_id() const noexcept
+        {
+            return parms_id_;
+        }
+
+        /**
+        Returns a reference to the scale of the prepared plaintext.
+        */
+        inline auto &scale() const noexcept
+        {
+            return multiply_operand_.scale();
+        }
+
+        /**
+        Returns whether the PreparedPlaintext has been prepared by an Evaluator.
+        */
+        inline bool is_prepared() const noexcept
+        {
+            return parms_id_ != parms_id_zero;
+        }
+
+    private:
+        parms_id_type parms_id_ = parms_id_zero;
+
+        // The plaintext lifted to all primes of the coefficient modulus in NTT form
+        Plaintext multiply_operand_;
+
+        // BFV only: Delta times the plaintext in coefficient form and in NTT form
+        Plaintext add_operand_;
+
+        Plaintext add_operand_ntt_;
+    };
+
+    /**
+    Caches prepared plaintexts keyed by a hash of the plaintext content and the
+    parms_id (level) they were prepared for. Requesting the same plaintext at the
+    same level again returns the PreparedPlaintext created the first time. The
+    cache keeps a copy of each source plaintext, so that a hash collision can
+    never return the wrong PreparedPlaintext.
+
+    The cache has no capacity limit and never evicts entries: its memory grows
+    with the number of distinct (plaintext, parms_id) pairs prepared, until
+    clear() is called. Callers preparing many different plaintexts should clear
+    the cache periodically, for example when moving to the next level.
+
+    @par Thread Safety
+    PreparedPlaintextCache is thread-safe, but the Evaluator passed to prepare
+    must not be used concurrently by other threads.
+    */
+    class PreparedPlaintextCache
+    {
+    public:
+        /**
+        Creates an empty PreparedPlaintextCache.
+        */
+        PreparedPlaintextCache() = default;
+
+        /**
+        Returns the plaintext prepared for the given parms_id, preparing it with
+        the given Evaluator if it is not yet in the cache. Dynamic memory
+        allocations in the process are allocated from the memory pool pointed to
+        by the given MemoryPoolHandle.
+
+        @param[in] evaluator The Evaluator used to prepare the plaintext
+        @param[in] plain The plaintext to prepare
+        @param[in] parms_id The parms_id for which the plaintext is prepared
+        @param[in] pool The MemoryPoolHandle pointing to a valid memory pool
+        @throws std::invalid_argument if Evaluator::prepare_plain throws
+        */
+        std::shared_ptr<const PreparedPlaintext> prepare(Evaluator &evaluator,
+            const Plaintext &plain, parms_id_type parms_id,
+            MemoryPoolHandle pool = MemoryManager::GetPool());
+
+        /**
+        Returns the number of prepared plaintexts in the cache.
+        */
+        std::size_t size();
+
+        /**
+        Removes all prepared plaintexts from the cache.
+        */
+        void clear();
+
+    private:
+        PreparedPlaintextCache(const PreparedPlaintextCache &copy) = delete;
+
+        PreparedPlaintextCache &operator =(const PreparedPlaintextCache &assign) = delete;
+
+        struct CacheEntry
+        {
+            Plaintext plain;
+
+            parms_id_type parms_id;
+
+            std::shared_ptr<const PreparedPlaintext> prepared;
+        };
+
+        std::unordered_multimap<std::uint64_t, CacheEntry> cache_{};
+
+        util::ReaderWriterLocker cache_locker_;
+    };
+}
@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdexcept>
+#include "seal/publickey.h"
+#include "seal/util/seededkeys.h"
+#include "seal/util/streambuf.h"
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    void PublicKey::save_seeded(ostream &stream, compr_mode_type compr_mode) const
+    {
+        if (!has_seed_)
+        {
+            throw logic_error("PublicKey does not have a seed");
+        }
+        save_seeded_public_key(pk_, seed_, stream, compr_mode);
+    }
+
+    void PublicKey::load_internal(istream &stream, shared_ptr<SEALContext> context)
+    {
+        auto old_except_mask = stream.exceptions();
+        try
+        {
+            // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+            stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+            // Keys saved without seeds start directly with the ciphertext
+            uint64_t first_word = 0;
+            stream.read(reinterpret_cast<char*>(&first_word), sizeof(uint64_t));
+            if (first_word == seeded_keys_magic)
+            {
+                if (!context)
+                {
+                    throw invalid_argument("seeded PublicKey can only be loaded with a context");
+                }
+                load_seeded_public_key(context, stream, pk_, seed_);
+                has_seed_ = true;
+            }
+            else
+            {
+                pk_.unsafe_load_internal(stream, &first_word);
+                seed_.fill(0);
+                has_seed_ = false;
+            }
+        }
+        catch (const exception &)
+        {
+            stream.exceptions(old_except_mask);
+            throw;
+        }
+
+        stream.exceptions(old_except_mask);
+    }
+
+    size_t PublicKey::load_internal(const void *source, size_t size,
+        shared_ptr<SEALContext> context)
+    {
+        ArrayGetBuffer agbuf(source, size);
+        istream stream(&agbuf);
+        load_internal(stream, move(context));
+        return agbuf.size();
+    }
+}
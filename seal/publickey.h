@@ -7,11 +7,14 @@
 #include <memory>
 #include "seal/ciphertext.h"
 #include "seal/context.h"
+#include "seal/randomgen.h"
 
 namespace seal
 {
     /**
-    Class to store a public key.
+    Class to store a public key. The public key remembers the seed its uniform
+    polynomial was sampled from, and can be saved with only that seed in place
+    of the polynomial with save_seeded.
 
     @par Thread Safety
     In general, reading from PublicKey is thread-safe as long as no other thread
@@ -102,11 +105,14 @@ namespace seal
         and not human-readable. The output stream must have the "binary" flag set.
 
         @param[in] stream The stream to save the PublicKey to
+        @param[in] compr_mode The format to save in
+        @throws std::invalid_argument if compr_mode is not supported
         @throws std::exception if the PublicKey could not be written to stream
         */
-        inline void save(std::ostream &stream) const
+        inline void save(std::ostream &stream, 
+            compr_mode_type compr_mode = compr_mode_type::none) const
         {
-            pk_.save(stream);
+            pk_.save(stream, compr_mode);
         }
 
         /**
@@ -117,15 +123,18 @@ namespace seal
 
         @param[in] stream The stream to load the PublicKey from
         @throws std::exception if a valid PublicKey could not be read from stream
+        @throws std::invalid_argument if the PublicKey was saved with save_seeded
         */
         inline void unsafe_load(std::istream &stream)
         {
-            pk_.unsafe_load(stream);
+            load_internal(stream, nullptr);
         }
 
         /**
         Loads a PublicKey from an input stream overwriting the current PublicKey.
         The loaded PublicKey is verified to be valid for the given SEALContext.
+        PublicKeys saved with save_seeded are accepted too, in which case the
+        uniform polynomial is expanded from its seed.
 
         @param[in] context The SEALContext
         @param[in] stream The stream to load the PublicKey from
@@ -138,13 +147,115 @@ namespace seal
         inline void load(std::shared_ptr<SEALContext> context,
             std::istream &stream)
         {
-            unsafe_load(stream);
+            load_internal(stream, context);
             if (!is_valid_for(std::move(context)))
             {
                 throw std::invalid_argument("PublicKey data is invalid");
             }
         }
 
+        /**
+        Returns the exact number of bytes save writes for the PublicKey in the
+        given format.
+
+        @param[in] compr_mode The format to save in
+        @throws std::invalid_argument if compr_mode is not supported
+        */
+        inline std::size_t save_size(
+            compr_mode_type compr_mode = compr_mode_type::none) const
+        {
+            return pk_.save_size(compr_mode);
+        }
+
+        /**
+        Saves the PublicKey directly into a caller-owned buffer, which must have 
+        room for at least save_size(compr_mode) bytes. Returns the number of 
+        bytes written.
+
+        @param[out] destination The buffer to save the PublicKey to
+        @param[in] size The size of the buffer in bytes
+        @param[in] compr_mode The format to save in
+        @throws std::invalid_argument if destination is null and size is non-zero
+        @throws std::invalid_argument if compr_mode is not supported
+        @throws std::exception if the PublicKey does not fit in the buffer
+        */
+        inline std::size_t save(void *destination, std::size_t size,
+            compr_mode_type compr_mode = compr_mode_type::none) const
+        {
+            return pk_.save(destination, size, compr_mode);
+        }
+
+        /**
+        Loads a PublicKey directly from a caller-owned buffer overwriting the 
+        current PublicKey. Returns the number of bytes read. No checking of the 
+        validity of the PublicKey data against encryption parameters is performed.
+        This function should not be used unless the PublicKey comes from a fully 
+        trusted source.
+
+        @param[in] source The buffer to load the PublicKey from
+        @param[in] size The size of the buffer in bytes
+        @throws std::invalid_argument if source is null and size is non-zero
+        @throws std::exception if a valid PublicKey could not be read from source
+        @throws std::invalid_argument if the PublicKey was saved with save_seeded
+        */
+        inline std::size_t unsafe_load(const void *source, std::size_t size)
+        {
+            return load_internal(source, size, nullptr);
+        }
+
+        /**
+        Loads a PublicKey directly from a caller-owned buffer overwriting the 
+        current PublicKey. Returns the number of bytes read. The loaded PublicKey is 
+        verified to be valid for the given SEALContext. PublicKeys saved with
+        save_seeded are accepted too.
+
+        @param[in] context The SEALContext
+        @param[in] source The buffer to load the PublicKey from
+        @param[in] size The size of the buffer in bytes
+        @throws std::invalid_argument if the context is not set or encryption
+        parameters are not valid
+        @throws std::invalid_argument if source is null and size is non-zero
+        @throws std::exception if a valid PublicKey could not be read from source
+        @throws std::invalid_argument if the loaded PublicKey is invalid for the
+        context
+        */
+        inline std::size_t load(std::shared_ptr<SEALContext> context,
+            const void *source, std::size_t size)
+        {
+            std::size_t in_size = load_internal(source, size, context);
+            if (!is_valid_for(std::move(context)))
+            {
+                throw std::invalid_argument("PublicKey data is invalid");
+            }
+            return in_size;
+        }
+
+        /**
+        Returns whether the PublicKey has the seed its uniform polynomial was
+        sampled from, so that it can be saved with save_seeded. This is the case
+        for public keys generated by KeyGenerator and for public keys loaded from
+        the seeded format.
+        */
+        inline bool has_seed() const noexcept
+        {
+            return has_seed_;
+        }
+
+        /**
+        Saves the PublicKey to an output stream with the seed of its uniform
+        polynomial in place of the polynomial, which halves its size. Such a
+        PublicKey can only be loaded with load, since the polynomial is expanded
+        from the seed for the given SEALContext.
+
+        @param[in] stream The stream to save the PublicKey to
+        @param[in] compr_mode The format to save the first polynomial in
+        @throws std::logic_error if the PublicKey does not have a seed
+        @throws std::invalid_argument if compr_mode is not supported
+        @throws std::exception if the PublicKey could not be written to stream
+        */
+        void save_seeded(std::ostream &stream,
+            compr_mode_type compr_mode = compr_mode_type::none) const;
+
         /**
         Returns a reference to parms_id.
         */
@@ -170,6 +281,19 @@ namespace seal
         }
 
     private:
+        void load_internal(std::istream &stream,
+            std::shared_ptr<SEALContext> context);
+
+        std::size_t load_internal(const void *source, std::size_t size,
+            std::shared_ptr<SEALContext> context);
+
         Ciphertext pk_;
+
+        /**
+        The seed of the uniform polynomial of the public key, if known.
+        */
+        prng_seed_type seed_{};
+
+        bool has_seed_ = false;
     };
 }
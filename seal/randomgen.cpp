@@ -18,6 +18,87 @@ namespace seal
             default_factory{ new SEAL_DEFAULT_RNG_FACTORY };
         return default_factory;
     }
+
+    namespace
+    {
+        inline uint32_t rotl32(uint32_t value, int shift) noexcept
+        {
+            return (value << shift) | (value >> (32 - shift));
+        }
+
+        inline void chacha_quarter_round(uint32_t *x, 
+            size_t a, size_t b, size_t c, size_t d) noexcept
+        {
+            x[a] += x[b]; x[d] = rotl32(x[d] ^ x[a], 16);
+            x[c] += x[d]; x[b] = rotl32(x[b] ^ x[c], 12);
+            x[a] += x[b]; x[d] = rotl32(x[d] ^ x[a], 8);
+            x[c] += x[d]; x[b] = rotl32(x[b] ^ x[c], 7);
+        }
+    }
+
+    ChaCha20PRNG::ChaCha20PRNG(const prng_seed_type &seed, uint64_t stream_index)
+    {
+        // "expand 32-byte k"
+        state_[0] = 0x61707865;
+        state_[1] = 0x3320646e;
+        state_[2] = 0x79622d32;
+        state_[3] = 0x6b206574;
+
+        // The seed is the key
+        for (size_t i = 0; i < prng_seed_uint64_count; i++)
+        {
+            state_[4 + 2 * i] = static_cast<uint32_t>(seed[i]);
+            state_[5 + 2 * i] = static_cast<uint32_t>(seed[i] >> 32);
+        }
+
+        // 64-bit block counter followed by the 64-bit nonce
+        state_[12] = 0;
+        state_[13] = 0;
+        state_[14] = static_cast<uint32_t>(stream_index);
+        state_[15] = static_cast<uint32_t>(stream_index >> 32);
+    }
+
+    prng_seed_type ChaCha20PRNG::draw_seed(UniformRandomGenerator &random)
+    {
+        prng_seed_type seed;
+        for (auto &seed_word : seed)
+        {
+            seed_word = static_cast<uint64_t>(random.generate());
+            seed_word |= static_cast<uint64_t>(random.generate()) << 32;
+        }
+        return seed;
+    }
+
+    void ChaCha20PRNG::refill_buffer() noexcept
+    {
+        auto &x = buffer_;
+        x = state_;
+        for (int round = 0; round < 10; round++)
+        {
+            // Column rounds
+            chacha_quarter_round(x.data(), 0, 4, 8, 12);
+            chacha_quarter_round(x.data(), 1, 5, 9, 13);
+            chacha_quarter_round(x.data(), 2, 6, 10, 14);
+            chacha_quarter_round(x.data(), 3, 7, 11, 15);
+
+            // Diagonal rounds
+            chacha_quarter_round(x.data(), 0, 5, 10, 15);
+            chacha_quarter_round(x.data(), 1, 6, 11, 12);
+            chacha_quarter_round(x.data(), 2, 7, 8, 13);
+            chacha_quarter_round(x.data(), 3, 4, 9, 14);
+        }
+        for (size_t i = 0; i < block_uint32_count_; i++)
+        {
+            x[i] += state_[i];
+        }
+
+        // Increment the block counter
+        if (!++state_[12])
+        {
+            state_[13]++;
+        }
+        buffer_head_ = 0;
+    }
 #ifdef SEAL_USE_AES_NI_PRNG
     auto FastPRNGFactory::create() -> shared_ptr<UniformRandomGenerator>
     {
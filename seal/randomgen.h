@@ -79,6 +79,73 @@ namespace seal
 
     private:
     };
+
+    /**
+    The number of 64-bit words in the seed of a ChaCha20PRNG.
+    */
+    constexpr std::size_t prng_seed_uint64_count = 4;
+
+    /**
+    The type of the 256-bit seed of a ChaCha20PRNG.
+    */
+    using prng_seed_type = std::array<std::uint64_t, prng_seed_uint64_count>;
+
+    /**
+    Provides an implementation of UniformRandomGenerator that outputs the ChaCha20
+    keystream for a 256-bit seed. The seed is used as the ChaCha20 key and the
+    stream index as the 64-bit nonce, so generators with the same seed and
+    different stream indices produce independent streams. This makes it possible
+    to derive any number of streams from a single seed drawn from another
+    UniformRandomGenerator, for example one for each task in a parallel
+    computation, such that the output does not depend on the order in which the
+    tasks run. Unlike FastPRNG this class does not require AES-NI.
+    */
+    class ChaCha20PRNG : public UniformRandomGenerator
+    {
+    public:
+        /**
+        Creates a new ChaCha20PRNG instance for the given seed and stream index.
+
+        @param[in] seed The seed
+        @param[in] stream_index The index of the stream
+        */
+        ChaCha20PRNG(const prng_seed_type &seed, std::uint64_t stream_index = 0);
+
+        /**
+        Generates a new uniform unsigned 32-bit random number.
+        */
+        virtual std::uint32_t generate() override
+        {
+            if (buffer_head_ == buffer_.size())
+            {
+                refill_buffer();
+            }
+            return buffer_[buffer_head_++];
+        }
+
+        /**
+        Draws a seed for a ChaCha20PRNG from the given random number generator.
+
+        @param[in] random The random number generator to draw the seed from
+        */
+        static prng_seed_type draw_seed(UniformRandomGenerator &random);
+
+        /**
+        Destroys the random number generator.
+        */
+        virtual ~ChaCha20PRNG() override = default;
+
+    private:
+        static constexpr std::size_t block_uint32_count_ = 16;
+
+        void refill_buffer() noexcept;
+
+        std::array<std::uint32_t, block_uint32_count_> state_;
+
+        std::array<std::uint32_t, block_uint32_count_> buffer_;
+
+        std::size_t buffer_head_ = block_uint32_count_;
+    };
 #ifdef SEAL_USE_AES_NI_PRNG
     /**
     Provides an implementation of UniformRandomGenerator for using very fast 
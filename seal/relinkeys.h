@@ -9,6 +9,8 @@
 #include "seal/ciphertext.h"
 #include "seal/memorymanager.h"
 #include "seal/encryptionparams.h"
+#include "seal/randomgen.h"
+#include "seal/util/mappedfile.h"
 
 namespace seal
 {
@@ -68,7 +70,12 @@ namespace seal
 
         @param[in] copy The RelinKeys to copy from
         */
-        RelinKeys(const RelinKeys &copy) = default;
+        RelinKeys(const RelinKeys &copy) : pool_(copy.pool_)
+        {
+            // Copies always own their data, even if copy is memory-mapped; it
+            // is allocated from the same pool as the data of copy
+            operator =(copy);
+        }
 
         /**
         Creates a new RelinKeys instance by moving a given instance.
@@ -188,9 +195,12 @@ namespace seal
         flag set.
 
         @param[in] stream The stream to save the RelinKeys to
+        @param[in] compr_mode The format to save the key ciphertexts in
+        @throws std::invalid_argument if compr_mode is not supported
         @throws std::exception if the RelinKeys could not be written to stream
         */
-        void save(std::ostream &stream) const;
+        void save(std::ostream &stream, 
+            compr_mode_type compr_mode = compr_mode_type::none) const;
 
         /**
         Loads a RelinKeys from an input stream overwriting the current RelinKeys.
@@ -200,12 +210,15 @@ namespace seal
 
         @param[in] stream The stream to load the RelinKeys from
         @throws std::exception if a valid RelinKeys could not be read from stream
+        @throws std::invalid_argument if the RelinKeys was saved with save_seeded
         */
         void unsafe_load(std::istream &stream);
 
         /**
         Loads a RelinKeys from an input stream overwriting the current RelinKeys.
         The loaded RelinKeys is verified to be valid for the given SEALContext.
+        RelinKeys saved with save_seeded are accepted too, in which case the uniform
+        polynomials are expanded from their seeds.
 
         @param[in] context The SEALContext
         @param[in] stream The stream to load the RelinKeys from
@@ -218,11 +231,162 @@ namespace seal
         inline void load(std::shared_ptr<SEALContext> context,
             std::istream &stream)
         {
-            unsafe_load(stream);
+            load_internal(stream, context);
+            if (!is_valid_for(std::move(context)))
+            {
+                throw std::invalid_argument("RelinKeys data is invalid");
+            }
+        }
+
+        /**
+        Returns the exact number of bytes save writes for the RelinKeys in the
+        given format.
+
+        @param[in] compr_mode The format to save the key ciphertexts in
+        @throws std::invalid_argument if compr_mode is not supported
+        */
+        std::size_t save_size(
+            compr_mode_type compr_mode = compr_mode_type::none) const;
+
+        /**
+        Saves the RelinKeys directly into a caller-owned buffer, which must have 
+        room for at least save_size(compr_mode) bytes. Returns the number of 
+        bytes written.
+
+        @param[out] destination The buffer to save the RelinKeys to
+        @param[in] size The size of the buffer in bytes
+        @param[in] compr_mode The format to save the key ciphertexts in
+        @throws std::invalid_argument if destination is null and size is non-zero
+        @throws std::invalid_argument if compr_mode is not supported
+        @throws std::exception if the RelinKeys does not fit in the buffer
+        */
+        std::size_t save(void *destination, std::size_t size,
+            compr_mode_type compr_mode = compr_mode_type::none) const;
+
+        /**
+        Loads a RelinKeys directly from a caller-owned buffer overwriting the 
+        current RelinKeys. Returns the number of bytes read. No checking of the 
+        validity of the RelinKeys data against encryption parameters is performed.
+        This function should not be used unless the RelinKeys comes from a fully 
+        trusted source.
+
+        @param[in] source The buffer to load the RelinKeys from
+        @param[in] size The size of the buffer in bytes
+        @throws std::invalid_argument if source is null and size is non-zero
+        @throws std::exception if a valid RelinKeys could not be read from source
+        */
+        std::size_t unsafe_load(const void *source, std::size_t size);
+
+        /**
+        Loads a RelinKeys directly from a caller-owned buffer overwriting the 
+        current RelinKeys. Returns the number of bytes read. The loaded RelinKeys is 
+        verified to be valid for the given SEALContext. RelinKeys saved with 
+        save_seeded are accepted too.
+
+        @param[in] context The SEALContext
+        @param[in] source The buffer to load the RelinKeys from
+        @param[in] size The size of the buffer in bytes
+        @throws std::invalid_argument if the context is not set or encryption
+        parameters are not valid
+        @throws std::invalid_argument if source is null and size is non-zero
+        @throws std::exception if a valid RelinKeys could not be read from source
+        @throws std::invalid_argument if the loaded RelinKeys is invalid for the
+        context
+        */
+        inline std::size_t load(std::shared_ptr<SEALContext> context,
+            const void *source, std::size_t size)
+        {
+            std::size_t in_size = load_internal(source, size, context);
             if (!is_valid_for(std::move(context)))
             {
                 throw std::invalid_argument("RelinKeys data is invalid");
             }
+            return in_size;
+        }
+
+        /**
+        Returns whether every key has the seeds its uniform polynomials were
+        sampled from, so that the RelinKeys can be saved with save_seeded. This is the
+        case for keys created by KeyGenerator and for keys loaded from data saved
+        with save_seeded.
+        */
+        bool has_seeds() const noexcept;
+
+        /**
+        Saves the RelinKeys instance to an output stream in a format that stores the 
+        seed of each key component instead of its uniform polynomials, which
+        makes the output about half the size of that of save. Loading the output
+        requires a SEALContext, since the polynomials are expanded from the seeds
+        when loaded. The output stream must have the "binary" flag set. The data
+        of the keys must not have been modified since they were generated.
+
+        @param[in] stream The stream to save the RelinKeys to
+        @param[in] compr_mode The format to save the remaining key polynomials in
+        @throws std::logic_error if the RelinKeys does not have seeds
+        @throws std::invalid_argument if compr_mode is not supported
+        @throws std::exception if the RelinKeys could not be written to stream
+        */
+        void save_seeded(std::ostream &stream,
+            compr_mode_type compr_mode = compr_mode_type::none) const;
+
+        /**
+        Saves the RelinKeys instance to an output stream in a format that can be
+        memory-mapped with load_mapped. Every field is 8-byte aligned so that the
+        mapped key data can be used in place. The output stream must have the 
+        "binary" flag set.
+
+        @param[in] stream The stream to save the RelinKeys to
+        @throws std::exception if the RelinKeys could not be written to stream
+        */
+        void save_mappable(std::ostream &stream) const;
+
+        /**
+        Maps a file written by save_mappable into memory, overwriting the current
+        RelinKeys. The keys point directly to the mapped data, so nothing is copied
+        and each key is faulted in from the page cache only when first used; 
+        processes mapping the same file share the same physical pages. The mapping
+        lives as long as this RelinKeys instance, while copies of it own their data.
+        No checking of the validity of the RelinKeys data against encryption 
+        parameters is performed. This function should not be used unless the 
+        file comes from a fully trusted source.
+
+        @param[in] path The path of the file to map
+        @throws std::runtime_error if the file could not be mapped
+        @throws std::invalid_argument if the file is not a valid mapped RelinKeys file
+        */
+        void unsafe_load_mapped(const std::string &path);
+
+        /**
+        Maps a file written by save_mappable into memory, overwriting the current
+        RelinKeys. The metadata of every key is verified to be valid for the given
+        SEALContext. Unlike load, the key coefficients are not scanned since that
+        would defeat the purpose of mapping the file lazily.
+
+        @param[in] context The SEALContext
+        @param[in] path The path of the file to map
+        @throws std::invalid_argument if the context is not set or encryption
+        parameters are not valid
+        @throws std::runtime_error if the file could not be mapped
+        @throws std::invalid_argument if the file is not a valid mapped RelinKeys file
+        @throws std::invalid_argument if the loaded RelinKeys is invalid for the
+        context
+        */
+        inline void load_mapped(std::shared_ptr<SEALContext> context,
+            const std::string &path)
+        {
+            unsafe_load_mapped(path);
+            if (!is_metadata_valid_for(std::move(context)))
+            {
+                throw std::invalid_argument("RelinKeys data is invalid");
+            }
+        }
+
+        /**
+        Returns whether the RelinKeys data is backed by a memory-mapped file.
+        */
+        inline bool is_mapped() const noexcept
+        {
+            return static_cast<bool>(mapping_);
         }
 
         /**
@@ -234,6 +398,13 @@ namespace seal
         }
 
     private:
+        bool is_metadata_valid_for(std::shared_ptr<SEALContext> context) const noexcept;
+
+        void load_internal(std::istream &stream, std::shared_ptr<SEALContext> context);
+
+        std::size_t load_internal(const void *source, std::size_t size,
+            std::shared_ptr<SEALContext> context);
+
         MemoryPoolHandle pool_ = MemoryManager::GetPool();
 
         parms_id_type parms_id_ = parms_id_zero;
@@ -244,5 +415,15 @@ namespace seal
         std::vector<std::vector<Ciphertext>> keys_{};
 
         int decomposition_bit_count_ = 0;
+
+        /**
+        The seeds of the uniform polynomials of the keys, if known.
+        */
+        std::vector<std::vector<prng_seed_type>> seeds_{};
+
+        /**
+        The file mapping the keys point to, if any.
+        */
+        std::shared_ptr<util::MappedFile> mapping_{ nullptr };
     };
 }
@@ -17,9 +17,11 @@
 #include "seal/keygenerator.h"
 #include "seal/memorymanager.h"
 #include "seal/plaintext.h"
+#include "seal/preparedplaintext.h"
 #include "seal/batchencoder.h"
 #include "seal/publickey.h"
 #include "seal/randomgen.h"
 #include "seal/relinkeys.h"
 #include "seal/secretkey.h"
 #include "seal/smallmodulus.h"
+#include "seal/threadpool.h"
@@ -0,0 +1,67 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdexcept>
+#include "seal/secretkey.h"
+#include "seal/util/seededkeys.h"
+#include "seal/util/streambuf.h"
+
+using namespace std;
+using namespace seal::util;
+
+namespace seal
+{
+    void SecretKey::save_seeded(ostream &stream) const
+    {
+        if (!has_seed_)
+        {
+            throw logic_error("SecretKey does not have a seed");
+        }
+        save_seeded_secret_key(sk_.parms_id(), seed_, stream);
+    }
+
+    void SecretKey::load_internal(istream &stream, shared_ptr<SEALContext> context)
+    {
+        auto old_except_mask = stream.exceptions();
+        try
+        {
+            // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+            stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+            // Keys saved without seeds start directly with the plaintext
+            uint64_t first_word = 0;
+            stream.read(reinterpret_cast<char*>(&first_word), sizeof(uint64_t));
+            if (first_word == seeded_keys_magic)
+            {
+                if (!context)
+                {
+                    throw invalid_argument("seeded SecretKey can only be loaded with a context");
+                }
+                load_seeded_secret_key(context, stream, sk_, seed_);
+                has_seed_ = true;
+            }
+            else
+            {
+                sk_.unsafe_load_internal(stream, &first_word);
+                seed_.fill(0);
+                has_seed_ = false;
+            }
+        }
+        catch (const exception &)
+        {
+            stream.exceptions(old_except_mask);
+            throw;
+        }
+
+        stream.exceptions(old_except_mask);
+    }
+
+    size_t SecretKey::load_internal(const void *source, size_t size,
+        shared_ptr<SEALContext> context)
+    {
+        ArrayGetBuffer agbuf(source, size);
+        istream stream(&agbuf);
+        load_internal(stream, move(context));
+        return agbuf.size();
+    }
+}
@@ -16,7 +16,8 @@
 namespace seal
 {
     /**
-    Class to store a secret key.
+    Class to store a secret key. A secret key generated from a seed remembers
+    the seed, and can be saved as the seed alone with save_seeded.
 
     @par Thread Safety
     In general, reading from SecretKey is thread-safe as long as no other thread 
@@ -73,6 +74,8 @@ namespace seal
         SecretKey &operator =(const SecretKey &assign)
         {
             sk_ = assign.sk_;
+            seed_ = assign.seed_;
+            has_seed_ = assign.has_seed_;
             return *this;
         }
 
@@ -124,11 +127,14 @@ namespace seal
         and not human-readable. The output stream must have the "binary" flag set.
 
         @param[in] stream The stream to save the SecretKey to
+        @param[in] compr_mode The format to save in
+        @throws std::invalid_argument if compr_mode is not supported
         @throws std::exception if the plaintext could not be written to stream
         */
-        inline void save(std::ostream &stream) const
+        inline void save(std::ostream &stream, 
+            compr_mode_type compr_mode = compr_mode_type::none) const
         {
-            sk_.save(stream);
+            sk_.save(stream, compr_mode);
         }
 
         /**
@@ -139,15 +145,18 @@ namespace seal
 
         @param[in] stream The stream to load the SecretKey from
         @throws std::exception if a valid SecretKey could not be read from stream
+        @throws std::invalid_argument if the SecretKey was saved with save_seeded
         */
         inline void unsafe_load(std::istream &stream)
         {
-            sk_.unsafe_load(stream);
+            load_internal(stream, nullptr);
         }
 
         /**
         Loads a SecretKey from an input stream overwriting the current SecretKey.
         The loaded SecretKey is verified to be valid for the given SEALContext.
+        SecretKeys saved with save_seeded are accepted too, in which case the key
+        is expanded from its seed.
 
         @param[in] context The SEALContext
         @param[in] stream The stream to load the SecretKey from
@@ -160,13 +169,111 @@ namespace seal
         inline void load(std::shared_ptr<SEALContext> context,
             std::istream &stream)
         {
-            unsafe_load(stream);
+            load_internal(stream, context);
             if (!is_valid_for(std::move(context)))
             {
                 throw std::invalid_argument("SecretKey data is invalid");
             }
         }
 
+        /**
+        Returns the exact number of bytes save writes for the SecretKey in the
+        given format.
+
+        @param[in] compr_mode The format to save in
+        @throws std::invalid_argument if compr_mode is not supported
+        */
+        inline std::size_t save_size(
+            compr_mode_type compr_mode = compr_mode_type::none) const
+        {
+            return sk_.save_size(compr_mode);
+        }
+
+        /**
+        Saves the SecretKey directly into a caller-owned buffer, which must have 
+        room for at least save_size(compr_mode) bytes. Returns the number of 
+        bytes written.
+
+        @param[out] destination The buffer to save the SecretKey to
+        @param[in] size The size of the buffer in bytes
+        @param[in] compr_mode The format to save in
+        @throws std::invalid_argument if destination is null and size is non-zero
+        @throws std::invalid_argument if compr_mode is not supported
+        @throws std::exception if the SecretKey does not fit in the buffer
+        */
+        inline std::size_t save(void *destination, std::size_t size,
+            compr_mode_type compr_mode = compr_mode_type::none) const
+        {
+            return sk_.save(destination, size, compr_mode);
+        }
+
+        /**
+        Loads a SecretKey directly from a caller-owned buffer overwriting the 
+        current SecretKey. Returns the number of bytes read. No checking of the 
+        validity of the SecretKey data against encryption parameters is performed.
+        This function should not be used unless the SecretKey comes from a fully 
+        trusted source.
+
+        @param[in] source The buffer to load the SecretKey from
+        @param[in] size The size of the buffer in bytes
+        @throws std::invalid_argument if source is null and size is non-zero
+        @throws std::exception if a valid SecretKey could not be read from source
+        @throws std::invalid_argument if the SecretKey was saved with save_seeded
+        */
+        inline std::size_t unsafe_load(const void *source, std::size_t size)
+        {
+            return load_internal(source, size, nullptr);
+        }
+
+        /**
+        Loads a SecretKey directly from a caller-owned buffer overwriting the 
+        current SecretKey. Returns the number of bytes read. The loaded SecretKey is 
+        verified to be valid for the given SEALContext. SecretKeys saved with
+        save_seeded are accepted too.
+
+        @param[in] context The SEALContext
+        @param[in] source The buffer to load the SecretKey from
+        @param[in] size The size of the buffer in bytes
+        @throws std::invalid_argument if the context is not set or encryption
+        parameters are not valid
+        @throws std::invalid_argument if source is null and size is non-zero
+        @throws std::exception if a valid SecretKey could not be read from source
+        @throws std::invalid_argument if the loaded SecretKey is invalid for the
+        context
+        */
+        inline std::size_t load(std::shared_ptr<SEALContext> context,
+            const void *source, std::size_t size)
+        {
+            std::size_t in_size = load_internal(source, size, context);
+            if (!is_valid_for(std::move(context)))
+            {
+                throw std::invalid_argument("SecretKey data is invalid");
+            }
+            return in_size;
+        }
+
+        /**
+        Returns whether the SecretKey was generated from a seed that it knows,
+        so that it can be saved with save_seeded. This is the case for secret
+        keys generated by KeyGenerator from a seed, and for secret keys loaded
+        from the seeded format.
+        */
+        inline bool has_seed() const noexcept
+        {
+            return has_seed_;
+        }
+
+        /**
+        Saves the SecretKey to an output stream as the seed it was generated
+        from, which takes 80 bytes regardless of the encryption parameters. Such
+        a SecretKey can only be loaded with load, which expands it from the seed.
+
+        @param[in] stream The stream to save the SecretKey to
+        @throws std::logic_error if the SecretKey does not have a seed
+        @throws std::exception if the SecretKey could not be written to stream
+        */
+        void save_seeded(std::ostream &stream) const;
+
         /**
         Returns a reference to parms_id.
 
@@ -196,9 +303,21 @@ namespace seal
         }
 
     private:
+        void load_internal(std::istream &stream,
+            std::shared_ptr<SEALContext> context);
+
+        std::size_t load_internal(const void *source, std::size_t size,
+            std::shared_ptr<SEALContext> context);
+
         inline void randomize_secret(
             std::shared_ptr<UniformRandomGenerator> random) noexcept
         {
+            volatile std::uint64_t *seed_ptr = seed_.data();
+            for (std::size_t i = 0; i < seed_.size(); i++)
+            {
+                seed_ptr[i] = 0;
+            }
+
             std::size_t capacity = sk_.capacity();
             volatile SEAL_BYTE *data_ptr = reinterpret_cast<SEAL_BYTE*>(sk_.data());
             while (capacity--)
@@ -215,5 +334,12 @@ namespace seal
         We use a fresh memory pool with `clear_on_destruction' enabled
         */
         Plaintext sk_{ MemoryManager::GetPool(mm_prof_opt::FORCE_NEW, true) };
+
+        /**
+        The seed the secret key was generated from, if known.
+        */
+        prng_seed_type seed_{};
+
+        bool has_seed_ = false;
     };
 }
@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstdint>
+
+namespace seal
+{
+    /**
+    Describes the format used when saving ciphertexts, plaintexts, and keys.
+    Loading always detects the format automatically, so data saved in any 
+    format (including by earlier versions of the library) can be loaded.
+
+    @par Bit-Packed Format
+    In compr_mode_type::bit_packed every block of coefficients is stored using 
+    only as many bits as its largest coefficient needs. For a ciphertext a block 
+    is one RNS component of one polynomial, so each block is stored at (at most) 
+    the bit width of its coefficient modulus prime instead of a full 64 bits. The 
+    saved size is typically 10-50% smaller with no loss of information.
+    */
+    enum class compr_mode_type : std::uint8_t
+    {
+        // Every coefficient is stored as a full 64-bit word
+        none = 0,
+
+        // Blocks of coefficients are stored at their significant bit width
+        bit_packed = 1
+    };
+}
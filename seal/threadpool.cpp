@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <algorithm>
+#include "seal/threadpool.h"
+
+using namespace std;
+
+namespace seal
+{
+    ThreadPool::ThreadPool(size_t thread_count)
+    {
+        if (thread_count == 0)
+        {
+            throw invalid_argument("thread_count must be positive");
+        }
+        workers_.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; i++)
+        {
+            workers_.emplace_back(&ThreadPool::run_worker, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            lock_guard<mutex> lock(jobs_mutex_);
+            stopping_ = true;
+        }
+        jobs_cond_.notify_all();
+        for (auto &worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::run_worker()
+    {
+        while (true)
+        {
+            function<void()> job;
+            {
+                unique_lock<mutex> lock(jobs_mutex_);
+                jobs_cond_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+                if (jobs_.empty())
+                {
+                    return;
+                }
+                job = move(jobs_.front());
+                jobs_.pop();
+            }
+            job();
+        }
+    }
+
+    void ThreadPool::parallel_for(size_t count, const function<void(size_t)> &task)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        if (count == 1)
+        {
+            task(0);
+            return;
+        }
+
+        // Indices are claimed dynamically, so a helper job that starts late simply
+        // finds nothing left to do. The state is shared with the helper jobs, since
+        // they may only be dequeued after this function has returned.
+        struct State
+        {
+            const function<void(size_t)> *task;
+
+            size_t count;
+
+            atomic<size_t> next_index{ 0 };
+
+            size_t finished_count = 0;
+
+            exception_ptr first_exception;
+
+            mutex state_mutex;
+
+            condition_variable finished_cond;
+        };
+        auto state = make_shared<State>();
+        state->task = &task;
+        state->count = count;
+
+        auto work = [](State &state) {
+            size_t index;
+            while ((index = state.next_index.fetch_add(1)) < state.count)
+            {
+                exception_ptr exception;
+                try
+                {
+                    (*state.task)(index);
+                }
+                catch (...)
+                {
+                    exception = current_exception();
+                }
+
+                lock_guard<mutex> lock(state.state_mutex);
+                if (exception && !state.first_exception)
+                {
+                    state.first_exception = exception;
+                }
+                if (++state.finished_count == state.count)
+                {
+                    state.finished_cond.notify_all();
+                }
+            }
+        };
+
+        size_t helper_count = min(count - 1, workers_.size());
+        {
+            lock_guard<mutex> lock(jobs_mutex_);
+            for (size_t i = 0; i < helper_count; i++)
+            {
+                jobs_.emplace([state, work] { work(*state); });
+            }
+        }
+        jobs_cond_.notify_all();
+
+        work(*state);
+
+        unique_lock<mutex> lock(state->state_mutex);
+        state->finished_cond.wait(lock,
+            [&state] { return state->finished_count == state->count; });
+        if (state->first_exception)
+        {
+            rethrow_exception(state->first_exception);
+        }
+    }
+}
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <vector>
+
+namespace seal
+{
+    /**
+    A fixed set of worker threads that Evaluator functions can use to evaluate
+    independent homomorphic operations concurrently, such as the products on one
+    level of the product tree in Evaluator::multiply_many. The same ThreadPool can
+    be passed to any number of function calls, also from several threads.
+
+    @par Thread Safety
+    ThreadPool is thread-safe. The thread calling parallel_for takes part in the
+    work, so parallel_for can also be called from within a task.
+    */
+    class ThreadPool
+    {
+    public:
+        /**
+        Creates a ThreadPool with the given number of worker threads. By default
+        the number of hardware threads is used.
+
+        @param[in] thread_count The number of worker threads
+        @throws std::invalid_argument if thread_count is zero
+        */
+        ThreadPool(std::size_t thread_count = default_thread_count());
+
+        /**
+        Waits for all queued tasks to finish and joins the worker threads.
+        */
+        ~ThreadPool();
+
+        /**
+        Returns the number of worker threads.
+        */
+        inline std::size_t thread_count() const noexcept
+        {
+            return workers_.size();
+        }
+
+        /**
+        Calls task(i) for every i in [0, count) on the worker threads and on the
+        calling thread, and returns once all calls have finished. If any of the
+        calls throws, the first exception is rethrown after all calls have
+        finished.
+
+        @param[in] count The number of calls to make
+        @param[in] task The function to call
+        */
+        void parallel_for(std::size_t count,
+            const std::function<void(std::size_t)> &task);
+
+        /**
+        Returns the number of hardware threads, or 1 if it cannot be determined.
+        */
+        static inline std::size_t default_thread_count() noexcept
+        {
+            std::size_t count = std::thread::hardware_concurrency();
+            return count ? count : 1;
+        }
+
+    private:
+        ThreadPool(const ThreadPool &copy) = delete;
+
+        ThreadPool &operator =(const ThreadPool &assign) = delete;
+
+        void run_worker();
+
+        std::vector<std::thread> workers_;
+
+        std::queue<std::function<void()>> jobs_;
+
+        std::mutex jobs_mutex_;
+
+        std::condition_variable jobs_cond_;
+
+        bool stopping_ = false;
+    };
+}
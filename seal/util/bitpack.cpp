@@ -0,0 +1,224 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdexcept>
+#include <algorithm>
+#include "seal/util/bitpack.h"
+#include "seal/util/common.h"
+#include "seal/util/pointer.h"
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            inline void store_word(uint64_t word, SEAL_BYTE *destination, 
+                size_t byte_count)
+            {
+                for (size_t i = 0; i < byte_count; i++, word >>= 8)
+                {
+                    destination[i] = static_cast<SEAL_BYTE>(word);
+                }
+            }
+
+            inline uint64_t load_word(const SEAL_BYTE *source, size_t byte_count)
+            {
+                uint64_t word = 0;
+                for (size_t i = 0; i < byte_count; i++)
+                {
+                    word |= static_cast<uint64_t>(source[i]) << (i << 3);
+                }
+                return word;
+            }
+        }
+
+        void bit_pack(const uint64_t *values, size_t count, int bit_width, 
+            SEAL_BYTE *destination)
+        {
+#ifdef SEAL_DEBUG
+            if (bit_width < 0 || bit_width > bits_per_uint64)
+            {
+                throw invalid_argument("bit_width");
+            }
+#endif
+            if (!bit_width)
+            {
+                return;
+            }
+
+            // Whole 64-bit words are emitted at a time; acc_bits < 64 always
+            uint64_t acc = 0;
+            int acc_bits = 0;
+            for (size_t i = 0; i < count; i++)
+            {
+                uint64_t value = values[i];
+                acc |= value << acc_bits;
+                acc_bits += bit_width;
+                if (acc_bits >= bits_per_uint64)
+                {
+                    store_word(acc, destination, bytes_per_uint64);
+                    destination += bytes_per_uint64;
+                    acc_bits -= bits_per_uint64;
+
+                    // Bits of value that did not fit in the word just written
+                    acc = acc_bits ? value >> (bit_width - acc_bits) : 0;
+                }
+            }
+            store_word(acc, destination, static_cast<size_t>((acc_bits + 7) >> 3));
+        }
+
+        void bit_unpack(const SEAL_BYTE *source, size_t count, int bit_width,
+            uint64_t *destination)
+        {
+#ifdef SEAL_DEBUG
+            if (bit_width < 0 || bit_width > bits_per_uint64)
+            {
+                throw invalid_argument("bit_width");
+            }
+#endif
+            if (!bit_width)
+            {
+                fill_n(destination, count, uint64_t(0));
+                return;
+            }
+
+            uint64_t mask = (bit_width == bits_per_uint64) ? 
+                ~uint64_t(0) : (uint64_t(1) << bit_width) - 1;
+            size_t bytes_left = bit_packed_byte_count(count, bit_width);
+            uint64_t acc = 0;
+            int acc_bits = 0;
+            for (size_t i = 0; i < count; i++)
+            {
+                if (acc_bits >= bit_width)
+                {
+                    destination[i] = acc & mask;
+                    acc = (bit_width == bits_per_uint64) ? 0 : acc >> bit_width;
+                    acc_bits -= bit_width;
+                    continue;
+                }
+
+                // Need the next word; the low acc_bits of the value are in acc
+                size_t byte_count = min<size_t>(bytes_left, bytes_per_uint64);
+                uint64_t word = load_word(source, byte_count);
+                source += byte_count;
+                bytes_left -= byte_count;
+
+                int consumed = bit_width - acc_bits;
+                destination[i] = (acc | (word << acc_bits)) & mask;
+                acc = (consumed == bits_per_uint64) ? 0 : word >> consumed;
+                acc_bits = static_cast<int>(byte_count << 3) - consumed;
+            }
+        }
+
+        void save_bit_packed(const uint64_t *values, size_t count, 
+            size_t chunk_size, ostream &stream)
+        {
+            if (!chunk_size)
+            {
+                throw invalid_argument("chunk_size must be positive");
+            }
+            size_t chunk_count = (count + chunk_size - 1) / chunk_size;
+
+            uint64_t count64 = safe_cast<uint64_t>(count);
+            stream.write(reinterpret_cast<const char*>(&count64), sizeof(uint64_t));
+            uint64_t chunk_size64 = safe_cast<uint64_t>(chunk_size);
+            stream.write(reinterpret_cast<const char*>(&chunk_size64), sizeof(uint64_t));
+
+            // Save the bit width of every chunk first
+            auto pool = MemoryManager::GetPool();
+            auto bit_widths(allocate<SEAL_BYTE>(chunk_count, pool));
+            size_t max_chunk_byte_count = 0;
+            for (size_t i = 0; i < chunk_count; i++)
+            {
+                size_t this_chunk_size = min(chunk_size, count - i * chunk_size);
+                int bit_width = max_significant_bit_count(
+                    values + i * chunk_size, this_chunk_size);
+                bit_widths[i] = static_cast<SEAL_BYTE>(bit_width);
+                max_chunk_byte_count = max(max_chunk_byte_count,
+                    bit_packed_byte_count(this_chunk_size, bit_width));
+            }
+            stream.write(reinterpret_cast<const char*>(bit_widths.get()),
+                safe_cast<streamsize>(chunk_count));
+
+            // Then the packed chunks
+            auto buffer(allocate<SEAL_BYTE>(max_chunk_byte_count, pool));
+            for (size_t i = 0; i < chunk_count; i++)
+            {
+                size_t this_chunk_size = min(chunk_size, count - i * chunk_size);
+                int bit_width = static_cast<int>(bit_widths[i]);
+                bit_pack(values + i * chunk_size, this_chunk_size, bit_width, 
+                    buffer.get());
+                stream.write(reinterpret_cast<const char*>(buffer.get()),
+                    safe_cast<streamsize>(bit_packed_byte_count(
+                        this_chunk_size, bit_width)));
+            }
+        }
+
+        size_t bit_packed_save_size(const uint64_t *values, size_t count,
+            size_t chunk_size)
+        {
+            if (!chunk_size)
+            {
+                throw invalid_argument("chunk_size must be positive");
+            }
+            size_t chunk_count = (count + chunk_size - 1) / chunk_size;
+
+            // Count, chunk size, and one bit width byte per chunk
+            size_t result = add_safe(2 * sizeof(uint64_t), chunk_count);
+            for (size_t i = 0; i < chunk_count; i++)
+            {
+                size_t this_chunk_size = min(chunk_size, count - i * chunk_size);
+                result = add_safe(result, bit_packed_byte_count(this_chunk_size,
+                    max_significant_bit_count(values + i * chunk_size, this_chunk_size)));
+            }
+            return result;
+        }
+
+        void load_bit_packed(istream &stream, IntArray<uint64_t> &destination)
+        {
+            uint64_t count64 = 0;
+            stream.read(reinterpret_cast<char*>(&count64), sizeof(uint64_t));
+            uint64_t chunk_size64 = 0;
+            stream.read(reinterpret_cast<char*>(&chunk_size64), sizeof(uint64_t));
+            size_t count = safe_cast<size_t>(count64);
+            size_t chunk_size = safe_cast<size_t>(chunk_size64);
+            if (!chunk_size && count)
+            {
+                throw invalid_argument("bit-packed data is invalid");
+            }
+            size_t chunk_count = count ? (count + chunk_size - 1) / chunk_size : 0;
+
+            auto pool = destination.pool();
+            auto bit_widths(allocate<SEAL_BYTE>(chunk_count, pool));
+            stream.read(reinterpret_cast<char*>(bit_widths.get()),
+                safe_cast<streamsize>(chunk_count));
+            size_t max_chunk_byte_count = 0;
+            for (size_t i = 0; i < chunk_count; i++)
+            {
+                int bit_width = static_cast<int>(bit_widths[i]);
+                if (bit_width > bits_per_uint64)
+                {
+                    throw invalid_argument("bit-packed data is invalid");
+                }
+                max_chunk_byte_count = max(max_chunk_byte_count,
+                    bit_packed_byte_count(min(chunk_size, count), bit_width));
+            }
+
+            destination.resize(count);
+            auto buffer(allocate<SEAL_BYTE>(max_chunk_byte_count, pool));
+            for (size_t i = 0; i < chunk_count; i++)
+            {
+                size_t this_chunk_size = min(chunk_size, count - i * chunk_size);
+                int bit_width = static_cast<int>(bit_widths[i]);
+                size_t byte_count = bit_packed_byte_count(this_chunk_size, bit_width);
+                stream.read(reinterpret_cast<char*>(buffer.get()),
+                    safe_cast<streamsize>(byte_count));
+                bit_unpack(buffer.get(), this_chunk_size, bit_width,
+                    destination.begin() + i * chunk_size);
+            }
+        }
+    }
+}
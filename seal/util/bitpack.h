@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include "seal/util/defines.h"
+#include "seal/intarray.h"
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        Identifies data saved in compr_mode_type::bit_packed. The bytes spell 
+        "SEALPACK" when read in little-endian order. Data saved without 
+        compression starts with a parms_id instead.
+        */
+        constexpr std::uint64_t bit_packed_magic = 0x4B4341504C414553ULL;
+
+        /**
+        Version of the bit-packed format.
+        */
+        constexpr std::uint64_t bit_packed_version = 1;
+
+        /**
+        Returns the bit width needed to store every one of the given values.
+        */
+        inline int max_significant_bit_count(const std::uint64_t *values, 
+            std::size_t count)
+        {
+            std::uint64_t all_bits = 0;
+            for (std::size_t i = 0; i < count; i++)
+            {
+                all_bits |= values[i];
+            }
+            return get_significant_bit_count(all_bits);
+        }
+
+        /**
+        Returns the number of bytes occupied by count values of bit_width bits.
+        */
+        inline std::size_t bit_packed_byte_count(std::size_t count, int bit_width)
+        {
+            return static_cast<std::size_t>(
+                (mul_safe(count, static_cast<std::size_t>(bit_width)) + 7) >> 3);
+        }
+
+        /**
+        Packs count values of at most bit_width bits densely into little-endian 
+        order. The destination must hold bit_packed_byte_count(count, bit_width)
+        bytes.
+        */
+        void bit_pack(const std::uint64_t *values, std::size_t count, 
+            int bit_width, SEAL_BYTE *destination);
+
+        /**
+        Reverses bit_pack.
+        */
+        void bit_unpack(const SEAL_BYTE *source, std::size_t count, 
+            int bit_width, std::uint64_t *destination);
+
+        /**
+        Writes count values to a stream in blocks of chunk_size values, each 
+        block packed at its own significant bit width.
+        */
+        void save_bit_packed(const std::uint64_t *values, std::size_t count, 
+            std::size_t chunk_size, std::ostream &stream);
+
+        /**
+        Returns the number of bytes save_bit_packed writes for the given values.
+        */
+        std::size_t bit_packed_save_size(const std::uint64_t *values, 
+            std::size_t count, std::size_t chunk_size);
+
+        /**
+        Reads values written by save_bit_packed into an IntArray, resizing it.
+        */
+        void load_bit_packed(std::istream &stream, 
+            IntArray<std::uint64_t> &destination);
+    }
+}
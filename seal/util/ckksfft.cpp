@@ -0,0 +1,343 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include "seal/util/defines.h"
+#include "seal/util/ckksfft.h"
+
+#if (SEAL_COMPILER == SEAL_COMPILER_GCC || SEAL_COMPILER == SEAL_COMPILER_CLANG) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define SEAL_FFT_USE_X86_SIMD
+#include <immintrin.h>
+
+// AVX-512 implies FMA; keep GCC from contracting the butterflies
+#if SEAL_COMPILER == SEAL_COMPILER_GCC
+#define SEAL_FFT_TARGET(isa) __attribute__((target(isa), optimize("fp-contract=off")))
+#else
+#define SEAL_FFT_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            // (x, y) <- (x + y, (x - y) * w), multiplied as std::complex<double> does
+            inline void inverse_butterfly(double *real, double *imag, size_t x, size_t y,
+                double w_real, double w_imag)
+            {
+                double d_real = real[x] - real[y];
+                double d_imag = imag[x] - imag[y];
+                real[x] += real[y];
+                imag[x] += imag[y];
+                real[y] = d_real * w_real - d_imag * w_imag;
+                imag[y] = d_real * w_imag + d_imag * w_real;
+            }
+
+            // (x, y) <- (x + y * w, x - y * w)
+            inline void forward_butterfly(double *real, double *imag, size_t x, size_t y,
+                double w_real, double w_imag)
+            {
+                double v_real = real[y] * w_real - imag[y] * w_imag;
+                double v_imag = real[y] * w_imag + imag[y] * w_real;
+                real[y] = real[x] - v_real;
+                imag[y] = imag[x] - v_imag;
+                real[x] += v_real;
+                imag[x] += v_imag;
+            }
+
+            /*
+            One radix-4 pass of the inverse transform: the levels with gap tt and 2tt.
+            Each block of 4tt values uses two twiddles for the first level and one for
+            the second.
+            */
+            void inverse_fft_pass_radix4(double *real, double *imag, size_t n, size_t tt,
+                const double *w_real, const double *w_imag)
+            {
+                size_t h = n / (2 * tt);
+                for (size_t b = 0; b < h / 2; b++)
+                {
+                    double wa0_real = w_real[h + 2 * b], wa0_imag = w_imag[h + 2 * b];
+                    double wa1_real = w_real[h + 2 * b + 1], wa1_imag = w_imag[h + 2 * b + 1];
+                    double wb_real = w_real[h / 2 + b], wb_imag = w_imag[h / 2 + b];
+                    size_t base = b * 4 * tt;
+                    for (size_t k = base; k < base + tt; k++)
+                    {
+                        inverse_butterfly(real, imag, k, k + tt, wa0_real, wa0_imag);
+                        inverse_butterfly(real, imag, k + 2 * tt, k + 3 * tt,
+                            wa1_real, wa1_imag);
+                        inverse_butterfly(real, imag, k, k + 2 * tt, wb_real, wb_imag);
+                        inverse_butterfly(real, imag, k + tt, k + 3 * tt, wb_real, wb_imag);
+                    }
+                }
+            }
+
+            // One radix-2 pass of the inverse transform with gap tt
+            void inverse_fft_pass_radix2(double *real, double *imag, size_t n, size_t tt,
+                const double *w_real, const double *w_imag)
+            {
+                size_t h = n / (2 * tt);
+                for (size_t j = 0; j < h; j++)
+                {
+                    size_t base = j * 2 * tt;
+                    for (size_t k = base; k < base + tt; k++)
+                    {
+                        inverse_butterfly(real, imag, k, k + tt, w_real[h + j], w_imag[h + j]);
+                    }
+                }
+            }
+
+            /*
+            One radix-4 pass of the forward transform: the levels with gap 2q and q.
+            Each block of 4q values uses one twiddle for the first level and two for
+            the second.
+            */
+            void fft_pass_radix4(double *real, double *imag, size_t n, size_t q,
+                const double *w_real, const double *w_imag)
+            {
+                size_t mm = n / (4 * q);
+                for (size_t j = 0; j < mm; j++)
+                {
+                    double wa_real = w_real[mm + j], wa_imag = w_imag[mm + j];
+                    double wb0_real = w_real[2 * mm + 2 * j];
+                    double wb0_imag = w_imag[2 * mm + 2 * j];
+                    double wb1_real = w_real[2 * mm + 2 * j + 1];
+                    double wb1_imag = w_imag[2 * mm + 2 * j + 1];
+                    size_t base = j * 4 * q;
+                    for (size_t k = base; k < base + q; k++)
+                    {
+                        forward_butterfly(real, imag, k, k + 2 * q, wa_real, wa_imag);
+                        forward_butterfly(real, imag, k + q, k + 3 * q, wa_real, wa_imag);
+                        forward_butterfly(real, imag, k, k + q, wb0_real, wb0_imag);
+                        forward_butterfly(real, imag, k + 2 * q, k + 3 * q,
+                            wb1_real, wb1_imag);
+                    }
+                }
+            }
+
+            // One radix-2 pass of the forward transform with gap tt
+            void fft_pass_radix2(double *real, double *imag, size_t n, size_t tt,
+                const double *w_real, const double *w_imag)
+            {
+                size_t mm = n / (2 * tt);
+                for (size_t j = 0; j < mm; j++)
+                {
+                    size_t base = j * 2 * tt;
+                    for (size_t k = base; k < base + tt; k++)
+                    {
+                        forward_butterfly(real, imag, k, k + tt,
+                            w_real[mm + j], w_imag[mm + j]);
+                    }
+                }
+            }
+
+#ifdef SEAL_FFT_USE_X86_SIMD
+            /*
+            The vectorized passes run the same butterflies on 4 (AVX2) or 8 (AVX-512)
+            consecutive k at a time with broadcast twiddles. No fused multiply-add is
+            used, so that the results match the scalar passes exactly. They return
+            false, without doing anything, when the gap is narrower than a vector.
+            */
+#define SEAL_FFT_DEFINE_PASSES(suffix, isa, vec, width, set1, load, store, add,     \
+    sub, mul)                                                                       \
+            SEAL_FFT_TARGET(isa)                                                    \
+            inline void inverse_butterfly_##suffix(double *real, double *imag,      \
+                size_t x, size_t y, vec w_real, vec w_imag)                         \
+            {                                                                       \
+                vec x_real = load(real + x), x_imag = load(imag + x);               \
+                vec y_real = load(real + y), y_imag = load(imag + y);               \
+                vec d_real = sub(x_real, y_real), d_imag = sub(x_imag, y_imag);     \
+                store(real + x, add(x_real, y_real));                               \
+                store(imag + x, add(x_imag, y_imag));                               \
+                store(real + y, sub(mul(d_real, w_real), mul(d_imag, w_imag)));     \
+                store(imag + y, add(mul(d_real, w_imag), mul(d_imag, w_real)));     \
+            }                                                                       \
+                                                                                    \
+            SEAL_FFT_TARGET(isa)                                                    \
+            inline void forward_butterfly_##suffix(double *real, double *imag,      \
+                size_t x, size_t y, vec w_real, vec w_imag)                         \
+            {                                                                       \
+                vec x_real = load(real + x), x_imag = load(imag + x);               \
+                vec y_real = load(real + y), y_imag = load(imag + y);               \
+                vec v_real = sub(mul(y_real, w_real), mul(y_imag, w_imag));         \
+                vec v_imag = add(mul(y_real, w_imag), mul(y_imag, w_real));         \
+                store(real + y, sub(x_real, v_real));                               \
+                store(imag + y, sub(x_imag, v_imag));                               \
+                store(real + x, add(x_real, v_real));                               \
+                store(imag + x, add(x_imag, v_imag));                               \
+            }                                                                       \
+                                                                                    \
+            SEAL_FFT_TARGET(isa)                                                    \
+            bool inverse_fft_pass_radix4_##suffix(double *real, double *imag,       \
+                size_t n, size_t tt, const double *w_real, const double *w_imag)    \
+            {                                                                       \
+                if (tt < width)                                                     \
+                {                                                                   \
+                    return false;                                                   \
+                }                                                                   \
+                size_t h = n / (2 * tt);                                            \
+                for (size_t b = 0; b < h / 2; b++)                                  \
+                {                                                                   \
+                    vec wa0_real = set1(w_real[h + 2 * b]);                         \
+                    vec wa0_imag = set1(w_imag[h + 2 * b]);                         \
+                    vec wa1_real = set1(w_real[h + 2 * b + 1]);                     \
+                    vec wa1_imag = set1(w_imag[h + 2 * b + 1]);                     \
+                    vec wb_real = set1(w_real[h / 2 + b]);                          \
+                    vec wb_imag = set1(w_imag[h / 2 + b]);                          \
+                    size_t base = b * 4 * tt;                                       \
+                    for (size_t k = base; k < base + tt; k += width)                \
+                    {                                                               \
+                        inverse_butterfly_##suffix(real, imag, k, k + tt,           \
+                            wa0_real, wa0_imag);                                    \
+                        inverse_butterfly_##suffix(real, imag, k + 2 * tt,          \
+                            k + 3 * tt, wa1_real, wa1_imag);                        \
+                        inverse_butterfly_##suffix(real, imag, k, k + 2 * tt,       \
+                            wb_real, wb_imag);                                      \
+                        inverse_butterfly_##suffix(real, imag, k + tt, k + 3 * tt,  \
+                            wb_real, wb_imag);                                      \
+                    }                                                               \
+                }                                                                   \
+                return true;                                                        \
+            }                                                                       \
+                                                                                    \
+            SEAL_FFT_TARGET(isa)                                                    \
+            bool fft_pass_radix4_##suffix(double *real, double *imag,               \
+                size_t n, size_t q, const double *w_real, const double *w_imag)     \
+            {                                                                       \
+                if (q < width)                                                      \
+                {                                                                   \
+                    return false;                                                   \
+                }                                                                   \
+                size_t mm = n / (4 * q);                                            \
+                for (size_t j = 0; j < mm; j++)                                     \
+                {                                                                   \
+                    vec wa_real = set1(w_real[mm + j]);                             \
+                    vec wa_imag = set1(w_imag[mm + j]);                             \
+                    vec wb0_real = set1(w_real[2 * mm + 2 * j]);                    \
+                    vec wb0_imag = set1(w_imag[2 * mm + 2 * j]);                    \
+                    vec wb1_real = set1(w_real[2 * mm + 2 * j + 1]);                \
+                    vec wb1_imag = set1(w_imag[2 * mm + 2 * j + 1]);                \
+                    size_t base = j * 4 * q;                                        \
+                    for (size_t k = base; k < base + q; k += width)                 \
+                    {                                                               \
+                        forward_butterfly_##suffix(real, imag, k, k + 2 * q,        \
+                            wa_real, wa_imag);                                      \
+                        forward_butterfly_##suffix(real, imag, k + q, k + 3 * q,    \
+                            wa_real, wa_imag);                                      \
+                        forward_butterfly_##suffix(real, imag, k, k + q,            \
+                            wb0_real, wb0_imag);                                    \
+                        forward_butterfly_##suffix(real, imag, k + 2 * q,           \
+                            k + 3 * q, wb1_real, wb1_imag);                         \
+                    }                                                               \
+                }                                                                   \
+                return true;                                                        \
+            }
+
+            SEAL_FFT_DEFINE_PASSES(avx2, "avx2", __m256d, 4, _mm256_set1_pd,
+                _mm256_loadu_pd, _mm256_storeu_pd, _mm256_add_pd, _mm256_sub_pd,
+                _mm256_mul_pd)
+
+            SEAL_FFT_DEFINE_PASSES(avx512, "avx512f", __m512d, 8, _mm512_set1_pd,
+                _mm512_loadu_pd, _mm512_storeu_pd, _mm512_add_pd, _mm512_sub_pd,
+                _mm512_mul_pd)
+
+#undef SEAL_FFT_DEFINE_PASSES
+
+            enum class simd_level { none, avx2, avx512 };
+
+            simd_level detect_simd_level()
+            {
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx512f"))
+                {
+                    return simd_level::avx512;
+                }
+                if (__builtin_cpu_supports("avx2"))
+                {
+                    return simd_level::avx2;
+                }
+                return simd_level::none;
+            }
+
+            const simd_level fft_simd_level = detect_simd_level();
+#endif
+            // Returns whether a vectorized pass was run
+            inline bool inverse_fft_pass_radix4_simd(double *real, double *imag,
+                size_t n, size_t tt, const double *w_real, const double *w_imag)
+            {
+#ifdef SEAL_FFT_USE_X86_SIMD
+                if (fft_simd_level == simd_level::avx512 && inverse_fft_pass_radix4_avx512(
+                    real, imag, n, tt, w_real, w_imag))
+                {
+                    return true;
+                }
+                return fft_simd_level != simd_level::none && inverse_fft_pass_radix4_avx2(
+                    real, imag, n, tt, w_real, w_imag);
+#else
+                return false;
+#endif
+            }
+
+            inline bool fft_pass_radix4_simd(double *real, double *imag,
+                size_t n, size_t q, const double *w_real, const double *w_imag)
+            {
+#ifdef SEAL_FFT_USE_X86_SIMD
+                if (fft_simd_level == simd_level::avx512 && fft_pass_radix4_avx512(
+                    real, imag, n, q, w_real, w_imag))
+                {
+                    return true;
+                }
+                return fft_simd_level != simd_level::none && fft_pass_radix4_avx2(
+                    real, imag, n, q, w_real, w_imag);
+#else
+                return false;
+#endif
+            }
+        }
+
+        void inverse_fft_split(double *real, double *imag, int logn,
+            const double *inv_roots_real, const double *inv_roots_imag)
+        {
+            size_t n = size_t(1) << logn;
+            size_t tt = 1;
+            int level = 0;
+            for (; level + 1 < logn; level += 2, tt <<= 2)
+            {
+                if (!inverse_fft_pass_radix4_simd(real, imag, n, tt,
+                    inv_roots_real, inv_roots_imag))
+                {
+                    inverse_fft_pass_radix4(real, imag, n, tt,
+                        inv_roots_real, inv_roots_imag);
+                }
+            }
+            if (level < logn)
+            {
+                inverse_fft_pass_radix2(real, imag, n, tt,
+                    inv_roots_real, inv_roots_imag);
+            }
+        }
+
+        void fft_split(double *real, double *imag, int logn,
+            const double *roots_real, const double *roots_imag)
+        {
+            size_t n = size_t(1) << logn;
+            size_t tt = n >> 1;
+            int level = 0;
+            for (; level + 1 < logn; level += 2, tt >>= 2)
+            {
+                size_t q = tt >> 1;
+                if (!fft_pass_radix4_simd(real, imag, n, q, roots_real, roots_imag))
+                {
+                    fft_pass_radix4(real, imag, n, q, roots_real, roots_imag);
+                }
+            }
+            if (level < logn)
+            {
+                fft_pass_radix2(real, imag, n, tt, roots_real, roots_imag);
+            }
+        }
+    }
+}
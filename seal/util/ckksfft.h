@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstddef>
+
+namespace seal
+{
+    namespace util
+    {
+        /*
+        Transforms used by CKKSEncoder on complex vectors of length 2^logn that are
+        stored in split form: the real parts in real[0..n) and the imaginary parts
+        in imag[0..n). The twiddle factors are split the same way and stored in
+        bit-reversed order, so that roots_real[i] + i * roots_imag[i] is psi^rev(i).
+
+        The butterflies are evaluated two levels at a time (radix 4) and, where the
+        CPU supports it, with AVX2 or AVX-512 vectors selected at runtime. Every
+        output is computed with the same floating-point operations in the same
+        order as the radix-2 transforms on std::complex<double>. The results are
+        therefore identical to those, except in the last bits when the compiler is
+        allowed to contract the scalar multiply-adds into FMA instructions.
+        */
+
+        // Gentleman-Sande butterflies with the inverse roots: the transform in
+        // CKKSEncoder::encode, from slots in bit-reversed order to coefficients.
+        void inverse_fft_split(double *real, double *imag, int logn,
+            const double *inv_roots_real, const double *inv_roots_imag);
+
+        // Cooley-Tukey butterflies with the roots: the transform in
+        // CKKSEncoder::decode, from coefficients to slots in bit-reversed order.
+        void fft_split(double *real, double *imag, int logn,
+            const double *roots_real, const double *roots_imag);
+    }
+}
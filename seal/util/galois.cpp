@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdexcept>
+#include "seal/util/galois.h"
+#include "seal/util/common.h"
+#include "seal/util/uintcore.h"
+#include "seal/util/defines.h"
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        GaloisTool::GaloisTool(int coeff_count_power, MemoryPoolHandle pool) :
+            coeff_count_power_(coeff_count_power), pool_(move(pool))
+        {
+            if (!pool_)
+            {
+                throw invalid_argument("pool is uninitialized");
+            }
+            if (coeff_count_power_ < get_power_of_two(SEAL_POLY_MOD_DEGREE_MIN) ||
+                coeff_count_power_ > get_power_of_two(SEAL_POLY_MOD_DEGREE_MAX))
+            {
+                throw invalid_argument("coeff_count_power out of range");
+            }
+            coeff_count_ = size_t(1) << coeff_count_power_;
+        }
+
+        const uint32_t *GaloisTool::permutation_ntt(uint64_t galois_elt) const
+        {
+            // Verify coprime conditions.
+            if (!(galois_elt & 1) || (galois_elt >= 2 * coeff_count_))
+            {
+                throw invalid_argument("galois element is not valid");
+            }
+
+            {
+                ReaderLock lock(permutations_locker_.acquire_read());
+                auto it = permutations_.find(galois_elt);
+                if (it != permutations_.end())
+                {
+                    return it->second.get();
+                }
+            }
+
+            // Compute the table outside of the lock; if another thread stores the
+            // same table first, this one is discarded
+            auto permutation(allocate<uint32_t>(coeff_count_, pool_));
+            uint64_t m_minus_one = 2 * coeff_count_ - 1;
+            for (size_t i = 0; i < coeff_count_; i++)
+            {
+                uint64_t reversed = reverse_bits(i, coeff_count_power_);
+                uint64_t index_raw = galois_elt * (2 * reversed + 1);
+                index_raw &= m_minus_one;
+                permutation[i] = static_cast<uint32_t>(
+                    reverse_bits((index_raw - 1) >> 1, coeff_count_power_));
+            }
+
+            WriterLock lock(permutations_locker_.acquire_write());
+            return permutations_.emplace(galois_elt, move(permutation)).first->second.get();
+        }
+    }
+}
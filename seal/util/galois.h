@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+#include "seal/memorymanager.h"
+#include "seal/util/pointer.h"
+#include "seal/util/locks.h"
+
+namespace seal
+{
+    namespace util
+    {
+        /*
+        Caches the permutations that the Galois automorphisms apply to polynomials
+        in NTT form. In the bit-reversed order of the NTT the automorphism with
+        Galois element g maps the value at index i to the index
+        rev((g * (2 * rev(i) + 1) mod 2N - 1) / 2), and computing this per coefficient
+        costs two bit reversals. A GaloisTool computes the index table of each Galois
+        element the first time it is needed, after which applying the automorphism
+        is a gather. The tables depend only on the polynomial modulus degree, so
+        SEALContext holds one GaloisTool that is shared by all parameter sets in the
+        modulus switching chain. GaloisTool is thread-safe.
+        */
+        class GaloisTool
+        {
+        public:
+            GaloisTool(int coeff_count_power, MemoryPoolHandle pool);
+
+            /*
+            Returns the table of the permutation for the given Galois element:
+            the i-th coefficient of the result of the automorphism is the
+            permutation[i]-th coefficient of the input. The table is generated on
+            first use and remains valid for the lifetime of the GaloisTool.
+            */
+            const std::uint32_t *permutation_ntt(std::uint64_t galois_elt) const;
+
+            inline std::size_t coeff_count() const noexcept
+            {
+                return coeff_count_;
+            }
+
+        private:
+            GaloisTool(const GaloisTool &copy) = delete;
+
+            GaloisTool &operator =(const GaloisTool &assign) = delete;
+
+            int coeff_count_power_;
+
+            std::size_t coeff_count_;
+
+            MemoryPoolHandle pool_;
+
+            mutable ReaderWriterLocker permutations_locker_;
+
+            mutable std::unordered_map<std::uint64_t, Pointer<std::uint32_t>> permutations_;
+        };
+    }
+}
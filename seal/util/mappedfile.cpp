@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdexcept>
+#include "seal/util/mappedfile.h"
+#include "seal/util/common.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+#ifdef _WIN32
+        MappedFile::MappedFile(const string &path)
+        {
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+            {
+                throw runtime_error("failed to open file");
+            }
+
+            LARGE_INTEGER file_size;
+            if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+            {
+                CloseHandle(file);
+                throw runtime_error("failed to map file");
+            }
+
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+            if (!mapping)
+            {
+                CloseHandle(file);
+                throw runtime_error("failed to map file");
+            }
+
+            void *view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+            if (!view)
+            {
+                CloseHandle(mapping);
+                CloseHandle(file);
+                throw runtime_error("failed to map file");
+            }
+
+            file_handle_ = file;
+            mapping_handle_ = mapping;
+            data_ = static_cast<SEAL_BYTE*>(view);
+            size_ = safe_cast<size_t>(file_size.QuadPart);
+        }
+
+        MappedFile::~MappedFile() noexcept
+        {
+            UnmapViewOfFile(data_);
+            CloseHandle(static_cast<HANDLE>(mapping_handle_));
+            CloseHandle(static_cast<HANDLE>(file_handle_));
+        }
+#else
+        MappedFile::MappedFile(const string &path)
+        {
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd == -1)
+            {
+                throw runtime_error("failed to open file");
+            }
+
+            struct stat file_stat;
+            if (fstat(fd, &file_stat) == -1 || file_stat.st_size <= 0)
+            {
+                close(fd);
+                throw runtime_error("failed to map file");
+            }
+            size_t size = safe_cast<size_t>(file_stat.st_size);
+
+            // A private writable mapping keeps pages shared with the page cache
+            // until written to; nothing ever propagates back to the file.
+            void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+            // The mapping stays valid after the descriptor is closed
+            close(fd);
+            if (addr == MAP_FAILED)
+            {
+                throw runtime_error("failed to map file");
+            }
+
+            data_ = static_cast<SEAL_BYTE*>(addr);
+            size_ = size;
+        }
+
+        MappedFile::~MappedFile() noexcept
+        {
+            munmap(data_, size_);
+        }
+#endif
+    }
+}
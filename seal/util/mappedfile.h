@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "seal/util/defines.h"
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        Identifies a file written in the memory-mappable key format. The bytes
+        spell "SEALKMAP" when read in little-endian order.
+        */
+        constexpr std::uint64_t mapped_keys_magic = 0x50414D4B4C414553ULL;
+
+        /**
+        Version of the memory-mappable key format.
+        */
+        constexpr std::uint64_t mapped_keys_version = 1;
+
+        /**
+        A read-only view of an entire file mapped into memory. The mapping is 
+        private (copy-on-write), so pages are faulted in from the page cache on
+        first access and are shared with any other process mapping the same 
+        file, while writes to the mapped memory never reach the file.
+        */
+        class MappedFile
+        {
+        public:
+            MappedFile(const std::string &path);
+
+            ~MappedFile() noexcept;
+
+            inline SEAL_BYTE *data() const noexcept
+            {
+                return data_;
+            }
+
+            inline std::size_t size() const noexcept
+            {
+                return size_;
+            }
+
+        private:
+            MappedFile(const MappedFile &copy) = delete;
+
+            MappedFile &operator =(const MappedFile &assign) = delete;
+
+            SEAL_BYTE *data_ = nullptr;
+
+            std::size_t size_ = 0;
+
+#ifdef _WIN32
+            void *file_handle_ = nullptr;
+
+            void *mapping_handle_ = nullptr;
+#endif
+        };
+    }
+}
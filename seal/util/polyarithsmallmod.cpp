@@ -10,12 +10,44 @@
 #include "seal/util/polyarithsmallmod.h"
 #include "seal/util/defines.h"
 
+#if (SEAL_COMPILER == SEAL_COMPILER_GCC || SEAL_COMPILER == SEAL_COMPILER_CLANG) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define SEAL_GALOIS_USE_AVX2_GATHER
+#include <immintrin.h>
+#endif
+
 using namespace std;
 
 namespace seal
 {
     namespace util
     {
+#ifdef SEAL_GALOIS_USE_AVX2_GATHER
+        namespace
+        {
+            __attribute__((target("avx2")))
+            void gather_avx2(const uint64_t *input, size_t coeff_count,
+                const uint32_t *permutation, uint64_t *result)
+            {
+                for (size_t i = 0; i < coeff_count; i += 4)
+                {
+                    __m128i indices = _mm_loadu_si128(
+                        reinterpret_cast<const __m128i *>(permutation + i));
+                    __m256i values = _mm256_i32gather_epi64(
+                        reinterpret_cast<const long long *>(input), indices, 8);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(result + i), values);
+                }
+            }
+
+            bool detect_avx2()
+            {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2");
+            }
+
+            const bool has_avx2 = detect_avx2();
+        }
+#endif
         void multiply_poly_scalar_coeffmod(const uint64_t *poly, 
             size_t coeff_count, uint64_t scalar, const SmallModulus &modulus, 
             uint64_t *result)
@@ -394,6 +426,41 @@ namespace seal
             }
         }
 
+        void apply_galois_ntt(const uint64_t *input, size_t coeff_count,
+            const uint32_t *permutation, uint64_t *result)
+        {
+#ifdef SEAL_DEBUG
+            if (input == nullptr)
+            {
+                throw invalid_argument("input");
+            }
+            if (permutation == nullptr)
+            {
+                throw invalid_argument("permutation");
+            }
+            if (result == nullptr)
+            {
+                throw invalid_argument("result");
+            }
+            if (input == result)
+            {
+                throw invalid_argument("result cannot point to the same value as input");
+            }
+#endif
+#ifdef SEAL_GALOIS_USE_AVX2_GATHER
+            // The degree is a power of two of at least SEAL_POLY_MOD_DEGREE_MIN
+            if (has_avx2 && !(coeff_count & 3))
+            {
+                gather_avx2(input, coeff_count, permutation, result);
+                return;
+            }
+#endif
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                result[i] = input[permutation[i]];
+            }
+        }
+
         void dyadic_product_coeffmod(const uint64_t *operand1, 
             const uint64_t *operand2, size_t coeff_count, 
             const SmallModulus &modulus, uint64_t *result)
@@ -456,6 +523,60 @@ namespace seal
             }
         }
 
+        void dyadic_product_karatsuba_coeffmod(const uint64_t *operand1_0,
+            const uint64_t *operand1_1, const uint64_t *operand2_0,
+            const uint64_t *operand2_1, size_t coeff_count,
+            const SmallModulus &modulus, uint64_t *result0, uint64_t *result1,
+            uint64_t *result2)
+        {
+#ifdef SEAL_DEBUG
+            if (operand1_0 == nullptr || operand1_1 == nullptr)
+            {
+                throw invalid_argument("operand1");
+            }
+            if (operand2_0 == nullptr || operand2_1 == nullptr)
+            {
+                throw invalid_argument("operand2");
+            }
+            if (result0 == nullptr || result1 == nullptr || result2 == nullptr)
+            {
+                throw invalid_argument("result");
+            }
+            if (coeff_count == 0)
+            {
+                throw invalid_argument("coeff_count");
+            }
+            if (modulus.is_zero())
+            {
+                throw invalid_argument("modulus");
+            }
+#endif
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                unsigned long long z0[2], z1[2], z2[2], tmp;
+
+                // c0 * d0, c1 * d1 and (c0 + c1) * (d0 + d1), all without reduction
+                multiply_uint64(operand1_0[i], operand2_0[i], z0);
+                multiply_uint64(operand1_1[i], operand2_1[i], z2);
+                multiply_uint64(operand1_0[i] + operand1_1[i],
+                    operand2_0[i] + operand2_1[i], z1);
+
+                // (c0 + c1) * (d0 + d1) - c0 * d0 - c1 * d1 = c0 * d1 + c1 * d0 is
+                // non-negative, so the subtractions are exact in 128 bits
+                unsigned char borrow = sub_uint64(z1[0], z0[0], &tmp);
+                z1[0] = tmp;
+                z1[1] -= z0[1] + borrow;
+                borrow = sub_uint64(z1[0], z2[0], &tmp);
+                z1[0] = tmp;
+                z1[1] -= z2[1] + borrow;
+
+                // One reduction per output coefficient
+                result0[i] = barrett_reduce_128(z0, modulus);
+                result1[i] = barrett_reduce_128(z1, modulus);
+                result2[i] = barrett_reduce_128(z2, modulus);
+            }
+        }
+
         uint64_t poly_infty_norm_coeffmod(const uint64_t *operand, 
             size_t coeff_count, const SmallModulus &modulus)
         {
@@ -199,10 +199,26 @@ namespace seal
         void apply_galois_ntt(const std::uint64_t *input, int coeff_count_power, 
             std::uint64_t galois_elt, std::uint64_t *result);
 
+        // Applies a Galois automorphism to a polynomial in NTT form with a
+        // permutation table from GaloisTool::permutation_ntt
+        void apply_galois_ntt(const std::uint64_t *input, std::size_t coeff_count,
+            const std::uint32_t *permutation, std::uint64_t *result);
+
         void dyadic_product_coeffmod(const std::uint64_t *operand1, 
             const std::uint64_t *operand2, std::size_t coeff_count, 
             const SmallModulus &modulus, std::uint64_t *result);
 
+        // Computes the dyadic tensor product (operand1_0 + operand1_1 * s) *
+        // (operand2_0 + operand2_1 * s) with three multiplications per coefficient
+        // (Karatsuba) in a single pass. Inputs need not be reduced, but the sums
+        // operand1_0 + operand1_1 and operand2_0 + operand2_1 must fit in 64 bits
+        // (e.g. outputs of the lazy NTT). Results are reduced modulo modulus.
+        void dyadic_product_karatsuba_coeffmod(const std::uint64_t *operand1_0,
+            const std::uint64_t *operand1_1, const std::uint64_t *operand2_0,
+            const std::uint64_t *operand2_1, std::size_t coeff_count,
+            const SmallModulus &modulus, std::uint64_t *result0,
+            std::uint64_t *result1, std::uint64_t *result2);
+
         std::uint64_t poly_infty_norm_coeffmod(const std::uint64_t *operand, 
             std::size_t coeff_count, const SmallModulus &modulus);
 
@@ -0,0 +1,530 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#include <stdexcept>
+#include "seal/util/seededkeys.h"
+#include "seal/util/common.h"
+#include "seal/util/defines.h"
+#include "seal/util/uintcore.h"
+#include "seal/util/smallntt.h"
+#include "seal/util/bitpack.h"
+
+using namespace std;
+
+namespace seal
+{
+    namespace util
+    {
+        namespace
+        {
+            // Rejection sampling keeps the values uniform modulo the primes
+            void sample_poly_uniform(ChaCha20PRNG &random,
+                const vector<SmallModulus> &coeff_modulus, size_t coeff_count,
+                size_t coeff_mod_count, uint64_t *poly)
+            {
+                for (size_t j = 0; j < coeff_mod_count; j++)
+                {
+                    uint64_t current_modulus = coeff_modulus[j].value();
+                    uint64_t max_multiple = uint64_t(0) -
+                        (uint64_t(0) - current_modulus) % current_modulus;
+                    for (size_t k = 0; k < coeff_count; k++, poly++)
+                    {
+                        uint64_t new_coeff;
+                        do
+                        {
+                            new_coeff = static_cast<uint64_t>(random.generate()) << 32;
+                            new_coeff |= static_cast<uint64_t>(random.generate());
+                        } while (max_multiple && new_coeff >= max_multiple);
+                        *poly = new_coeff % current_modulus;
+                    }
+                }
+            }
+
+            inline void read_seeded_version(istream &stream)
+            {
+                uint64_t version = 0;
+                stream.read(reinterpret_cast<char*>(&version), sizeof(uint64_t));
+                if (version != seeded_keys_version)
+                {
+                    throw invalid_argument("unsupported format version");
+                }
+            }
+
+            // The saved polynomials are written without Ciphertext metadata,
+            // which is implied by the context, since a Ciphertext cannot have
+            // size 1; the compression mode is written once before them
+            inline void write_compr_mode(ostream &stream, compr_mode_type compr_mode)
+            {
+                if (compr_mode != compr_mode_type::none &&
+                    compr_mode != compr_mode_type::bit_packed)
+                {
+                    throw invalid_argument("unsupported compression mode");
+                }
+                SEAL_BYTE compr_mode_byte = static_cast<SEAL_BYTE>(compr_mode);
+                stream.write(reinterpret_cast<const char*>(&compr_mode_byte),
+                    sizeof(SEAL_BYTE));
+            }
+
+            inline compr_mode_type read_compr_mode(istream &stream)
+            {
+                SEAL_BYTE compr_mode_byte;
+                stream.read(reinterpret_cast<char*>(&compr_mode_byte),
+                    sizeof(SEAL_BYTE));
+                auto compr_mode = static_cast<compr_mode_type>(compr_mode_byte);
+                if (compr_mode != compr_mode_type::none &&
+                    compr_mode != compr_mode_type::bit_packed)
+                {
+                    throw invalid_argument("unsupported compression mode");
+                }
+                return compr_mode;
+            }
+
+            // With bit packing every RNS component gets its own bit width
+            void save_poly(const uint64_t *poly, size_t coeff_count,
+                size_t coeff_mod_count, ostream &stream, compr_mode_type compr_mode)
+            {
+                size_t poly_uint64_count = mul_safe(coeff_count, coeff_mod_count);
+                if (compr_mode == compr_mode_type::bit_packed)
+                {
+                    save_bit_packed(poly, poly_uint64_count, coeff_count, stream);
+                }
+                else
+                {
+                    stream.write(reinterpret_cast<const char*>(poly),
+                        safe_cast<streamsize>(
+                            mul_safe(poly_uint64_count, sizeof(uint64_t))));
+                }
+            }
+
+            void load_poly(istream &stream, compr_mode_type compr_mode,
+                size_t coeff_count, size_t coeff_mod_count, uint64_t *poly,
+                MemoryPoolHandle pool)
+            {
+                size_t poly_uint64_count = mul_safe(coeff_count, coeff_mod_count);
+                if (compr_mode == compr_mode_type::bit_packed)
+                {
+                    IntArray<uint64_t> values(move(pool));
+                    load_bit_packed(stream, values);
+                    if (values.size() != poly_uint64_count)
+                    {
+                        throw invalid_argument("keys are not valid for encryption parameters");
+                    }
+                    set_uint_uint(values.cbegin(), poly_uint64_count, poly);
+                }
+                else
+                {
+                    stream.read(reinterpret_cast<char*>(poly),
+                        safe_cast<streamsize>(
+                            mul_safe(poly_uint64_count, sizeof(uint64_t))));
+                }
+            }
+        }
+
+        void expand_kswitch_seed(const prng_seed_type &seed,
+            const SEALContext &context, Ciphertext &component)
+        {
+            auto context_data_ptr = context.context_data(component.parms_id());
+            if (!context_data_ptr)
+            {
+                throw invalid_argument("component is not valid for encryption parameters");
+            }
+
+            // Extract encryption parameters.
+            auto &coeff_modulus = context_data_ptr->parms().coeff_modulus();
+            size_t coeff_count = component.poly_modulus_degree();
+            size_t coeff_mod_count = component.coeff_mod_count();
+
+            ChaCha20PRNG random(seed);
+            for (size_t i = 1; i < component.size(); i += 2)
+            {
+                sample_poly_uniform(random, coeff_modulus, coeff_count,
+                    coeff_mod_count, component.data(i));
+            }
+        }
+
+        void save_seeded_kswitch_keys(const parms_id_type &parms_id,
+            int decomposition_bit_count, const vector<vector<Ciphertext>> &keys,
+            const vector<vector<prng_seed_type>> &seeds, ostream &stream,
+            compr_mode_type compr_mode)
+        {
+            if (seeds.size() != keys.size())
+            {
+                throw logic_error("keys do not have seeds");
+            }
+
+            auto old_except_mask = stream.exceptions();
+            try
+            {
+                // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+                stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+                // Save the format identifier and version
+                stream.write(reinterpret_cast<const char*>(&seeded_keys_magic),
+                    sizeof(uint64_t));
+                stream.write(reinterpret_cast<const char*>(&seeded_keys_version),
+                    sizeof(uint64_t));
+
+                // Save the parms_id and the decomposition bit count
+                stream.write(reinterpret_cast<const char*>(&parms_id),
+                    sizeof(parms_id_type));
+                int32_t decomposition_bit_count32 =
+                    safe_cast<int32_t>(decomposition_bit_count);
+                stream.write(reinterpret_cast<const char*>(&decomposition_bit_count32),
+                    sizeof(int32_t));
+                write_compr_mode(stream, compr_mode);
+
+                uint64_t keys_dim1 = static_cast<uint64_t>(keys.size());
+                stream.write(reinterpret_cast<const char*>(&keys_dim1), sizeof(uint64_t));
+                for (size_t index = 0; index < keys.size(); index++)
+                {
+                    auto &key = keys[index];
+                    if (seeds[index].size() != key.size())
+                    {
+                        throw logic_error("keys do not have seeds");
+                    }
+
+                    uint64_t keys_dim2 = static_cast<uint64_t>(key.size());
+                    stream.write(reinterpret_cast<const char*>(&keys_dim2), sizeof(uint64_t));
+                    for (size_t j = 0; j < key.size(); j++)
+                    {
+                        stream.write(reinterpret_cast<const char*>(seeds[index][j].data()),
+                            sizeof(prng_seed_type));
+
+                        // Save only the even polynomials; the odd ones are expanded
+                        // from the seed
+                        auto &component = key[j];
+                        for (size_t i = 0; i < component.size(); i += 2)
+                        {
+                            save_poly(component.data(i), component.poly_modulus_degree(),
+                                component.coeff_mod_count(), stream, compr_mode);
+                        }
+                    }
+                }
+            }
+            catch (const exception &)
+            {
+                stream.exceptions(old_except_mask);
+                throw;
+            }
+
+            stream.exceptions(old_except_mask);
+        }
+
+        void load_seeded_kswitch_keys(shared_ptr<SEALContext> context,
+            istream &stream, parms_id_type &parms_id, int &decomposition_bit_count,
+            vector<vector<Ciphertext>> &keys, vector<vector<prng_seed_type>> &seeds,
+            MemoryPoolHandle pool)
+        {
+            // Verify parameters
+            if (!context || !context->parameters_set())
+            {
+                throw invalid_argument("seeded keys can only be loaded with a valid context");
+            }
+
+            auto old_except_mask = stream.exceptions();
+            try
+            {
+                // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+                stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+                read_seeded_version(stream);
+
+                // Read the parms_id and the decomposition bit count
+                parms_id_type new_parms_id{};
+                stream.read(reinterpret_cast<char*>(&new_parms_id),
+                    sizeof(parms_id_type));
+                auto context_data_ptr = context->context_data(new_parms_id);
+                if (!context_data_ptr)
+                {
+                    throw invalid_argument("keys are not valid for encryption parameters");
+                }
+                int32_t decomposition_bit_count32 = 0;
+                stream.read(reinterpret_cast<char*>(&decomposition_bit_count32),
+                    sizeof(int32_t));
+                if (decomposition_bit_count32 < SEAL_DBC_MIN ||
+                    decomposition_bit_count32 > SEAL_DBC_MAX)
+                {
+                    throw logic_error("decomposition bit count out of bounds");
+                }
+                auto compr_mode = read_compr_mode(stream);
+
+                // The number of decomposition factors for each RNS component
+                auto &coeff_modulus = context_data_ptr->parms().coeff_modulus();
+                size_t coeff_count = context_data_ptr->parms().poly_modulus_degree();
+                size_t coeff_mod_count = coeff_modulus.size();
+                vector<size_t> factor_counts(coeff_mod_count, 0);
+                for (size_t j = 0; j < coeff_mod_count; j++)
+                {
+                    for (uint64_t q = coeff_modulus[j].value(); q;
+                        q >>= decomposition_bit_count32)
+                    {
+                        factor_counts[j]++;
+                    }
+                }
+
+                uint64_t keys_dim1 = 0;
+                stream.read(reinterpret_cast<char*>(&keys_dim1), sizeof(uint64_t));
+                if (keys_dim1 > coeff_count)
+                {
+                    throw invalid_argument("keys are not valid for encryption parameters");
+                }
+
+                vector<vector<Ciphertext>> new_keys(safe_cast<size_t>(keys_dim1));
+                vector<vector<prng_seed_type>> new_seeds(safe_cast<size_t>(keys_dim1));
+                for (size_t index = 0; index < new_keys.size(); index++)
+                {
+                    uint64_t keys_dim2 = 0;
+                    stream.read(reinterpret_cast<char*>(&keys_dim2), sizeof(uint64_t));
+                    if (keys_dim2 && keys_dim2 != coeff_mod_count)
+                    {
+                        throw invalid_argument("keys are not valid for encryption parameters");
+                    }
+
+                    new_keys[index].reserve(safe_cast<size_t>(keys_dim2));
+                    new_seeds[index].resize(safe_cast<size_t>(keys_dim2));
+                    for (size_t j = 0; j < keys_dim2; j++)
+                    {
+                        stream.read(reinterpret_cast<char*>(new_seeds[index][j].data()),
+                            sizeof(prng_seed_type));
+
+                        // Interleave the saved polynomials with the expanded ones
+                        new_keys[index].emplace_back(context, new_parms_id,
+                            2 * factor_counts[j], pool);
+                        auto &component = new_keys[index].back();
+                        component.resize(2 * factor_counts[j]);
+                        component.is_ntt_form() = true;
+                        for (size_t i = 0; i < component.size(); i += 2)
+                        {
+                            load_poly(stream, compr_mode, coeff_count,
+                                coeff_mod_count, component.data(i), pool);
+                        }
+                        expand_kswitch_seed(new_seeds[index][j], *context, component);
+                    }
+                }
+
+                parms_id = new_parms_id;
+                decomposition_bit_count = safe_cast<int>(decomposition_bit_count32);
+                keys.swap(new_keys);
+                seeds.swap(new_seeds);
+            }
+            catch (const exception &)
+            {
+                stream.exceptions(old_except_mask);
+                throw;
+            }
+
+            stream.exceptions(old_except_mask);
+        }
+
+        void expand_secret_key_seed(const prng_seed_type &seed,
+            const SEALContext &context, Plaintext &destination)
+        {
+            // Extract encryption parameters.
+            auto &context_data = *context.context_data();
+            auto &parms = context_data.parms();
+            auto &coeff_modulus = parms.coeff_modulus();
+            size_t coeff_count = parms.poly_modulus_degree();
+            size_t coeff_mod_count = coeff_modulus.size();
+
+            destination.parms_id() = parms_id_zero;
+            destination.resize(mul_safe(coeff_count, coeff_mod_count));
+            uint64_t *secret_key = destination.data();
+
+            // Each 2-bit chunk maps 0, 1, 2 to 0, 1, -1; the chunk 3 is rejected
+            ChaCha20PRNG random(seed);
+            uint32_t bits = 0;
+            int bits_left = 0;
+            for (size_t i = 0; i < coeff_count; i++)
+            {
+                uint32_t chunk;
+                do
+                {
+                    if (!bits_left)
+                    {
+                        bits = random.generate();
+                        bits_left = 32;
+                    }
+                    chunk = bits & 3;
+                    bits >>= 2;
+                    bits_left -= 2;
+                } while (chunk == 3);
+
+                for (size_t j = 0; j < coeff_mod_count; j++)
+                {
+                    secret_key[i + (j * coeff_count)] = (chunk == 2) ?
+                        coeff_modulus[j].value() - 1 : chunk;
+                }
+            }
+
+            // Transform the secret s into NTT representation.
+            auto &small_ntt_tables = context_data.small_ntt_tables();
+            for (size_t j = 0; j < coeff_mod_count; j++)
+            {
+                ntt_negacyclic_harvey(secret_key + (j * coeff_count),
+                    small_ntt_tables[j]);
+            }
+            destination.parms_id() = parms.parms_id();
+        }
+
+        void expand_public_key_seed(const prng_seed_type &seed,
+            const SEALContext &context, Ciphertext &public_key)
+        {
+            auto context_data_ptr = context.context_data(public_key.parms_id());
+            if (!context_data_ptr || public_key.size() != 2)
+            {
+                throw invalid_argument("public_key is not valid for encryption parameters");
+            }
+
+            ChaCha20PRNG random(seed);
+            sample_poly_uniform(random, context_data_ptr->parms().coeff_modulus(),
+                public_key.poly_modulus_degree(), public_key.coeff_mod_count(),
+                public_key.data(1));
+        }
+
+        void save_seeded_secret_key(const parms_id_type &parms_id,
+            const prng_seed_type &seed, ostream &stream)
+        {
+            auto old_except_mask = stream.exceptions();
+            try
+            {
+                // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+                stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+                stream.write(reinterpret_cast<const char*>(&seeded_keys_magic),
+                    sizeof(uint64_t));
+                stream.write(reinterpret_cast<const char*>(&seeded_keys_version),
+                    sizeof(uint64_t));
+                stream.write(reinterpret_cast<const char*>(&parms_id),
+                    sizeof(parms_id_type));
+                stream.write(reinterpret_cast<const char*>(seed.data()),
+                    sizeof(prng_seed_type));
+            }
+            catch (const exception &)
+            {
+                stream.exceptions(old_except_mask);
+                throw;
+            }
+
+            stream.exceptions(old_except_mask);
+        }
+
+        void load_seeded_secret_key(shared_ptr<SEALContext> context,
+            istream &stream, Plaintext &destination, prng_seed_type &seed)
+        {
+            // Verify parameters
+            if (!context || !context->parameters_set())
+            {
+                throw invalid_argument("seeded keys can only be loaded with a valid context");
+            }
+
+            auto old_except_mask = stream.exceptions();
+            try
+            {
+                // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+                stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+                read_seeded_version(stream);
+                parms_id_type parms_id{};
+                stream.read(reinterpret_cast<char*>(&parms_id), sizeof(parms_id_type));
+                if (parms_id != context->first_parms_id())
+                {
+                    throw invalid_argument("secret key is not valid for encryption parameters");
+                }
+                prng_seed_type new_seed{};
+                stream.read(reinterpret_cast<char*>(new_seed.data()),
+                    sizeof(prng_seed_type));
+
+                expand_secret_key_seed(new_seed, *context, destination);
+                seed = new_seed;
+                new_seed.fill(0);
+            }
+            catch (const exception &)
+            {
+                stream.exceptions(old_except_mask);
+                throw;
+            }
+
+            stream.exceptions(old_except_mask);
+        }
+
+        void save_seeded_public_key(const Ciphertext &public_key,
+            const prng_seed_type &seed, ostream &stream, compr_mode_type compr_mode)
+        {
+            auto old_except_mask = stream.exceptions();
+            try
+            {
+                // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+                stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+                stream.write(reinterpret_cast<const char*>(&seeded_keys_magic),
+                    sizeof(uint64_t));
+                stream.write(reinterpret_cast<const char*>(&seeded_keys_version),
+                    sizeof(uint64_t));
+                stream.write(reinterpret_cast<const char*>(&public_key.parms_id()),
+                    sizeof(parms_id_type));
+                write_compr_mode(stream, compr_mode);
+                stream.write(reinterpret_cast<const char*>(seed.data()),
+                    sizeof(prng_seed_type));
+
+                // Save only the first polynomial; the second one is expanded from
+                // the seed
+                save_poly(public_key.data(0), public_key.poly_modulus_degree(),
+                    public_key.coeff_mod_count(), stream, compr_mode);
+            }
+            catch (const exception &)
+            {
+                stream.exceptions(old_except_mask);
+                throw;
+            }
+
+            stream.exceptions(old_except_mask);
+        }
+
+        void load_seeded_public_key(shared_ptr<SEALContext> context,
+            istream &stream, Ciphertext &public_key, prng_seed_type &seed)
+        {
+            // Verify parameters
+            if (!context || !context->parameters_set())
+            {
+                throw invalid_argument("seeded keys can only be loaded with a valid context");
+            }
+
+            auto old_except_mask = stream.exceptions();
+            try
+            {
+                // Throw exceptions on std::ios_base::badbit and std::ios_base::failbit
+                stream.exceptions(ios_base::badbit | ios_base::failbit);
+
+                read_seeded_version(stream);
+                parms_id_type parms_id{};
+                stream.read(reinterpret_cast<char*>(&parms_id), sizeof(parms_id_type));
+                if (parms_id != context->first_parms_id())
+                {
+                    throw invalid_argument("public key is not valid for encryption parameters");
+                }
+                auto compr_mode = read_compr_mode(stream);
+                prng_seed_type new_seed{};
+                stream.read(reinterpret_cast<char*>(new_seed.data()),
+                    sizeof(prng_seed_type));
+
+                auto &parms = context->context_data()->parms();
+                Ciphertext new_public_key(context, parms_id, 2, public_key.pool());
+                new_public_key.resize(2);
+                new_public_key.is_ntt_form() = true;
+                load_poly(stream, compr_mode, parms.poly_modulus_degree(),
+                    parms.coeff_modulus().size(), new_public_key.data(0),
+                    public_key.pool());
+                expand_public_key_seed(new_seed, *context, new_public_key);
+                public_key = move(new_public_key);
+                seed = new_seed;
+            }
+            catch (const exception &)
+            {
+                stream.exceptions(old_except_mask);
+                throw;
+            }
+
+            stream.exceptions(old_except_mask);
+        }
+    }
+}
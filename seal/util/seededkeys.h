@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "seal/ciphertext.h"
+#include "seal/plaintext.h"
+#include "seal/context.h"
+#include "seal/randomgen.h"
+#include "seal/serialization.h"
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        Identifies keys saved with their seeds in place of the polynomials that
+        are sampled from them. The bytes spell "SEALSEED" when read in
+        little-endian order. Keys saved in the other formats start with a
+        parms_id or with bit_packed_magic or mapped_keys_magic instead.
+        */
+        constexpr std::uint64_t seeded_keys_magic = 0x444545534C414553ULL;
+
+        /**
+        Version of the seeded key format.
+        */
+        constexpr std::uint64_t seeded_keys_version = 1;
+
+        /*
+        The key switching keys in RelinKeys and GaloisKeys store one Ciphertext
+        for each RNS component of the key. Its polynomials are the pairs
+        (-(a_i*s + e_i) + w^i * new_key, a_i) for the decomposition factors w^i,
+        all in NTT form. The uniform polynomials a_i are sampled directly in NTT
+        form from a ChaCha20PRNG with a seed that is specific to the Ciphertext,
+        so that only the seed needs to be stored or sent.
+        */
+
+        /**
+        Samples the uniform polynomials a_i of a key switching key component from
+        its seed and stores them in the odd polynomials of component. The
+        component must already have its final size and parms_id.
+        */
+        void expand_kswitch_seed(const prng_seed_type &seed,
+            const SEALContext &context, Ciphertext &component);
+
+        /**
+        Saves key switching keys in the seeded format. Every non-empty key must
+        have a seed for each of its components. Only the even polynomials of the
+        components are saved, in the given compression mode.
+        */
+        void save_seeded_kswitch_keys(const parms_id_type &parms_id,
+            int decomposition_bit_count,
+            const std::vector<std::vector<Ciphertext>> &keys,
+            const std::vector<std::vector<prng_seed_type>> &seeds,
+            std::ostream &stream, compr_mode_type compr_mode);
+
+        /**
+        Loads key switching keys saved by save_seeded_kswitch_keys from a stream
+        positioned after the format identifier, and expands the uniform
+        polynomials from their seeds. The metadata of the keys is verified
+        against the context, since the seeds cannot be expanded otherwise.
+        */
+        void load_seeded_kswitch_keys(std::shared_ptr<SEALContext> context,
+            std::istream &stream, parms_id_type &parms_id,
+            int &decomposition_bit_count,
+            std::vector<std::vector<Ciphertext>> &keys,
+            std::vector<std::vector<prng_seed_type>> &seeds,
+            MemoryPoolHandle pool);
+
+        /*
+        A secret key can be derived from a 256-bit seed. Its coefficients are
+        sampled uniformly from {-1, 0, 1} using the first stream of a
+        ChaCha20PRNG with that seed, two bits at a time, so the same seed gives
+        the same key on every platform. The uniform polynomial a of a public
+        key is sampled in NTT form from its own seed, which is public.
+        */
+
+        /**
+        Samples the secret key for the first level of the context from its seed,
+        and stores it in NTT form in destination.
+        */
+        void expand_secret_key_seed(const prng_seed_type &seed,
+            const SEALContext &context, Plaintext &destination);
+
+        /**
+        Samples the uniform polynomial a of a public key from its seed and stores
+        it in the second polynomial of public_key, which must already have size 2
+        and its final parms_id.
+        */
+        void expand_public_key_seed(const prng_seed_type &seed,
+            const SEALContext &context, Ciphertext &public_key);
+
+        /**
+        Saves the seed of a secret key and its parms_id in the seeded format.
+        */
+        void save_seeded_secret_key(const parms_id_type &parms_id,
+            const prng_seed_type &seed, std::ostream &stream);
+
+        /**
+        Loads a secret key saved by save_seeded_secret_key from a stream
+        positioned after the format identifier, and expands it from its seed.
+        */
+        void load_seeded_secret_key(std::shared_ptr<SEALContext> context,
+            std::istream &stream, Plaintext &destination, prng_seed_type &seed);
+
+        /**
+        Saves a public key in the seeded format: its parms_id and the seed of its
+        uniform polynomial, followed by its first polynomial in the given
+        compression mode.
+        */
+        void save_seeded_public_key(const Ciphertext &public_key,
+            const prng_seed_type &seed, std::ostream &stream,
+            compr_mode_type compr_mode);
+
+        /**
+        Loads a public key saved by save_seeded_public_key from a stream
+        positioned after the format identifier, and expands its uniform
+        polynomial from its seed.
+        */
+        void load_seeded_public_key(std::shared_ptr<SEALContext> context,
+            std::istream &stream, Ciphertext &public_key, prng_seed_type &seed);
+    }
+}
@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <cstddef>
+#include <streambuf>
+#include <stdexcept>
+
+namespace seal
+{
+    namespace util
+    {
+        /**
+        A stream buffer writing directly into a fixed-size, caller-owned array. 
+        Writing past the end of the array fails the stream instead of allocating.
+        */
+        class ArrayPutBuffer : public std::streambuf
+        {
+        public:
+            ArrayPutBuffer(void *array, std::size_t size)
+            {
+                if (!array && size)
+                {
+                    throw std::invalid_argument("array cannot be null");
+                }
+                char *begin = static_cast<char*>(array);
+                setp(begin, begin + size);
+            }
+
+            /**
+            Returns the number of bytes written so far.
+            */
+            inline std::size_t size() const noexcept
+            {
+                return static_cast<std::size_t>(pptr() - pbase());
+            }
+
+        private:
+            ArrayPutBuffer(const ArrayPutBuffer &copy) = delete;
+
+            ArrayPutBuffer &operator =(const ArrayPutBuffer &assign) = delete;
+        };
+
+        /**
+        A stream buffer reading directly from a fixed-size, caller-owned array.
+        Reading past the end of the array fails the stream.
+        */
+        class ArrayGetBuffer : public std::streambuf
+        {
+        public:
+            ArrayGetBuffer(const void *array, std::size_t size)
+            {
+                if (!array && size)
+                {
+                    throw std::invalid_argument("array cannot be null");
+                }
+
+                // The get area is never written to through std::streambuf
+                char *begin = const_cast<char*>(static_cast<const char*>(array));
+                setg(begin, begin, begin + size);
+            }
+
+            /**
+            Returns the number of bytes read so far.
+            */
+            inline std::size_t size() const noexcept
+            {
+                return static_cast<std::size_t>(gptr() - eback());
+            }
+
+        private:
+            ArrayGetBuffer(const ArrayGetBuffer &copy) = delete;
+
+            ArrayGetBuffer &operator =(const ArrayGetBuffer &assign) = delete;
+        };
+    }
+}
@@ -5,6 +5,7 @@
 
 #include <cstdint>
 #include <type_traits>
+#include <limits>
 #include "seal/smallmodulus.h"
 #include "seal/util/defines.h"
 #include "seal/util/pointer.h"
@@ -186,6 +187,31 @@ namespace seal
                     -static_cast<std::int64_t>(tmp3 >= modulus.value())));
         }
 
+        /**
+        Returns how many products of a lazily reduced value (less than 4 * modulus, as
+        output by the lazy NTT) and a reduced value (less than modulus) can be added to
+        a 128-bit accumulator holding a reduced value without overflow. Accumulating
+        key switching inner products needs one Barrett reduction per this many summands.
+        */
+        inline std::uint64_t lazy_reduction_summand_bound(const SmallModulus &modulus)
+        {
+#ifdef SEAL_DEBUG
+            if (modulus.is_zero())
+            {
+                throw std::invalid_argument("modulus");
+            }
+#endif
+            // Each product has at most 2 * bit_count + 2 bits. Adding 2^(128 - that) - 1
+            // of them to a value less than modulus stays below 2^128.
+            int product_bit_count = 2 * modulus.bit_count() + 2;
+            int free_bit_count = 128 - product_bit_count;
+            if (free_bit_count >= 64)
+            {
+                return std::numeric_limits<std::uint64_t>::max();
+            }
+            return (std::uint64_t(1) << free_bit_count) - 1;
+        }
+
         inline std::uint64_t multiply_uint_uint_mod(std::uint64_t operand1, 
             std::uint64_t operand2, const SmallModulus &modulus)
         {
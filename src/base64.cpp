@@ -27,96 +27,323 @@
 
    René Nyffenegger rene.nyffenegger@adp-gmbh.ch
 
+   Altered: the byte-at-a-time loops were replaced by table-driven scalar code
+   working on whole 3-byte/4-char groups, encoding and decoding into
+   preallocated buffers, and SSE4.1/AVX2 paths selected at runtime (after
+   Wojciech Mula's and Daniel Lemire's vectorized base64 algorithms).
+
 */
 
 #include "base64.h"
-#include <iostream>
 
-static const std::string base64_chars = 
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BASE64_USE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+static const char base64_chars[] =
              "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
              "abcdefghijklmnopqrstuvwxyz"
              "0123456789+/";
 
+// Maps a character to its 6-bit value, or to 0xFF if it is not a base64 digit
+struct base64_decode_table {
+  unsigned char values[256];
+
+  base64_decode_table() {
+    for (int c = 0; c < 256; c++)
+      values[c] = 0xFF;
+    for (int i = 0; i < 64; i++)
+      values[static_cast<unsigned char>(base64_chars[i])] = static_cast<unsigned char>(i);
+  }
+};
+
+static const base64_decode_table base64_values;
+
+/******************************************************************************/
+// Scalar code; also handles whatever the vector loops leave over
 
-static inline bool is_base64(unsigned char c) {
-  return (isalnum(c) || (c == '+') || (c == '/'));
+static void encode_scalar(unsigned char const* in, std::size_t in_len, char* out) {
+  for (; in_len >= 3; in_len -= 3, in += 3, out += 4) {
+    unsigned int group = (in[0] << 16) | (in[1] << 8) | in[2];
+    out[0] = base64_chars[(group >> 18) & 0x3f];
+    out[1] = base64_chars[(group >> 12) & 0x3f];
+    out[2] = base64_chars[(group >> 6) & 0x3f];
+    out[3] = base64_chars[group & 0x3f];
+  }
+
+  if (in_len) {
+    unsigned int group = (in[0] << 16) | ((in_len == 2) ? (in[1] << 8) : 0);
+    out[0] = base64_chars[(group >> 18) & 0x3f];
+    out[1] = base64_chars[(group >> 12) & 0x3f];
+    out[2] = (in_len == 2) ? base64_chars[(group >> 6) & 0x3f] : '=';
+    out[3] = '=';
+  }
 }
 
-std::string base64_encode(unsigned char const* bytes_to_encode, unsigned int in_len) {
-  std::string ret;
-  int i = 0;
-  int j = 0;
-  unsigned char char_array_3[3];
-  unsigned char char_array_4[4];
-
-  while (in_len--) {
-    char_array_3[i++] = *(bytes_to_encode++);
-    if (i == 3) {
-      char_array_4[0] = (char_array_3[0] & 0xfc) >> 2;
-      char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-      char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
-      char_array_4[3] = char_array_3[2] & 0x3f;
-
-      for(i = 0; (i <4) ; i++)
-        ret += base64_chars[char_array_4[i]];
-      i = 0;
+// Returns the number of bytes written; stops at the first non-base64 character
+static std::size_t decode_scalar(char const* in, std::size_t in_len, unsigned char* out) {
+  unsigned char* out_begin = out;
+  const unsigned char* table = base64_values.values;
+
+  for (; in_len >= 4; in_len -= 4, in += 4, out += 3) {
+    unsigned int a = table[static_cast<unsigned char>(in[0])];
+    unsigned int b = table[static_cast<unsigned char>(in[1])];
+    unsigned int c = table[static_cast<unsigned char>(in[2])];
+    unsigned int d = table[static_cast<unsigned char>(in[3])];
+    if ((a | b | c | d) & 0x80) {
+      // Finish with the partial group below
+      break;
     }
+    unsigned int group = (a << 18) | (b << 12) | (c << 6) | d;
+    out[0] = static_cast<unsigned char>(group >> 16);
+    out[1] = static_cast<unsigned char>(group >> 8);
+    out[2] = static_cast<unsigned char>(group);
+  }
+
+  // At most 3 valid characters remain before the end or an invalid character
+  unsigned int group = 0;
+  std::size_t count = 0;
+  for (; count < in_len && count < 4; count++) {
+    unsigned int value = table[static_cast<unsigned char>(in[count])];
+    if (value & 0x80)
+      break;
+    group |= value << (18 - 6 * count);
   }
+  for (std::size_t j = 0; j + 1 < count; j++)
+    *out++ = static_cast<unsigned char>(group >> (16 - 8 * j));
 
-  if (i)
-  {
-    for(j = i; j < 3; j++)
-      char_array_3[j] = '\0';
+  return static_cast<std::size_t>(out - out_begin);
+}
 
-    char_array_4[0] = ( char_array_3[0] & 0xfc) >> 2;
-    char_array_4[1] = ((char_array_3[0] & 0x03) << 4) + ((char_array_3[1] & 0xf0) >> 4);
-    char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
+/******************************************************************************/
+// Vector code (x86 only); each loop returns how far it got
+
+#ifdef BASE64_USE_X86_SIMD
+
+// Maps 6-bit values in each byte to ASCII
+__attribute__((target("sse4.1")))
+static inline __m128i encode_lookup_sse(__m128i indices) {
+  const __m128i shift_lut = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+      '/' - 63, 'A', 0, 0);
+  __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  reduced = _mm_or_si128(reduced, _mm_and_si128(less, _mm_set1_epi8(13)));
+  return _mm_add_epi8(_mm_shuffle_epi8(shift_lut, reduced), indices);
+}
 
-    for (j = 0; (j < i + 1); j++)
-      ret += base64_chars[char_array_4[j]];
+// Splits 12 bytes (spread by a shuffle over 16) into 16 6-bit values
+__attribute__((target("sse4.1")))
+static inline __m128i encode_split_sse(__m128i in) {
+  in = _mm_shuffle_epi8(in, _mm_set_epi8(
+      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  return _mm_or_si128(t1, t3);
+}
 
-    while((i++ < 3))
-      ret += '=';
+__attribute__((target("sse4.1")))
+static std::size_t encode_sse(unsigned char const* in, std::size_t in_len, char* out) {
+  std::size_t done = 0;
 
+  // Each step reads 16 bytes and consumes 12
+  for (; in_len - done >= 16; done += 12, out += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), encode_lookup_sse(encode_split_sse(block)));
   }
+  return done;
+}
 
-  return ret;
+__attribute__((target("avx2")))
+static std::size_t encode_avx2(unsigned char const* in, std::size_t in_len, char* out) {
+  const __m256i shift_lut = _mm256_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+      '/' - 63, 'A', 0, 0,
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+      '/' - 63, 'A', 0, 0);
+  const __m256i spread = _mm256_set_epi8(
+      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+  std::size_t done = 0;
+
+  // Each step reads 28 bytes (two overlapping lanes of 16) and consumes 24
+  for (; in_len - done >= 28; done += 24, out += 32) {
+    __m256i in_block = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done + 12)), 1);
+    in_block = _mm256_shuffle_epi8(in_block, spread);
+    __m256i t0 = _mm256_and_si256(in_block, _mm256_set1_epi32(0x0fc0fc00));
+    __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    __m256i t2 = _mm256_and_si256(in_block, _mm256_set1_epi32(0x003f03f0));
+    __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    __m256i indices = _mm256_or_si256(t1, t3);
+
+    __m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    reduced = _mm256_or_si256(reduced, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    __m256i chars = _mm256_add_epi8(_mm256_shuffle_epi8(shift_lut, reduced), indices);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), chars);
+  }
+  return done;
+}
 
+// Translates 16 characters to 6-bit values; returns false if any is invalid
+__attribute__((target("sse4.1")))
+static inline bool decode_lookup_sse(__m128i& block) {
+  const __m128i lut_lo = _mm_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m128i lut_hi = _mm_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m128i lut_roll = _mm_setr_epi8(
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i mask_0f = _mm_set1_epi8(0x0f);
+
+  __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(block, 4), mask_0f);
+  __m128i lo_nibbles = _mm_and_si128(block, mask_0f);
+  __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+  __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+  if (!_mm_testz_si128(lo, hi))
+    return false;
+
+  __m128i eq_2f = _mm_cmpeq_epi8(block, _mm_set1_epi8(0x2f));
+  __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles));
+  block = _mm_add_epi8(block, roll);
+  return true;
 }
 
-std::string base64_decode(std::string const& encoded_string) {
-  int in_len = encoded_string.size();
-  int i = 0;
-  int j = 0;
-  int in_ = 0;
-  unsigned char char_array_4[4], char_array_3[3];
-  std::string ret;
-
-  while (in_len-- && ( encoded_string[in_] != '=') && is_base64(encoded_string[in_])) {
-    char_array_4[i++] = encoded_string[in_]; in_++;
-    if (i ==4) {
-      for (i = 0; i <4; i++)
-        char_array_4[i] = base64_chars.find(char_array_4[i]);
-
-      char_array_3[0] = ( char_array_4[0] << 2       ) + ((char_array_4[1] & 0x30) >> 4);
-      char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
-      char_array_3[2] = ((char_array_4[2] & 0x3) << 6) +   char_array_4[3];
-
-      for (i = 0; (i < 3); i++)
-        ret += char_array_3[i];
-      i = 0;
-    }
+// Packs 16 6-bit values into 12 bytes at the bottom of the register
+__attribute__((target("sse4.1")))
+static inline __m128i decode_pack_sse(__m128i values) {
+  __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(merged, _mm_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+__attribute__((target("sse4.1")))
+static std::size_t decode_sse(char const* in, std::size_t in_len, unsigned char* out) {
+  std::size_t done = 0;
+
+  // Each step consumes 16 characters and writes 16 bytes, 12 of them valid;
+  // 24 characters left guarantee the extra 4 bytes fit in the output
+  for (; in_len - done >= 24; done += 16, out += 12) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+    if (!decode_lookup_sse(block))
+      break;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), decode_pack_sse(block));
   }
+  return done;
+}
 
-  if (i) {
-    for (j = 0; j < i; j++)
-      char_array_4[j] = base64_chars.find(char_array_4[j]);
+__attribute__((target("avx2")))
+static std::size_t decode_avx2(char const* in, std::size_t in_len, unsigned char* out) {
+  const __m256i lut_lo = _mm256_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m256i lut_hi = _mm256_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m256i lut_roll = _mm256_setr_epi8(
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+      0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i mask_0f = _mm256_set1_epi8(0x0f);
+  const __m256i pack_shuffle = _mm256_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  std::size_t done = 0;
+
+  // Each step consumes 32 characters and writes 32 bytes, 24 of them valid;
+  // 44 characters left guarantee the extra 8 bytes fit in the output
+  for (; in_len - done >= 44; done += 32, out += 24) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done));
+    __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(block, 4), mask_0f);
+    __m256i lo_nibbles = _mm256_and_si256(block, mask_0f);
+    __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+    __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+    if (!_mm256_testz_si256(lo, hi))
+      break;
+
+    __m256i eq_2f = _mm256_cmpeq_epi8(block, _mm256_set1_epi8(0x2f));
+    __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles));
+    block = _mm256_add_epi8(block, roll);
+
+    __m256i merged = _mm256_maddubs_epi16(block, _mm256_set1_epi32(0x01400140));
+    merged = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+    merged = _mm256_shuffle_epi8(merged, pack_shuffle);
+    merged = _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), merged);
+  }
+  return done;
+}
 
-    char_array_3[0] = (char_array_4[0] << 2) + ((char_array_4[1] & 0x30) >> 4);
-    char_array_3[1] = ((char_array_4[1] & 0xf) << 4) + ((char_array_4[2] & 0x3c) >> 2);
+enum class simd_level { none, sse41, avx2 };
 
-    for (j = 0; (j < i - 1); j++) ret += char_array_3[j];
-  }
+static simd_level detect_simd_level() {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return simd_level::avx2;
+  if (__builtin_cpu_supports("sse4.1"))
+    return simd_level::sse41;
+  return simd_level::none;
+}
+
+static const simd_level base64_simd_level = detect_simd_level();
+
+#endif
+
+/******************************************************************************/
+
+std::size_t base64_encoded_length(std::size_t len) {
+  return ((len + 2) / 3) * 4;
+}
 
+std::size_t base64_decoded_length(std::size_t len) {
+  return ((len + 3) / 4) * 3;
+}
+
+void base64_encode(unsigned char const* bytes_to_encode, std::size_t in_len, char* out) {
+  std::size_t done = 0;
+#ifdef BASE64_USE_X86_SIMD
+  if (base64_simd_level == simd_level::avx2)
+    done = encode_avx2(bytes_to_encode, in_len, out);
+  if (base64_simd_level != simd_level::none)
+    done += encode_sse(bytes_to_encode + done, in_len - done, out + (done / 3) * 4);
+#endif
+  encode_scalar(bytes_to_encode + done, in_len - done, out + (done / 3) * 4);
+}
+
+std::size_t base64_decode(char const* encoded, std::size_t in_len, unsigned char* out) {
+  std::size_t done = 0;
+#ifdef BASE64_USE_X86_SIMD
+  if (base64_simd_level == simd_level::avx2)
+    done = decode_avx2(encoded, in_len, out);
+  if (base64_simd_level != simd_level::none)
+    done += decode_sse(encoded + done, in_len - done, out + (done / 4) * 3);
+#endif
+  return (done / 4) * 3 + decode_scalar(encoded + done, in_len - done, out + (done / 4) * 3);
+}
+
+std::string base64_encode(unsigned char const* bytes_to_encode, unsigned int in_len) {
+  std::string ret(base64_encoded_length(in_len), '\0');
+  base64_encode(bytes_to_encode, in_len, &ret[0]);
+  return ret;
+}
+
+std::string base64_decode(std::string const& encoded_string) {
+  std::string ret(base64_decoded_length(encoded_string.size()), '\0');
+  ret.resize(base64_decode(encoded_string.data(), encoded_string.size(),
+      reinterpret_cast<unsigned char*>(&ret[0])));
   return ret;
 }
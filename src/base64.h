@@ -2,13 +2,31 @@
 //  base64 encoding and decoding with C++.
 //  Version: 1.01.00
 //
+//  Altered: adds length queries, encoding/decoding into preallocated buffers,
+//  and SSE4.1/AVX2 code paths selected at runtime.
+//
 
 #ifndef BASE64_H_C0CE2A47_D10E_42C9_A27C_C883944E704A
 #define BASE64_H_C0CE2A47_D10E_42C9_A27C_C883944E704A
 
+#include <cstddef>
 #include <string>
 
 std::string base64_encode(unsigned char const* , unsigned int len);
 std::string base64_decode(std::string const& s);
 
+// Number of characters base64_encode produces for len bytes (with padding)
+std::size_t base64_encoded_length(std::size_t len);
+
+// Upper bound on the number of bytes base64_decode produces for len characters
+std::size_t base64_decoded_length(std::size_t len);
+
+// Encodes len bytes into out, which must hold base64_encoded_length(len) chars
+void base64_encode(unsigned char const* bytes_to_encode, std::size_t in_len, char* out);
+
+// Decodes into out, which must hold base64_decoded_length(in_len) bytes. Like
+// the std::string version, decoding stops at the first '=' or invalid character.
+// Returns the number of bytes written.
+std::size_t base64_decode(char const* encoded, std::size_t in_len, unsigned char* out);
+
 #endif /* BASE64_H_C0CE2A47_D10E_42C9_A27C_C883944E704A */
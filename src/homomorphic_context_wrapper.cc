@@ -1,6 +1,7 @@
 #include "homomorphic_context_wrapper.h"
 #include "wrapper_globals.h"
 #include <set>
+#include <cstdlib>
 
 NAMESPACE_SEAL_WRAPPER_BEGIN
 
@@ -41,7 +42,9 @@ Napi::Object HomomorphicContextWrapper::Init(Napi::Env env, Napi::Object exports
 		InstanceMethod("add", &HomomorphicContextWrapper::add),
 		InstanceMethod("sub", &HomomorphicContextWrapper::sub),
 		InstanceMethod("multiply", &HomomorphicContextWrapper::multiply),
-		InstanceMethod("square", &HomomorphicContextWrapper::square)
+		InstanceMethod("square", &HomomorphicContextWrapper::square),
+		InstanceMethod("addPlain", &HomomorphicContextWrapper::addPlain),
+		InstanceMethod("multiplyPlain", &HomomorphicContextWrapper::multiplyPlain)
 	});
 
 	constructor = Napi::Persistent(func);
@@ -99,8 +102,8 @@ HomomorphicContextWrapper::HomomorphicContextWrapper(const Napi::CallbackInfo &i
 				// { Napi::TypeError::New(env, "String expected").ThrowAsJavaScriptException(); return; } //MUST RETURN!!!
 				throw Napi::TypeError::New(env, "String expected");
 
-			std::istringstream iss(std::move(Convert(info[0].As<Napi::String>())));
-			m_EncryptionParameters = std::make_shared<seal::EncryptionParameters>(seal::EncryptionParameters::Load(iss));
+			const auto bytes = ConvertToBytes(info[0].As<Napi::String>());
+			m_EncryptionParameters = std::make_shared<seal::EncryptionParameters>(seal::EncryptionParameters::Load(bytes.data(), bytes.size()));
 		}
 		break;
 
@@ -163,9 +166,9 @@ Napi::Value HomomorphicContextWrapper::getEncryptionParameters(const Napi::Callb
 		if (!m_EncryptionParameters) //TODO: validator
 			throw Napi::Error::New(env, "No EncryptionParameters have been set yet");
 
-		std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
-		seal::EncryptionParameters::Save(*m_EncryptionParameters, oss);
-		return Convert(env, oss);
+		std::vector<unsigned char> bytes(seal::EncryptionParameters::SaveSize(*m_EncryptionParameters));
+		seal::EncryptionParameters::Save(*m_EncryptionParameters, bytes.data(), bytes.size());
+		return Convert(env, bytes);
 	}
 	SEAL_WRAPPER_CATCH_ALL_THEN_RETURN(env.Undefined());
 }
@@ -185,9 +188,7 @@ Napi::Value HomomorphicContextWrapper::getPublicKey(const Napi::CallbackInfo &in
 		if (!m_PublicKey) //TODO: validator
 			throw Napi::Error::New(env, "No public key has been set yet");
 
-		std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
-		m_PublicKey->save(oss);
-		return Convert(env, oss);
+		return Convert(env, *m_PublicKey, seal::compr_mode_type::bit_packed);
 	}
 	SEAL_WRAPPER_CATCH_ALL_THEN_RETURN(env.Undefined());
 }
@@ -204,8 +205,7 @@ Napi::Value HomomorphicContextWrapper::setPublicKey(const Napi::CallbackInfo &in
 		if (info.Length() != 1 || !info[0].IsString())
 			throw Napi::TypeError::New(env, "String expected");
 
-		std::istringstream iss(std::move(Convert(info[0].As<Napi::String>())));
-		m_PublicKey->load(*m_SEALContextPtr, iss);
+		Convert(info[0].As<Napi::String>(), *m_SEALContextPtr, *m_PublicKey);
 	}
 	SEAL_WRAPPER_CATCH_ALL_THEN_RETURN(env.Undefined());
 }
@@ -225,9 +225,7 @@ Napi::Value HomomorphicContextWrapper::getSecretKey(const Napi::CallbackInfo &in
 		if (!m_SecretKey) //TODO: validator
 			throw Napi::Error::New(env, "No secret key has been set yet");
 
-		std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
-		m_SecretKey->save(oss);
-		return Convert(env, oss);
+		return Convert(env, *m_SecretKey, seal::compr_mode_type::bit_packed);
 	}
 	SEAL_WRAPPER_CATCH_ALL_THEN_RETURN(env.Undefined());
 }
@@ -244,8 +242,7 @@ Napi::Value HomomorphicContextWrapper::setSecretKey(const Napi::CallbackInfo &in
 		if (info.Length() != 1 || !info[0].IsString())
 			throw Napi::TypeError::New(env, "String expected");
 
-		std::istringstream iss(std::move(Convert(info[0].As<Napi::String>())));
-		m_SecretKey->load(*m_SEALContextPtr, iss);
+		Convert(info[0].As<Napi::String>(), *m_SEALContextPtr, *m_SecretKey);
 	}
 	SEAL_WRAPPER_CATCH_ALL_THEN_RETURN(env.Undefined());
 }
@@ -270,9 +267,7 @@ Napi::Value HomomorphicContextWrapper::encrypt(const Napi::CallbackInfo &info)
 		seal::Encryptor encryptor(*m_SEALContextPtr, *m_PublicKey);
 		encryptor.encrypt(plaintext, ciphertext); // ==> ciphertext
 
-		std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
-		ciphertext.save(oss);
-		return Convert(env, oss);
+		return Convert(env, ciphertext, seal::compr_mode_type::bit_packed);
 	}
 	SEAL_WRAPPER_CATCH_ALL_THEN_RETURN(env.Undefined());
 }
@@ -290,8 +285,7 @@ Napi::Value HomomorphicContextWrapper::decrypt(const Napi::CallbackInfo &info)
 			throw Napi::TypeError::New(env, "String expected");
 
 		seal::Ciphertext ciphertext;
-		std::istringstream iss(std::move(Convert(info[0].As<Napi::String>())));
-		ciphertext.load(*m_SEALContextPtr, iss); //unsafe_load()
+		Convert(info[0].As<Napi::String>(), *m_SEALContextPtr, ciphertext);
 
 		seal::Plaintext plaintext;
 		seal::Decryptor decryptor(*m_SEALContextPtr, *m_SecretKey);
@@ -317,15 +311,12 @@ Napi::Value HomomorphicContextWrapper::negate(const Napi::CallbackInfo &info)
 			throw Napi::TypeError::New(env, "String expected - 1 parameter");
 
 		seal::Ciphertext ciphertext1, ciphertextResult;
-		std::istringstream iss1(std::move(Convert(info[0].As<Napi::String>())));
-		ciphertext1.load(*m_SEALContextPtr, iss1);
+		Convert(info[0].As<Napi::String>(), *m_SEALContextPtr, ciphertext1);
 
 		seal::Evaluator evaluator(*m_SEALContextPtr);
 		evaluator.negate(ciphertext1, ciphertextResult);
 
-		std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
-		ciphertextResult.save(oss);
-		return Convert(env, oss);
+		return Convert(env, ciphertextResult, seal::compr_mode_type::bit_packed);
 	}
 	SEAL_WRAPPER_CATCH_ALL_THEN_RETURN(env.Undefined());
 }
@@ -345,17 +336,13 @@ Napi::Value HomomorphicContextWrapper::add(const Napi::CallbackInfo &info)
 			throw Napi::TypeError::New(env, "String expected - 2 parameters");
 
 		seal::Ciphertext ciphertext1, ciphertext2, ciphertextResult;
-		std::istringstream iss1(std::move(Convert(info[0].As<Napi::String>())));
-		std::istringstream iss2(std::move(Convert(info[1].As<Napi::String>())));
-		ciphertext1.load(*m_SEALContextPtr, iss1);
-		ciphertext2.load(*m_SEALContextPtr, iss2);
+		Convert(info[0].As<Napi::String>(), *m_SEALContextPtr, ciphertext1);
+		Convert(info[1].As<Napi::String>(), *m_SEALContextPtr, ciphertext2);
 
 		seal::Evaluator evaluator(*m_SEALContextPtr);
 		evaluator.add(ciphertext1, ciphertext2, ciphertextResult);
 
-		std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
-		ciphertextResult.save(oss);
-		return Convert(env, oss);
+		return Convert(env, ciphertextResult, seal::compr_mode_type::bit_packed);
 	}
 	SEAL_WRAPPER_CATCH_ALL_THEN_RETURN(env.Undefined());
 }
@@ -375,17 +362,13 @@ Napi::Value HomomorphicContextWrapper::sub(const Napi::CallbackInfo &info)
 			throw Napi::TypeError::New(env, "String expected - 2 parameters");
 
 		seal::Ciphertext ciphertext1, ciphertext2, ciphertextResult;
-		std::istringstream iss1(std::move(Convert(info[0].As<Napi::String>())));
-		std::istringstream iss2(std::move(Convert(info[1].As<Napi::String>())));
-		ciphertext1.load(*m_SEALContextPtr, iss1);
-		ciphertext2.load(*m_SEALContextPtr, iss2);
+		Convert(info[0].As<Napi::String>(), *m_SEALContextPtr, ciphertext1);
+		Convert(info[1].As<Napi::String>(), *m_SEALContextPtr, ciphertext2);
 
 		seal::Evaluator evaluator(*m_SEALContextPtr);
 		evaluator.sub(ciphertext1, ciphertext2, ciphertextResult);
 
-		std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
-		ciphertextResult.save(oss);
-		return Convert(env, oss);
+		return Convert(env, ciphertextResult, seal::compr_mode_type::bit_packed);
 	}
 	SEAL_WRAPPER_CATCH_ALL_THEN_RETURN(env.Undefined());
 }
@@ -405,17 +388,13 @@ Napi::Value HomomorphicContextWrapper::multiply(const Napi::CallbackInfo &info)
 			throw Napi::TypeError::New(env, "String expected - 2 parameters");
 
 		seal::Ciphertext ciphertext1, ciphertext2, ciphertextResult;
-		std::istringstream iss1(std::move(Convert(info[0].As<Napi::String>())));
-		std::istringstream iss2(std::move(Convert(info[1].As<Napi::String>())));
-		ciphertext1.load(*m_SEALContextPtr, iss1);
-		ciphertext2.load(*m_SEALContextPtr, iss2);
+		Convert(info[0].As<Napi::String>(), *m_SEALContextPtr, ciphertext1);
+		Convert(info[1].As<Napi::String>(), *m_SEALContextPtr, ciphertext2);
 
 		seal::Evaluator evaluator(*m_SEALContextPtr);
 		evaluator.multiply(ciphertext1, ciphertext2, ciphertextResult);
 
-		std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
-		ciphertextResult.save(oss);
-		return Convert(env, oss);
+		return Convert(env, ciphertextResult, seal::compr_mode_type::bit_packed);
 	}
 	SEAL_WRAPPER_CATCH_ALL_THEN_RETURN(env.Undefined());
 }
@@ -434,15 +413,98 @@ Napi::Value HomomorphicContextWrapper::square(const Napi::CallbackInfo &info)
 			throw Napi::TypeError::New(env, "String expected - 1 parameter");
 
 		seal::Ciphertext ciphertext1, ciphertextResult;
-		std::istringstream iss1(std::move(Convert(info[0].As<Napi::String>())));
-		ciphertext1.load(*m_SEALContextPtr, iss1);
+		Convert(info[0].As<Napi::String>(), *m_SEALContextPtr, ciphertext1);
 
 		seal::Evaluator evaluator(*m_SEALContextPtr);
 		evaluator.square(ciphertext1, ciphertextResult);
 
-		std::ostringstream oss(std::ios_base::out | std::ios_base::binary);
-		ciphertextResult.save(oss);
-		return Convert(env, oss);
+		return Convert(env, ciphertextResult, seal::compr_mode_type::bit_packed);
+	}
+	SEAL_WRAPPER_CATCH_ALL_THEN_RETURN(env.Undefined());
+}
+
+/*******************************************************************************
+ * HomomorphicContextWrapper::addPlain
+ * info[0]: Ciphertext (op #1)
+ * info[1]: Number (op #2; constant)
+ * Returns: Ciphertext (result)
+ * Hints:
+ *		the constant is added to the constant coefficient only (Evaluator::add_scalar),
+ *		instead of encoding it and adding a full plaintext polynomial
+ *******************************************************************************/
+Napi::Value HomomorphicContextWrapper::addPlain(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	SEAL_WRAPPER_TRY
+	{
+		if (info.Length() != 2 || !info[0].IsString() || !info[1].IsNumber())
+			throw Napi::TypeError::New(env, "(String, Number) expected - 2 parameters");
+
+		seal::Ciphertext ciphertext1, ciphertextResult;
+		Convert(info[0].As<Napi::String>(), *m_SEALContextPtr, ciphertext1);
+		const int64_t inputValue = info[1].As<Napi::Number>().Int32Value();
+
+		seal::Evaluator evaluator(*m_SEALContextPtr);
+		const auto plain_modulus = static_cast<int64_t>(m_EncryptionParameters->plain_modulus().value());
+		if (2 * std::abs(inputValue) < plain_modulus) //fits in a single coefficient
+		{
+			const auto scalar = inputValue < 0 ? plain_modulus + inputValue : inputValue;
+			evaluator.add_scalar(ciphertext1, static_cast<uint64_t>(scalar), ciphertextResult);
+		}
+		else
+		{
+			evaluator.add_plain(ciphertext1, m_IntegerEncoder->encode(static_cast<int32_t>(inputValue)), ciphertextResult);
+		}
+
+		return Convert(env, ciphertextResult, seal::compr_mode_type::bit_packed);
+	}
+	SEAL_WRAPPER_CATCH_ALL_THEN_RETURN(env.Undefined());
+}
+
+/*******************************************************************************
+ * HomomorphicContextWrapper::multiplyPlain
+ * info[0]: Ciphertext (op #1)
+ * info[1]: Number (op #2; constant)
+ * Returns: Ciphertext (result)
+ * Hints:
+ *		+/-2^k is a negacyclic shift by k (Evaluator::multiply_monomial; the encoded
+ *		digits do not grow); other constants scale every coefficient
+ *		(Evaluator::multiply_scalar); neither needs an NTT of the operand
+ *******************************************************************************/
+Napi::Value HomomorphicContextWrapper::multiplyPlain(const Napi::CallbackInfo &info)
+{
+	Napi::Env env = info.Env();
+	SEAL_WRAPPER_TRY
+	{
+		if (info.Length() != 2 || !info[0].IsString() || !info[1].IsNumber())
+			throw Napi::TypeError::New(env, "(String, Number) expected - 2 parameters");
+
+		seal::Ciphertext ciphertext1, ciphertextResult;
+		Convert(info[0].As<Napi::String>(), *m_SEALContextPtr, ciphertext1);
+		const int64_t inputValue = info[1].As<Napi::Number>().Int32Value();
+
+		seal::Evaluator evaluator(*m_SEALContextPtr);
+		const auto plain_modulus = static_cast<int64_t>(m_EncryptionParameters->plain_modulus().value());
+		const auto absValue = static_cast<uint64_t>(std::abs(inputValue));
+		const auto sign = static_cast<uint64_t>(inputValue < 0 ? plain_modulus - 1 : 1);
+		if (absValue != 0 && (absValue & (absValue - 1)) == 0) //power of two
+		{
+			size_t exponent = 0;
+			while ((uint64_t(1) << exponent) != absValue)
+				exponent++;
+			evaluator.multiply_monomial(ciphertext1, sign, exponent, ciphertextResult);
+		}
+		else if (absValue != 0 && 2 * static_cast<int64_t>(absValue) < plain_modulus)
+		{
+			const auto scalar = inputValue < 0 ? plain_modulus + inputValue : inputValue;
+			evaluator.multiply_scalar(ciphertext1, static_cast<uint64_t>(scalar), ciphertextResult);
+		}
+		else
+		{
+			evaluator.multiply_plain(ciphertext1, m_IntegerEncoder->encode(static_cast<int32_t>(inputValue)), ciphertextResult);
+		}
+
+		return Convert(env, ciphertextResult, seal::compr_mode_type::bit_packed);
 	}
 	SEAL_WRAPPER_CATCH_ALL_THEN_RETURN(env.Undefined());
 }
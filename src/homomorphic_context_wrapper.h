@@ -62,6 +62,8 @@ private:
 	Napi::Value sub(const Napi::CallbackInfo &info);
 	Napi::Value multiply(const Napi::CallbackInfo &info);		//relinearization can apply here
 	Napi::Value square(const Napi::CallbackInfo &info);			//relinearization can apply here
+	Napi::Value addPlain(const Napi::CallbackInfo &info);		//constant operand: Evaluator::add_scalar
+	Napi::Value multiplyPlain(const Napi::CallbackInfo &info);	//constant operand: Evaluator::multiply_monomial / multiply_scalar
 	//Napi::Value exponentiate(const Napi::CallbackInfo &info);	//we need explicit relinearization here!
 
 private:
@@ -1,22 +1,40 @@
 #include "wrapper.h"
 #include "base64.h"
+#include "wrapper_globals.h"
 
 NAMESPACE_SEAL_WRAPPER_BEGIN
 
 /******************************************************************************/
 std::istringstream Convert(Napi::String const &objJS)
 {
-	const auto strBase64 = (std::string)objJS;
-	const auto strPersistent = base64_decode(strBase64);
-	return std::istringstream(strPersistent, std::ios_base::in | std::ios_base::binary);
+	const auto bytes = ConvertToBytes(objJS);
+	return std::istringstream(std::string(bytes.begin(), bytes.end()), std::ios_base::in | std::ios_base::binary);
 }
 
 /******************************************************************************/
 Napi::String Convert(Napi::Env env, std::ostringstream const &oss)
 {
 	const auto strPersistent = oss.str();
-	const auto strBase64 = base64_encode(reinterpret_cast<const unsigned char *>(strPersistent.c_str()), strPersistent.length());
-	return Napi::String::New(env, strBase64);
+	std::vector<char> chars(base64_encoded_length(strPersistent.length()));
+	base64_encode(reinterpret_cast<const unsigned char *>(strPersistent.data()), strPersistent.length(), chars.data());
+	return Napi::String::New(env, chars.data(), chars.size());
+}
+
+/******************************************************************************/
+std::vector<unsigned char> ConvertToBytes(Napi::String const &objJS)
+{
+	const auto strBase64 = (std::string)objJS;
+	std::vector<unsigned char> bytes(base64_decoded_length(strBase64.length()));
+	bytes.resize(base64_decode(strBase64.data(), strBase64.length(), bytes.data())); //shrinking never reallocates
+	return bytes;
+}
+
+/******************************************************************************/
+Napi::String Convert(Napi::Env env, std::vector<unsigned char> const &bytes)
+{
+	std::vector<char> chars(base64_encoded_length(bytes.size()));
+	base64_encode(bytes.data(), bytes.size(), chars.data());
+	return Napi::String::New(env, chars.data(), chars.size());
 }
 
 NAMESPACE_SEAL_WRAPPER_END
\ No newline at end of file
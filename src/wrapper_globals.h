@@ -2,6 +2,9 @@
 #define WRAPPER_GLOBALS_H
 
 #include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
 #include "wrapper.h"
 
 NAMESPACE_SEAL_WRAPPER_BEGIN
@@ -15,6 +18,29 @@ std::istringstream Convert(Napi::String const &objJS);
 //std::ostringstream => N-API String
 Napi::String Convert(Napi::Env env, std::ostringstream const &oss);
 
+//N-API String => raw bytes
+std::vector<unsigned char> ConvertToBytes(Napi::String const &objJS);
+
+//raw bytes => N-API String
+Napi::String Convert(Napi::Env env, std::vector<unsigned char> const &bytes);
+
+//SEAL object => N-API String, saved straight into an exactly sized buffer
+template <class T>
+Napi::String Convert(Napi::Env env, T const &objSEAL, seal::compr_mode_type compr_mode)
+{
+	std::vector<unsigned char> bytes(objSEAL.save_size(compr_mode));
+	objSEAL.save(bytes.data(), bytes.size(), compr_mode);
+	return Convert(env, bytes);
+}
+
+//N-API String => SEAL object, loaded straight from the decoded bytes
+template <class T>
+void Convert(Napi::String const &objJS, std::shared_ptr<seal::SEALContext> context, T &objSEAL)
+{
+	const auto bytes = ConvertToBytes(objJS);
+	objSEAL.load(std::move(context), bytes.data(), bytes.size());
+}
+
 
 NAMESPACE_SEAL_WRAPPER_END
 